@@ -0,0 +1,187 @@
+#include "allocation.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/mman.h>
+
+namespace
+{
+  const std::size_t hugePageSize = 1 << 21;
+
+  HugePages initialHugePages()
+  {
+    const char* value = std::getenv("ROBUST_HUGE_PAGES");
+
+    if(value)
+    {
+      if(!std::strcmp(value, "transparent"))
+      {
+        return HugePages::TRANSPARENT;
+      }
+      else if(!std::strcmp(value, "explicit"))
+      {
+        return HugePages::EXPLICIT;
+      }
+    }
+
+    return HugePages::NONE;
+  }
+
+  std::atomic<HugePages> hugePages(initialHugePages());
+
+  std::size_t mappedSize(std::size_t bytes)
+  {
+    return ((bytes + hugePageSize - 1) / hugePageSize) * hugePageSize;
+  }
+
+  void* mapPages(std::size_t size, HugePages policy)
+  {
+    void* pointer = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    if(policy == HugePages::EXPLICIT)
+    {
+      int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+
+#ifdef MAP_HUGE_2MB
+      flags |= MAP_HUGE_2MB;
+#endif
+
+      pointer = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+
+      if(pointer != MAP_FAILED)
+      {
+        return pointer;
+      }
+    }
+#endif
+
+    pointer = mmap(nullptr,
+                   size,
+                   PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS,
+                   -1,
+                   0);
+
+    if(pointer == MAP_FAILED)
+    {
+      throw std::bad_alloc();
+    }
+
+#ifdef MADV_HUGEPAGE
+    if(policy != HugePages::NONE)
+    {
+      // the advice is ignored if transparent huge pages are disabled
+      madvise(pointer, size, MADV_HUGEPAGE);
+    }
+#endif
+
+    return pointer;
+  }
+}
+
+HugePages getHugePages()
+{
+  return hugePages;
+}
+
+void setHugePages(HugePages value)
+{
+  hugePages = value;
+}
+
+void* allocateLarge(std::size_t bytes)
+{
+  if(bytes < largeAllocationSize)
+  {
+    return ::operator new(bytes);
+  }
+
+  return mapPages(mappedSize(bytes), hugePages);
+}
+
+void deallocateLarge(void* pointer, std::size_t bytes)
+{
+  if(bytes < largeAllocationSize)
+  {
+    ::operator delete(pointer);
+    return;
+  }
+
+  munmap(pointer, mappedSize(bytes));
+}
+
+Arena::Arena(std::size_t blockSize)
+  : current(nullptr),
+    remaining(0),
+    blockSize(blockSize),
+    used(0)
+{
+}
+
+Arena::~Arena()
+{
+  for(const std::pair<char*, std::size_t>& block : blocks)
+  {
+    deallocateLarge(block.first, block.second);
+  }
+}
+
+void Arena::addBlock(std::size_t size)
+{
+  current = static_cast<char*>(allocateLarge(size));
+  remaining = size;
+
+  blocks.push_back(std::make_pair(current, size));
+}
+
+void* Arena::allocate(std::size_t bytes, std::size_t alignment)
+{
+  if(bytes == 0)
+  {
+    bytes = 1;
+  }
+
+  // large requests get a block of their own to avoid wasting
+  // the remainder of the current block
+  if(bytes > blockSize / 4)
+  {
+    char* pointer = static_cast<char*>(allocateLarge(bytes));
+    blocks.push_back(std::make_pair(pointer, bytes));
+    used += bytes;
+    return pointer;
+  }
+
+  std::size_t padding = current ?
+    (alignment - (reinterpret_cast<std::uintptr_t>(current) % alignment)) % alignment :
+    0;
+
+  if(!current or padding + bytes > remaining)
+  {
+    addBlock(blockSize);
+    padding = 0;
+  }
+
+  char* pointer = current + padding;
+
+  current += padding + bytes;
+  remaining -= padding + bytes;
+  used += bytes;
+
+  return pointer;
+}
+
+std::size_t Arena::getReserved() const
+{
+  std::size_t reserved = 0;
+
+  for(const std::pair<char*, std::size_t>& block : blocks)
+  {
+    reserved += block.second;
+  }
+
+  return reserved;
+}
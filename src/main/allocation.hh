@@ -0,0 +1,219 @@
+#ifndef ALLOCATION_HH
+#define ALLOCATION_HH
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "memory_usage.hh"
+
+/** @file **/
+
+/**
+ * The backing of large allocations by huge pages:
+ *
+ * - NONE:        regular pages
+ * - TRANSPARENT: regular pages, which are advised to be
+ *                merged into transparent huge pages
+ * - EXPLICIT:    pages from the reserved huge page pool
+ *                (MAP_HUGETLB), falling back to TRANSPARENT
+ *                if the pool is exhausted or unavailable
+ *
+ * The initial policy is read from the environment variable
+ * ROBUST_HUGE_PAGES ("transparent" or "explicit"), it
+ * defaults to NONE.
+ **/
+enum class HugePages
+{
+  NONE,
+  TRANSPARENT,
+  EXPLICIT
+};
+
+HugePages getHugePages();
+
+/**
+ * Sets the policy for subsequent large allocations.
+ **/
+void setHugePages(HugePages hugePages);
+
+/**
+ * Allocations of at least this size are mapped directly
+ * and are subject to the HugePages policy, smaller
+ * ones are served from the regular heap.
+ **/
+const std::size_t largeAllocationSize = 1 << 21;
+
+/**
+ * Allocates the given number of bytes, aligned
+ * suitably for any fundamental type.
+ *
+ * @throws std::bad_alloc if the allocation fails
+ **/
+void* allocateLarge(std::size_t bytes);
+
+/**
+ * Releases memory obtained from allocateLarge()
+ * with the same number of bytes.
+ **/
+void deallocateLarge(void* pointer, std::size_t bytes);
+
+/**
+ * A stateless allocator for large arrays, such as the values of
+ * VertexMap%s and EdgeMap%s, based on allocateLarge().
+ **/
+template <class T>
+class LargeAllocator
+{
+public:
+  typedef T value_type;
+
+  LargeAllocator() {}
+
+  template <class U>
+  LargeAllocator(const LargeAllocator<U>&) {}
+
+  T* allocate(std::size_t size)
+  {
+    return static_cast<T*>(allocateLarge(size * sizeof(T)));
+  }
+
+  void deallocate(T* pointer, std::size_t size)
+  {
+    deallocateLarge(pointer, size * sizeof(T));
+  }
+
+  template <class U>
+  bool operator==(const LargeAllocator<U>&) const
+  {
+    return true;
+  }
+
+  template <class U>
+  bool operator!=(const LargeAllocator<U>&) const
+  {
+    return false;
+  }
+};
+
+/**
+ * A bump allocator for structures which are built once and
+ * released as a whole, such as the adjacency lists of a Graph.
+ * The memory is taken from blocks obtained via allocateLarge()
+ * and is only returned when the Arena is destroyed. Allocating
+ * is not thread-safe.
+ **/
+class Arena
+{
+private:
+  std::vector<std::pair<char*, std::size_t>> blocks;
+  char* current;
+  std::size_t remaining;
+  std::size_t blockSize;
+  std::size_t used;
+
+  void addBlock(std::size_t size);
+
+public:
+  explicit Arena(std::size_t blockSize = largeAllocationSize);
+
+  Arena(const Arena& other) = delete;
+  Arena& operator=(const Arena& other) = delete;
+
+  ~Arena();
+
+  void* allocate(std::size_t bytes, std::size_t alignment);
+
+  /**
+   * Returns the number of bytes handed out so far.
+   **/
+  std::size_t getUsed() const
+  {
+    return used;
+  }
+
+  /**
+   * Returns the number of bytes of all blocks.
+   **/
+  std::size_t getReserved() const;
+
+  MemoryUsage memoryUsage(const std::string& name = "Arena") const
+  {
+    return MemoryUsage(name, getReserved());
+  }
+};
+
+/**
+ * An allocator drawing from a shared Arena. Memory released by
+ * a container is not reused, which makes the allocator suitable
+ * for containers which are sized once. Copies of containers
+ * share the Arena of the original. An allocator without
+ * an Arena draws from the regular heap.
+ **/
+template <class T>
+class ArenaAllocator
+{
+private:
+  std::shared_ptr<Arena> arena;
+
+  template <class U>
+  friend class ArenaAllocator;
+
+public:
+  typedef T value_type;
+
+  typedef std::true_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  ArenaAllocator() {}
+
+  explicit ArenaAllocator(std::shared_ptr<Arena> arena)
+    : arena(std::move(arena))
+  {}
+
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& other)
+    : arena(other.arena)
+  {}
+
+  T* allocate(std::size_t size)
+  {
+    if(!arena)
+    {
+      return static_cast<T*>(::operator new(size * sizeof(T)));
+    }
+
+    return static_cast<T*>(arena->allocate(size * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* pointer, std::size_t size)
+  {
+    if(!arena)
+    {
+      ::operator delete(pointer);
+    }
+  }
+
+  const std::shared_ptr<Arena>& getArena() const
+  {
+    return arena;
+  }
+
+  template <class U>
+  bool operator==(const ArenaAllocator<U>& other) const
+  {
+    return arena == other.arena;
+  }
+
+  template <class U>
+  bool operator!=(const ArenaAllocator<U>& other) const
+  {
+    return arena != other.arena;
+  }
+};
+
+#endif /* ALLOCATION_HH */
@@ -1,7 +1,5 @@
 #include "arcflag_preprocessor.hh"
 
-#include <unordered_set>
-
 #include <tbb/tbb.h>
 
 #include "log.hh"
@@ -16,26 +14,16 @@ ArcFlagPreprocessor::ArcFlagPreprocessor(const Graph& graph,
     outgoingFlags(graph, partition),
     incomingFlags(graph, partition)
 {
-  int boundarySize = 0;
-
-  for(const Edge& edge : graph.getEdges())
+  for(const Region& region : partition.getRegions())
   {
-    const Region& sourceRegion = partition.getRegion(edge.getSource());
-    const Region& targetRegion = partition.getRegion(edge.getTarget());
-
-    if(sourceRegion == targetRegion)
+    for(const Edge& edge : partition.internalEdges(region))
     {
-      outgoingFlags.setFlag(edge, sourceRegion);
-      incomingFlags.setFlag(edge, targetRegion);
-    }
-    else
-    {
-      ++boundarySize;
-      overlappingEdges.push_back(edge);
+      outgoingFlags.setFlag(edge, region);
+      incomingFlags.setFlag(edge, region);
     }
   }
 
-  Log(info) << "Found " << boundarySize
+  Log(info) << "Found " << partition.boundaryEdges<Direction::OUTGOING>().size()
              << " overlapping edges";
 
   if(parallel)
@@ -62,12 +50,9 @@ void ArcFlagPreprocessor::setFlags(Direction direction)
   ArcFlags& arcFlags = (direction == Direction::OUTGOING) ?
     outgoingFlags : incomingFlags;
 
-  std::unordered_set<Vertex> vertices;
-
-  for(const Edge& edge : overlappingEdges)
-  {
-    vertices.insert(edge.getEndpoint(opposite(direction)));
-  }
+  const ArrayRange<Vertex> vertices = (direction == Direction::OUTGOING) ?
+    partition.boundaryVertices<Direction::OUTGOING>() :
+    partition.boundaryVertices<Direction::INCOMING>();
 
   Log(info) << "Computing flags for " << vertices.size()
              << " vertices";
@@ -112,18 +97,13 @@ void ArcFlagPreprocessor::setFlagsParallel(Direction direction)
   ArcFlags& arcFlags = (direction == Direction::OUTGOING) ?
     outgoingFlags : incomingFlags;
 
-  std::unordered_set<Vertex> vertexSet;
-
-  for(const Edge& edge : overlappingEdges)
-  {
-    vertexSet.insert(edge.getEndpoint(opposite(direction)));
-  }
+  const ArrayRange<Vertex> vertices = (direction == Direction::OUTGOING) ?
+    partition.boundaryVertices<Direction::OUTGOING>() :
+    partition.boundaryVertices<Direction::INCOMING>();
 
-  Log(info) << "Computing flags for " << vertexSet.size()
+  Log(info) << "Computing flags for " << vertices.size()
              << " vertices";
 
-  std::vector<Vertex> vertices(vertexSet.begin(), vertexSet.end());
-
   tbb::spin_mutex mutex;
 
   tbb::parallel_do(vertices.begin(),
@@ -27,7 +27,6 @@ private:
   const EdgeFunc<num>& costs;
   const Partition& partition;
   ArcFlags outgoingFlags, incomingFlags;
-  std::vector<Edge> overlappingEdges;
 
 public:
   ArcFlagPreprocessor(const Graph& graph,
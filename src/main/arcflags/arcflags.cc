@@ -1,39 +1,48 @@
 #include "arcflags.hh"
 
+#include <cassert>
+
+const idx ArcFlags::wordSize;
+
 ArcFlags::ArcFlags(const Graph& graph,
                    const Partition& partition)
   : graph(graph),
     partition(partition),
-    flagMaps(graph, FlagMap(partition.getRegions().size()))
+    numWords((partition.getRegions().size() + wordSize - 1) / wordSize),
+    words(((std::size_t) graph.getEdges().size()) * numWords, 0)
 {
 }
 
-ArcFlags::ArcFlags(ArcFlags&& other)
-  : graph(other.graph),
+ArcFlags::ArcFlags(const Graph& graph,
+                   const ArcFlags& other)
+  : graph(graph),
     partition(other.partition),
-    flagMaps(std::move(other.flagMaps))
+    numWords(other.numWords),
+    words(other.words)
 {
+  assert(graph.getEdges().size() == other.graph.getEdges().size());
 }
 
-void ArcFlags::setFlag(const Edge& edge, const Region& region)
+ArcFlags::ArcFlags(ArcFlags&& other)
+  : graph(other.graph),
+    partition(other.partition),
+    numWords(other.numWords),
+    words(std::move(other.words))
 {
-  FlagMap& map = flagMaps(edge);
-  map[region.getIndex()] = true;
 }
 
-ArcFlags::FlagMap& ArcFlags::getFlags(const Edge& edge)
+void ArcFlags::setFlag(const Edge& edge, const Region& region)
 {
-  return flagMaps(edge);
-}
+  const idx index = region.getIndex();
 
-const ArcFlags::FlagMap& ArcFlags::getFlags(const Edge& edge) const
-{
-  return flagMaps(edge);
+  getWords(edge)[index / wordSize] |= ((Word) 1) << (index % wordSize);
 }
 
 bool ArcFlags::hasFlag(const Edge& edge, const Region& region) const
 {
-  return flagMaps(edge)[region.getIndex()];
+  const idx index = region.getIndex();
+
+  return (getWords(edge)[index / wordSize] >> (index % wordSize)) & 1;
 }
 
 
@@ -1,7 +1,11 @@
 #ifndef ARCFLAGS_HH
 #define ARCFLAGS_HH
 
+#include <cstdint>
 #include <iostream>
+#include <vector>
+
+#include "allocation.hh"
 
 #include "graph/graph.hh"
 #include "graph/edge_map.hh"
@@ -13,11 +17,17 @@
  * to a given Region for each Edge of a given Graph.
  * A flag should be set iff the Edge is on a shortest
  * path into / out of the corresponding Region.
+ * The flags of each Edge are packed into a number of
+ * consecutive Word%s, the flags of all Edge%s are stored
+ * in a single array in the order of the Edge indices.
+ * The bits beyond the number of Region%s are zero.
  **/
 class ArcFlags
 {
 public:
-  typedef std::vector<bool> FlagMap;
+  typedef std::uint64_t Word;
+
+  static const idx wordSize = 64;
 
   /**
    * A filter which accepts an Edge iff the
@@ -41,7 +51,8 @@ public:
 private:
   const Graph& graph;
   const Partition& partition;
-  EdgeMap<FlagMap> flagMaps;
+  idx numWords;
+  std::vector<Word, LargeAllocator<Word>> words;
 public:
   /**
    * Constructs ArcFlags for the given Graph according
@@ -49,6 +60,13 @@ public:
    **/
   ArcFlags(const Graph& graph, const Partition& partition);
 
+  /**
+   * Copies the flags of the given ArcFlags. The given
+   * Graph must consist of the same Edge%s as the Graph
+   * of the given ArcFlags, the Partition is shared.
+   **/
+  ArcFlags(const Graph& graph, const ArcFlags& other);
+
   ArcFlags(const ArcFlags& other) = delete;
   ArcFlags(ArcFlags&& other);
   ArcFlags& operator=(const ArcFlags& other) = delete;
@@ -65,10 +83,27 @@ public:
   bool hasFlag(const Edge& edge, const Region& region) const;
 
   /**
-   * Returns the arc flags associated with the given Edge.
+   * Returns the number of Word%s containing the
+   * flags of each Edge.
+   **/
+  idx getNumWords() const
+  {
+    return numWords;
+  }
+
+  /**
+   * Returns the first of the Word%s containing the
+   * flags of the given Edge.
    **/
-  FlagMap& getFlags(const Edge& edge);
-  const FlagMap& getFlags(const Edge& edge) const;
+  Word* getWords(const Edge& edge)
+  {
+    return words.data() + ((std::size_t) edge.getIndex()) * numWords;
+  }
+
+  const Word* getWords(const Edge& edge) const
+  {
+    return words.data() + ((std::size_t) edge.getIndex()) * numWords;
+  }
 
   /**
    * Returns a FlagFilter for the given Region according
@@ -93,6 +128,14 @@ public:
     return partition;
   }
 
+  /**
+   * Returns the memory used by the flags.
+   **/
+  MemoryUsage memoryUsage(const std::string& name = "ArcFlags") const
+  {
+    return MemoryUsage(name).add("flags", heapUsage(words));
+  }
+
   const Graph& getGraph() const
   {
     return graph;
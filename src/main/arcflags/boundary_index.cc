@@ -0,0 +1,116 @@
+#include "boundary_index.hh"
+
+#include <algorithm>
+
+namespace
+{
+  template <class T>
+  void sortByIndex(typename std::vector<T>::iterator begin,
+                   typename std::vector<T>::iterator end)
+  {
+    std::sort(begin, end,
+              [](const T& first, const T& second) -> bool
+              {
+                return first.getIndex() < second.getIndex();
+              });
+  }
+}
+
+BoundaryIndex::BoundaryIndex(const Graph& graph,
+                             const std::vector<Region>& regions,
+                             const VertexMap<idx>& regionIndices)
+{
+  addBoundaries<Direction::OUTGOING>(graph, regions, regionIndices);
+  addBoundaries<Direction::INCOMING>(graph, regions, regionIndices);
+
+  internalOffsets.reserve(regions.size() + 1);
+  internalOffsets.push_back(0);
+
+  for(const Region& region : regions)
+  {
+    const idx begin = internalEdges.size();
+
+    for(const Vertex& vertex : region.getVertices())
+    {
+      for(const Edge& edge : graph.getOutgoing(vertex))
+      {
+        if(regionIndices(edge.getTarget()) == region.getIndex())
+        {
+          internalEdges.push_back(edge);
+        }
+      }
+    }
+
+    sortByIndex<Edge>(internalEdges.begin() + begin, internalEdges.end());
+
+    internalOffsets.push_back(internalEdges.size());
+  }
+}
+
+template <Direction direction>
+void BoundaryIndex::addBoundaries(const Graph& graph,
+                                  const std::vector<Region>& regions,
+                                  const VertexMap<idx>& regionIndices)
+{
+  Lists& current = lists.get<direction>();
+
+  current.vertexOffsets.reserve(regions.size() + 1);
+  current.vertexOffsets.push_back(0);
+
+  current.edgeOffsets.reserve(regions.size() + 1);
+  current.edgeOffsets.push_back(0);
+
+  for(const Region& region : regions)
+  {
+    const idx vertexBegin = current.vertices.size();
+    const idx edgeBegin = current.edges.size();
+
+    for(const Vertex& vertex : region.getVertices())
+    {
+      bool boundary = false;
+
+      for(const Edge& edge : graph.getEdges(vertex, direction))
+      {
+        if(regionIndices(edge.getEndpoint(direction)) != region.getIndex())
+        {
+          current.edges.push_back(edge);
+          boundary = true;
+        }
+      }
+
+      if(boundary)
+      {
+        current.vertices.push_back(vertex);
+      }
+    }
+
+    sortByIndex<Vertex>(current.vertices.begin() + vertexBegin,
+                        current.vertices.end());
+
+    sortByIndex<Edge>(current.edges.begin() + edgeBegin,
+                      current.edges.end());
+
+    current.vertexOffsets.push_back(current.vertices.size());
+    current.edgeOffsets.push_back(current.edges.size());
+  }
+}
+
+MemoryUsage BoundaryIndex::memoryUsage() const
+{
+  MemoryUsage usage("BoundaryIndex");
+
+  for(const Direction& direction : {Direction::OUTGOING, Direction::INCOMING})
+  {
+    const Lists& current = lists.get(direction);
+
+    usage.add(MemoryUsage((direction == Direction::OUTGOING) ? "outgoing" : "incoming")
+              .add("vertexOffsets", heapUsage(current.vertexOffsets))
+              .add("vertices", heapUsage(current.vertices))
+              .add("edgeOffsets", heapUsage(current.edgeOffsets))
+              .add("edges", heapUsage(current.edges)));
+  }
+
+  return usage
+    .add("internalOffsets", heapUsage(internalOffsets))
+    .add("internalEdges", heapUsage(internalEdges));
+}
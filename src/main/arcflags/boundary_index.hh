@@ -0,0 +1,153 @@
+#ifndef BOUNDARY_INDEX_HH
+#define BOUNDARY_INDEX_HH
+
+#include <vector>
+
+#include "graph/graph.hh"
+#include "graph/vertex_map.hh"
+#include "memory_usage.hh"
+#include "util.hh"
+
+#include "region.hh"
+
+/**
+ * A contiguous range of elements which can be used in
+ * a range-based loop.
+ **/
+template <class T>
+class ArrayRange
+{
+private:
+  const T* first;
+  const T* last;
+
+public:
+  ArrayRange(const T* first, const T* last)
+    : first(first),
+      last(last)
+  {}
+
+  const T* begin() const
+  {
+    return first;
+  }
+
+  const T* end() const
+  {
+    return last;
+  }
+
+  const T& operator[](idx index) const
+  {
+    return first[index];
+  }
+
+  idx size() const
+  {
+    return last - first;
+  }
+
+  bool empty() const
+  {
+    return first == last;
+  }
+};
+
+/**
+ * A flat index of the boundaries of the Region%s of a Partition.
+ * For each Region and Direction, the index stores the boundary
+ * vertices (those having an Edge in the given Direction leaving
+ * the Region) and the corresponding cut Edge%s. Additionally, it
+ * stores the Edge%s inside each Region. All lists are kept in
+ * one array per kind, sorted by Region and by index.
+ **/
+class BoundaryIndex
+{
+private:
+  class Lists
+  {
+  public:
+    std::vector<idx> vertexOffsets;
+    std::vector<Vertex> vertices;
+    std::vector<idx> edgeOffsets;
+    std::vector<Edge> edges;
+  };
+
+  Bidirected<Lists> lists;
+
+  std::vector<idx> internalOffsets;
+  std::vector<Edge> internalEdges;
+
+  template <Direction direction>
+  void addBoundaries(const Graph& graph,
+                     const std::vector<Region>& regions,
+                     const VertexMap<idx>& regionIndices);
+
+public:
+  BoundaryIndex(const Graph& graph,
+                const std::vector<Region>& regions,
+                const VertexMap<idx>& regionIndices);
+
+  /**
+   * Returns the boundary vertices of the Region
+   * with the given index.
+   **/
+  template <Direction direction>
+  ArrayRange<Vertex> getVertices(idx region) const
+  {
+    const Lists& current = lists.get<direction>();
+
+    return ArrayRange<Vertex>(current.vertices.data() + current.vertexOffsets[region],
+                              current.vertices.data() + current.vertexOffsets[region + 1]);
+  }
+
+  /**
+   * Returns the boundary vertices of all Region%s.
+   **/
+  template <Direction direction>
+  ArrayRange<Vertex> getVertices() const
+  {
+    const Lists& current = lists.get<direction>();
+
+    return ArrayRange<Vertex>(current.vertices.data(),
+                              current.vertices.data() + current.vertices.size());
+  }
+
+  /**
+   * Returns the cut Edge%s leaving the Region with the given
+   * index in the given Direction.
+   **/
+  template <Direction direction>
+  ArrayRange<Edge> getEdges(idx region) const
+  {
+    const Lists& current = lists.get<direction>();
+
+    return ArrayRange<Edge>(current.edges.data() + current.edgeOffsets[region],
+                            current.edges.data() + current.edgeOffsets[region + 1]);
+  }
+
+  /**
+   * Returns the cut Edge%s of all Region%s.
+   **/
+  template <Direction direction>
+  ArrayRange<Edge> getEdges() const
+  {
+    const Lists& current = lists.get<direction>();
+
+    return ArrayRange<Edge>(current.edges.data(),
+                            current.edges.data() + current.edges.size());
+  }
+
+  /**
+   * Returns the Edge%s inside the Region with the given index.
+   **/
+  ArrayRange<Edge> getInternalEdges(idx region) const
+  {
+    return ArrayRange<Edge>(internalEdges.data() + internalOffsets[region],
+                            internalEdges.data() + internalOffsets[region + 1]);
+  }
+
+  MemoryUsage memoryUsage() const;
+};
+
+#endif /* BOUNDARY_INDEX_HH */
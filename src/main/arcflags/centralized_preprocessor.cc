@@ -1,6 +1,7 @@
 #include "centralized_preprocessor.hh"
 
-#include <unordered_set>
+#include <algorithm>
+#include <iterator>
 
 #include <boost/heap/d_ary_heap.hpp>
 
@@ -266,25 +267,16 @@ CentralizedPreprocessor::CentralizedPreprocessor(const Graph& graph,
     outgoingFlags(graph, partition),
     incomingFlags(graph, partition)
 {
-  idx boundarySize = 0;
-
-  for(const Edge& edge : graph.getEdges())
+  for(const Region& region : partition.getRegions())
   {
-    const Region& sourceRegion = partition.getRegion(edge.getSource());
-    const Region& targetRegion = partition.getRegion(edge.getTarget());
-
-    if(sourceRegion == targetRegion)
-    {
-      outgoingFlags.setFlag(edge, sourceRegion);
-      incomingFlags.setFlag(edge, targetRegion);
-    }
-    else
+    for(const Edge& edge : partition.internalEdges(region))
     {
-      ++boundarySize;
+      outgoingFlags.setFlag(edge, region);
+      incomingFlags.setFlag(edge, region);
     }
   }
 
-  Log(info) << "Found " << boundarySize
+  Log(info) << "Found " << partition.boundaryEdges<Direction::OUTGOING>().size()
             << " overlapping edges";
 
   Log(info) << "Setting outgoing flags";
@@ -311,21 +303,18 @@ void CentralizedPreprocessor::setFlags(const Region& region)
   ArcFlags& arcFlags = (direction == Direction::OUTGOING) ?
     outgoingFlags : incomingFlags;
 
-  std::unordered_set<Vertex> vertexSet;
+  const ArrayRange<Vertex> exitVertices =
+    partition.boundaryVertices<Direction::OUTGOING>(region);
 
-  for(const Vertex& vertex : region.getVertices())
-  {
-    for(const Edge& edge : graph.getAdjacentEdges(vertex))
-    {
-      const Vertex& other = edge.getOpposite(vertex);
+  const ArrayRange<Vertex> entryVertices =
+    partition.boundaryVertices<Direction::INCOMING>(region);
 
-      if(partition.getRegion(other) != region)
-      {
-        vertexSet.insert(vertex);
-        //arcFlags.setFlag(edge, region);
-      }
-    }
-  }
+  // both ranges are sorted by index
+  std::vector<Vertex> vertices;
+
+  std::set_union(exitVertices.begin(), exitVertices.end(),
+                 entryVertices.begin(), entryVertices.end(),
+                 std::back_inserter(vertices));
 
   for(const Vertex& vertex : region.getVertices())
   {
@@ -335,9 +324,6 @@ void CentralizedPreprocessor::setFlags(const Region& region)
     }
   }
 
-  std::vector<Vertex> vertices(vertexSet.begin(),
-                               vertexSet.end());
-
   auto filter = partition.regionFilter(region);
 
   CentralizedHeap centralizedHeap(graph);
@@ -51,7 +51,7 @@ void GeometricPartion::construct(std::vector<Vertex>::iterator begin,
     std::sort(begin, end,
               [&points](const Vertex& first, const Vertex& second)
               {
-                return points(first).getX() < points(second).getX();
+                return points(first).getY() < points(second).getY();
               }
       );
   }
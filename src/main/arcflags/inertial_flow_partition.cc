@@ -0,0 +1,418 @@
+#include "inertial_flow_partition.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include <tbb/parallel_invoke.h>
+
+#include "log.hh"
+
+namespace
+{
+  const idx None = -1;
+
+  /**
+   * A residual network with unit vertex capacities, in which
+   * each Vertex v is split into an incoming node 2v and an
+   * outgoing node 2v + 1.
+   **/
+  class FlowNetwork
+  {
+  private:
+    class Arc
+    {
+    public:
+      Arc(idx head, num capacity)
+        : head(head),
+          capacity(capacity)
+      {}
+
+      idx head;
+      num capacity;
+    };
+
+    std::vector<Arc> arcs;
+    std::vector<std::vector<idx>> adjacency;
+
+  public:
+    FlowNetwork(idx numNodes)
+      : adjacency(numNodes)
+    {}
+
+    void addArc(idx tail, idx head, num capacity)
+    {
+      adjacency[tail].push_back(arcs.size());
+      arcs.push_back(Arc(head, capacity));
+      adjacency[head].push_back(arcs.size());
+      arcs.push_back(Arc(tail, 0));
+    }
+
+    /**
+     * Finds a shortest augmenting path and augments the
+     * flow by one unit along it.
+     *
+     * @return whether an augmenting path was found
+     **/
+    bool augment(idx source, idx sink)
+    {
+      std::vector<idx> parents(adjacency.size(), None);
+      std::vector<idx> queue{source};
+
+      parents[source] = source;
+
+      for(idx i = 0; i < queue.size() and parents[sink] == None; ++i)
+      {
+        const idx node = queue[i];
+
+        for(const idx& arc : adjacency[node])
+        {
+          const idx head = arcs[arc].head;
+
+          if(arcs[arc].capacity > 0 and parents[head] == None)
+          {
+            parents[head] = arc;
+            queue.push_back(head);
+          }
+        }
+      }
+
+      if(parents[sink] == None)
+      {
+        return false;
+      }
+
+      for(idx node = sink; node != source;)
+      {
+        const idx arc = parents[node];
+
+        if(arcs[arc].capacity != inf)
+        {
+          --arcs[arc].capacity;
+        }
+
+        if(arcs[arc ^ 1].capacity != inf)
+        {
+          ++arcs[arc ^ 1].capacity;
+        }
+
+        node = arcs[arc ^ 1].head;
+      }
+
+      return true;
+    }
+
+    /**
+     * Returns the nodes reachable from the given
+     * node in the residual network.
+     **/
+    std::vector<bool> reachable(idx source) const
+    {
+      std::vector<bool> result(adjacency.size(), false);
+      std::vector<idx> queue{source};
+
+      result[source] = true;
+
+      for(idx i = 0; i < queue.size(); ++i)
+      {
+        for(const idx& arc : adjacency[queue[i]])
+        {
+          const idx head = arcs[arc].head;
+
+          if(arcs[arc].capacity > 0 and !result[head])
+          {
+            result[head] = true;
+            queue.push_back(head);
+          }
+        }
+      }
+
+      return result;
+    }
+  };
+}
+
+/**
+ * A subgraph induced by a subset of the vertices, whose
+ * (undirected) adjacency lists refer to local indices.
+ **/
+class InertialFlowPartition::Subgraph
+{
+public:
+  std::vector<Vertex> vertices;
+  std::vector<idx> offsets;
+  std::vector<idx> neighbors;
+
+  Subgraph()
+    : offsets(1, 0)
+  {}
+
+  idx size() const
+  {
+    return vertices.size();
+  }
+
+  /**
+   * Returns the subgraph induced by the vertices
+   * with the given local indices.
+   **/
+  Subgraph induce(const std::vector<idx>& members) const
+  {
+    Subgraph result;
+    std::vector<idx> local(size(), None);
+
+    for(idx i = 0; i < members.size(); ++i)
+    {
+      local[members[i]] = i;
+    }
+
+    result.vertices.reserve(members.size());
+    result.offsets.reserve(members.size() + 1);
+
+    for(const idx& member : members)
+    {
+      result.vertices.push_back(vertices[member]);
+
+      for(idx j = offsets[member]; j < offsets[member + 1]; ++j)
+      {
+        if(local[neighbors[j]] != None)
+        {
+          result.neighbors.push_back(local[neighbors[j]]);
+        }
+      }
+
+      result.offsets.push_back(result.neighbors.size());
+    }
+
+    return result;
+  }
+};
+
+class InertialFlowPartition::Bisection
+{
+public:
+  Bisection()
+    : cut(inf)
+  {}
+
+  std::vector<idx> first, second;
+  num cut;
+
+  idx balance() const
+  {
+    return std::min(first.size(), second.size());
+  }
+
+  bool operator<(const Bisection& other) const
+  {
+    if(cut != other.cut)
+    {
+      return cut < other.cut;
+    }
+
+    return balance() > other.balance();
+  }
+};
+
+InertialFlowPartition::InertialFlowPartition(const Graph& graph,
+                                             const VertexMap<Point>& points,
+                                             int levels,
+                                             int directions,
+                                             float balance)
+  : Partition(graph),
+    points(points),
+    levels(levels),
+    directions(directions),
+    balance(balance)
+{
+  if(directions <= 0 or balance <= 0 or balance > 0.5)
+  {
+    throw std::invalid_argument("Invalid inertial flow parameters");
+  }
+
+  Subgraph subgraph;
+  VertexMap<idx> indices(graph, None);
+
+  subgraph.vertices = graph.getVertices().collect();
+
+  for(idx i = 0; i < subgraph.size(); ++i)
+  {
+    indices(subgraph.vertices[i]) = i;
+  }
+
+  for(const Vertex& vertex : subgraph.vertices)
+  {
+    const idx begin = subgraph.neighbors.size();
+
+    for(const Edge& edge : graph.getOutgoing(vertex))
+    {
+      subgraph.neighbors.push_back(indices(edge.getTarget()));
+    }
+
+    for(const Edge& edge : graph.getIncoming(vertex))
+    {
+      subgraph.neighbors.push_back(indices(edge.getSource()));
+    }
+
+    auto first = subgraph.neighbors.begin() + begin;
+
+    std::sort(first, subgraph.neighbors.end());
+
+    auto last = std::unique(first, subgraph.neighbors.end());
+    last = std::remove(first, last, indices(vertex));
+
+    subgraph.neighbors.erase(last, subgraph.neighbors.end());
+    subgraph.offsets.push_back(subgraph.neighbors.size());
+  }
+
+  std::vector<std::vector<Vertex>> regions;
+
+  construct(subgraph, regions, 0);
+
+  for(const std::vector<Vertex>& vertices : regions)
+  {
+    addRegion(vertices);
+  }
+
+  assert(isValid());
+
+  Log(info) << "Found a partition into "
+            << regions.size()
+            << " regions with "
+            << boundaryVertices<Direction::OUTGOING>().size()
+            << " boundary vertices";
+}
+
+void InertialFlowPartition::construct(const Subgraph& subgraph,
+                                      std::vector<std::vector<Vertex>>& regions,
+                                      int depth) const
+{
+  if(subgraph.size() == 0)
+  {
+    return;
+  }
+
+  if(depth == levels or subgraph.size() <= 1)
+  {
+    regions.push_back(subgraph.vertices);
+    return;
+  }
+
+  Bisection best;
+
+  for(int i = 0; i < directions; ++i)
+  {
+    Bisection current = bisect(subgraph, M_PI * i / directions);
+
+    if(current < best)
+    {
+      best = std::move(current);
+    }
+  }
+
+  const Subgraph first = subgraph.induce(best.first);
+  const Subgraph second = subgraph.induce(best.second);
+
+  std::vector<std::vector<Vertex>> secondRegions;
+
+  tbb::parallel_invoke([&]() { construct(first, regions, depth + 1); },
+                       [&]() { construct(second, secondRegions, depth + 1); });
+
+  std::move(secondRegions.begin(),
+            secondRegions.end(),
+            std::back_inserter(regions));
+}
+
+InertialFlowPartition::Bisection
+InertialFlowPartition::bisect(const Subgraph& subgraph, float angle) const
+{
+  const idx size = subgraph.size();
+  const float dx = std::cos(angle), dy = std::sin(angle);
+
+  std::vector<float> projections(size);
+
+  for(idx i = 0; i < size; ++i)
+  {
+    const Point& point = points(subgraph.vertices[i]);
+    projections[i] = dx * point.getX() + dy * point.getY();
+  }
+
+  std::vector<idx> order(size);
+  std::iota(order.begin(), order.end(), 0);
+
+  std::sort(order.begin(), order.end(),
+            [&projections](const idx& first, const idx& second)
+            {
+              return std::make_pair(projections[first], first) <
+                std::make_pair(projections[second], second);
+            });
+
+  const idx terminals = std::max((idx) 1, (idx) (balance * size));
+  const idx source = 2*size, sink = 2*size + 1;
+
+  FlowNetwork network(2*size + 2);
+
+  for(idx i = 0; i < size; ++i)
+  {
+    network.addArc(2*i, 2*i + 1, 1);
+
+    for(idx j = subgraph.offsets[i]; j < subgraph.offsets[i + 1]; ++j)
+    {
+      network.addArc(2*i + 1, 2*subgraph.neighbors[j], inf);
+    }
+  }
+
+  for(idx i = 0; i < terminals; ++i)
+  {
+    network.addArc(source, 2*order[i], inf);
+    network.addArc(2*order[size - 1 - i] + 1, sink, inf);
+  }
+
+  Bisection bisection;
+  bisection.cut = 0;
+
+  while(network.augment(source, sink))
+  {
+    ++bisection.cut;
+  }
+
+  const std::vector<bool> reachable = network.reachable(source);
+
+  std::vector<idx> separator;
+
+  for(idx i = 0; i < size; ++i)
+  {
+    if(reachable[2*i + 1])
+    {
+      bisection.first.push_back(i);
+    }
+    else if(reachable[2*i])
+    {
+      separator.push_back(i);
+    }
+    else
+    {
+      bisection.second.push_back(i);
+    }
+  }
+
+  std::vector<idx>& smaller = (bisection.first.size() <= bisection.second.size()) ?
+    bisection.first : bisection.second;
+
+  smaller.insert(smaller.end(), separator.begin(), separator.end());
+
+  if(bisection.first.empty() or bisection.second.empty())
+  {
+    // degenerate cut, fall back to a split of the projections
+    bisection.first.assign(order.begin(), order.begin() + size / 2);
+    bisection.second.assign(order.begin() + size / 2, order.end());
+    bisection.cut = inf;
+  }
+
+  std::sort(bisection.first.begin(), bisection.first.end());
+  std::sort(bisection.second.begin(), bisection.second.end());
+
+  return bisection;
+}
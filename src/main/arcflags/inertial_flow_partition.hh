@@ -0,0 +1,66 @@
+#ifndef INERTIAL_FLOW_PARTITION_HH
+#define INERTIAL_FLOW_PARTITION_HH
+
+#include <vector>
+
+#include "graph/graph.hh"
+#include "graph/vertex_map.hh"
+#include "util.hh"
+
+#include "partition.hh"
+
+/**
+ * A Partition which is computed by recursively bisecting
+ * the vertices using inertial flow: For each of a number
+ * of directions, the vertices are ordered by the projections
+ * of their coordinates onto the direction. The first and last
+ * fractions of the ordered vertices are then separated by a
+ * minimum vertex cut with respect to the (undirected) subgraph
+ * induced by the vertices. The direction yielding the smallest
+ * cut is used, the cut vertices are moved to the smaller side.
+ * Since the cut vertices are the only ones adjacent to the other
+ * side, the resulting Region%s have small boundaries.
+ *
+ * The bisections of different subtrees are computed in parallel.
+ **/
+class InertialFlowPartition : public Partition
+{
+public:
+  /**
+   * Constructs a new InertialFlowPartition into 2^levels Region%s.
+   *
+   * @param directions The number of directions to try for each bisection
+   * @param balance    The fraction of vertices on either side which are
+   *                   used as sources / sinks of the flow computation.
+   *                   Must be in (0, 0.5].
+   **/
+  InertialFlowPartition(const Graph& graph,
+                        const VertexMap<Point>& points,
+                        int levels,
+                        int directions = 4,
+                        float balance = 0.25);
+
+private:
+  class Subgraph;
+  class Bisection;
+
+  /**
+   * Recursively bisects the given subgraph, appending the
+   * resulting Region%s (in order) to the given vector.
+   **/
+  void construct(const Subgraph& subgraph,
+                 std::vector<std::vector<Vertex>>& regions,
+                 int depth) const;
+
+  /**
+   * Bisects the given subgraph along the given direction.
+   **/
+  Bisection bisect(const Subgraph& subgraph, float angle) const;
+
+  const VertexMap<Point>& points;
+  int levels;
+  int directions;
+  float balance;
+};
+
+#endif /* INERTIAL_FLOW_PARTITION_HH */
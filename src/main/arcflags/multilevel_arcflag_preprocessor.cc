@@ -0,0 +1,148 @@
+#include "multilevel_arcflag_preprocessor.hh"
+
+
+#include <tbb/tbb.h>
+
+#include "log.hh"
+#include "router/label.hh"
+#include "router/label_heap.hh"
+
+namespace
+{
+  class Task
+  {
+  public:
+    Task(idx level, const Region* region, Vertex vertex)
+      : level(level),
+        region(region),
+        vertex(vertex)
+    {}
+
+    idx level;
+    const Region* region;
+    Vertex vertex;
+  };
+}
+
+MultiLevelArcFlagPreprocessor::MultiLevelArcFlagPreprocessor(const Graph& graph,
+                                                             const EdgeFunc<num>& costs,
+                                                             const PartitionHierarchy& hierarchy)
+  : graph(graph),
+    costs(costs),
+    hierarchy(hierarchy),
+    outgoingFlags(graph, hierarchy, Direction::OUTGOING),
+    incomingFlags(graph, hierarchy, Direction::INCOMING)
+{
+  setFlags(Direction::OUTGOING);
+  setFlags(Direction::INCOMING);
+
+  Log(info) << "Outgoing flags: " << outgoingFlags
+            << ", incoming flags: " << incomingFlags;
+}
+
+void MultiLevelArcFlagPreprocessor::setFlags(Direction direction)
+{
+  MultiLevelArcFlags& arcFlags = (direction == Direction::OUTGOING) ?
+    outgoingFlags : incomingFlags;
+
+  std::vector<Task> tasks;
+
+  for(idx level = 0; level < hierarchy.getNumLevels(); ++level)
+  {
+    const Partition& partition = hierarchy.getPartition(level);
+
+    for(const Region& region : partition.getRegions())
+    {
+      // the Edge%s inside the Region always receive flags
+      for(const Edge& edge : partition.internalEdges(region))
+      {
+        arcFlags.setFlag(edge, level, region);
+      }
+
+      const ArrayRange<Vertex> vertices = (direction == Direction::OUTGOING) ?
+        partition.boundaryVertices<Direction::OUTGOING>(region) :
+        partition.boundaryVertices<Direction::INCOMING>(region);
+
+      for(const Vertex& vertex : vertices)
+      {
+        tasks.push_back(Task(level, &region, vertex));
+      }
+    }
+  }
+
+  Log(info) << "Computing flags for " << tasks.size()
+            << " boundary vertices on "
+            << hierarchy.getNumLevels() << " levels";
+
+  tbb::spin_mutex mutex;
+
+  tbb::parallel_do(tasks.begin(),
+                   tasks.end(),
+                   [this, &mutex, &arcFlags, direction](const Task& task)
+                   {
+                     const idx level = task.level;
+                     const Region& region = *(task.region);
+                     const Partition& partition = hierarchy.getPartition(level);
+
+                     idx remaining = (level == 0) ?
+                       graph.getVertices().size() :
+                       hierarchy.getPartition(level - 1)
+                       .getRegions()[hierarchy.getParent(level, region)]
+                       .getVertices().size();
+
+                     std::vector<Edge> edges;
+
+                     LabelHeap<Label> heap(graph);
+                     heap.update(Label(task.vertex, Edge(), 0));
+
+                     while(!heap.isEmpty())
+                     {
+                       const Label& current = heap.extractMin();
+                       const Vertex vertex = current.getVertex();
+
+                       if(hierarchy.inParent(vertex, level, region))
+                       {
+                         if(vertex != task.vertex)
+                         {
+                           edges.push_back(current.getEdge());
+                         }
+
+                         // the remaining tree edges do not
+                         // receive any flags
+                         if(--remaining == 0)
+                         {
+                           break;
+                         }
+
+                         if(partition.getRegion(vertex) == region and
+                            vertex != task.vertex)
+                         {
+                           continue;
+                         }
+                       }
+
+                       for(const Edge& edge : graph.getEdges(vertex, direction))
+                       {
+                         heap.update(Label(edge.getEndpoint(direction),
+                                           edge,
+                                           current.getCost() + costs(edge)));
+                       }
+                     }
+
+                     {
+                       tbb::spin_mutex::scoped_lock lock(mutex);
+
+                       for(const Edge& edge : edges)
+                       {
+                         arcFlags.setFlag(edge, level, region);
+                       }
+                     }
+                   });
+}
+
+MultiLevelArcFlagRouter MultiLevelArcFlagPreprocessor::getRouter() const
+{
+  return MultiLevelArcFlagRouter(graph,
+                                 outgoingFlags,
+                                 incomingFlags);
+}
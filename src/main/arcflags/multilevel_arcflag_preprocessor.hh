@@ -0,0 +1,54 @@
+#ifndef MULTILEVEL_ARCFLAG_PREPROCESSOR_HH
+#define MULTILEVEL_ARCFLAG_PREPROCESSOR_HH
+
+#include "graph/graph.hh"
+#include "graph/edge_map.hh"
+
+#include "multilevel_arcflags.hh"
+#include "multilevel_arcflag_router.hh"
+#include "partition_hierarchy.hh"
+
+/**
+ * The MultiLevelArcFlagPreprocessor computes MultiLevelArcFlags
+ * for a given Graph according to given costs and a given
+ * PartitionHierarchy. For each Region of each level, a partial
+ * shortest path tree is computed from each of its boundary vertices.
+ * Only the Edge%s whose anchors lie inside the parent of the Region
+ * receive flags, a search therefore stops as soon as all vertices
+ * of the parent have been settled, which makes the searches on
+ * the finer levels cheap.
+ **/
+class MultiLevelArcFlagPreprocessor
+{
+private:
+  void setFlags(Direction direction);
+
+  const Graph& graph;
+  const EdgeFunc<num>& costs;
+  const PartitionHierarchy& hierarchy;
+  MultiLevelArcFlags outgoingFlags, incomingFlags;
+
+public:
+  MultiLevelArcFlagPreprocessor(const Graph& graph,
+                                const EdgeFunc<num>& costs,
+                                const PartitionHierarchy& hierarchy);
+
+  /**
+   * Returns a Router which utilizes the computed
+   * MultiLevelArcFlags in order to speed up shortest
+   * path computations.
+   **/
+  MultiLevelArcFlagRouter getRouter() const;
+
+  const MultiLevelArcFlags& getOutgoingFlags() const
+  {
+    return outgoingFlags;
+  }
+
+  const MultiLevelArcFlags& getIncomingFlags() const
+  {
+    return incomingFlags;
+  }
+};
+
+#endif /* MULTILEVEL_ARCFLAG_PREPROCESSOR_HH */
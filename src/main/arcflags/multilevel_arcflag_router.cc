@@ -0,0 +1,44 @@
+#include "multilevel_arcflag_router.hh"
+
+MultiLevelArcFlagRouter::MultiLevelArcFlagRouter(const Graph& graph,
+                                                 const MultiLevelArcFlags& outgoingFlags,
+                                                 const MultiLevelArcFlags& incomingFlags)
+  : BidirectionalRouter(graph),
+    outgoingFlags(outgoingFlags),
+    incomingFlags(incomingFlags)
+{
+}
+
+SearchResult MultiLevelArcFlagRouter::shortestPath(Vertex source,
+                                                   Vertex target,
+                                                   const EdgeFunc<num>& costs)
+{
+  MultiLevelArcFlags::Filter forwardFilter(incomingFlags.getFilter(target));
+  MultiLevelArcFlags::Filter backwardFilter(outgoingFlags.getFilter(source));
+
+  return BidirectionalRouter::shortestPath<MultiLevelArcFlags::Filter,
+                                           MultiLevelArcFlags::Filter,
+                                           false>(source,
+                                                  target,
+                                                  costs,
+                                                  forwardFilter,
+                                                  backwardFilter);
+}
+
+SearchResult MultiLevelArcFlagRouter::shortestPath(Vertex source,
+                                                   Vertex target,
+                                                   const EdgeFunc<num>& costs,
+                                                   num bound)
+{
+  MultiLevelArcFlags::Filter forwardFilter(incomingFlags.getFilter(target));
+  MultiLevelArcFlags::Filter backwardFilter(outgoingFlags.getFilter(source));
+
+  return BidirectionalRouter::shortestPath<MultiLevelArcFlags::Filter,
+                                           MultiLevelArcFlags::Filter,
+                                           true>(source,
+                                                 target,
+                                                 costs,
+                                                 forwardFilter,
+                                                 backwardFilter,
+                                                 bound);
+}
@@ -0,0 +1,36 @@
+#ifndef MULTILEVEL_ARCFLAG_ROUTER_HH
+#define MULTILEVEL_ARCFLAG_ROUTER_HH
+
+#include "multilevel_arcflags.hh"
+
+#include "router/router.hh"
+#include "router/bidirectional_router.hh"
+
+/**
+ * A router which computes shortest paths using a
+ * bidirectional search according to MultiLevelArcFlags
+ * determined by a MultiLevelArcFlagPreprocessor.
+ **/
+class MultiLevelArcFlagRouter : public Router,
+                                protected BidirectionalRouter
+{
+protected:
+  const MultiLevelArcFlags& outgoingFlags;
+  const MultiLevelArcFlags& incomingFlags;
+
+public:
+  MultiLevelArcFlagRouter(const Graph& graph,
+                          const MultiLevelArcFlags& outgoingFlags,
+                          const MultiLevelArcFlags& incomingFlags);
+
+  SearchResult shortestPath(Vertex source,
+                            Vertex target,
+                            const EdgeFunc<num>& costs) override;
+
+  SearchResult shortestPath(Vertex source,
+                            Vertex target,
+                            const EdgeFunc<num>& costs,
+                            num bound) override;
+};
+
+#endif /* MULTILEVEL_ARCFLAG_ROUTER_HH */
@@ -0,0 +1,93 @@
+#include "multilevel_arcflags.hh"
+
+#include <algorithm>
+#include <cassert>
+
+MultiLevelArcFlags::Filter::Filter(const MultiLevelArcFlags& arcFlags,
+                                   Vertex vertex)
+  : arcFlags(arcFlags),
+    vertex(vertex)
+{
+  const PartitionHierarchy& hierarchy = arcFlags.hierarchy;
+
+  for(idx level = 0; level < hierarchy.getNumLevels(); ++level)
+  {
+    localIndices.push_back(hierarchy.getLocalIndex(level,
+                                                   hierarchy.getCell(vertex, level)));
+  }
+}
+
+MultiLevelArcFlags::MultiLevelArcFlags(const Graph& graph,
+                                       const PartitionHierarchy& hierarchy,
+                                       Direction direction)
+  : graph(graph),
+    hierarchy(hierarchy),
+    direction(direction)
+{
+  for(idx level = 0; level < hierarchy.getNumLevels(); ++level)
+  {
+    flags.push_back(std::vector<bool>(graph.getEdges().size() *
+                                      hierarchy.getWidth(level)));
+  }
+}
+
+void MultiLevelArcFlags::setFlag(const Edge& edge,
+                                 idx level,
+                                 const Region& region)
+{
+  assert(hierarchy.inParent(edge.getEndpoint(direction), level, region));
+
+  const idx position = edge.getIndex() * hierarchy.getWidth(level) +
+    hierarchy.getLocalIndex(level, region);
+
+  flags[level][position] = true;
+}
+
+idx MultiLevelArcFlags::getBitsPerEdge() const
+{
+  idx bits = 0;
+
+  for(idx level = 0; level < hierarchy.getNumLevels(); ++level)
+  {
+    bits += hierarchy.getWidth(level);
+  }
+
+  return bits;
+}
+
+MemoryUsage MultiLevelArcFlags::memoryUsage() const
+{
+  MemoryUsage usage("MultiLevelArcFlags");
+
+  for(idx level = 0; level < flags.size(); ++level)
+  {
+    usage.add("level " + std::to_string(level), heapUsage(flags[level]));
+  }
+
+  return usage;
+}
+
+std::ostream& operator<<(std::ostream& out, const MultiLevelArcFlags& flags)
+{
+  out << "Multi-level flags with " << flags.getBitsPerEdge()
+      << " bits per edge, utilization per level:";
+
+  for(idx level = 0; level < flags.flags.size(); ++level)
+  {
+    const std::vector<bool>& levelFlags = flags.flags[level];
+
+    idx count = 0;
+
+    for(const bool& flag : levelFlags)
+    {
+      if(flag)
+      {
+        ++count;
+      }
+    }
+
+    out << " " << (count / ((float) std::max((size_t) 1, levelFlags.size())));
+  }
+
+  return out;
+}
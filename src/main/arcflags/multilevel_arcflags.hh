@@ -0,0 +1,125 @@
+#ifndef MULTILEVEL_ARCFLAGS_HH
+#define MULTILEVEL_ARCFLAGS_HH
+
+#include <iostream>
+#include <vector>
+
+#include "graph/graph.hh"
+
+#include "partition_hierarchy.hh"
+
+/**
+ * Arc flags with respect to a PartitionHierarchy. On each level,
+ * an Edge only carries flags for the Region%s sharing the parent
+ * of the Region containing its anchor, i.e., the endpoint from
+ * which the Edge is traversed during a search (its source for
+ * incoming flags, its target for outgoing flags). The number of
+ * bits per Edge is therefore the sum of the widths of the levels
+ * rather than the number of Region%s of the finest level.
+ *
+ * To decide whether an Edge may lead towards a given Vertex, the
+ * flag of the level on which the anchor and the Vertex are first
+ * separated is used, i.e., coarse flags are used for distant
+ * Region%s, fine flags inside the common parent.
+ **/
+class MultiLevelArcFlags
+{
+public:
+  /**
+   * A filter which accepts an Edge iff it may lead
+   * towards (or away from) a given Vertex.
+   **/
+  class Filter
+  {
+  private:
+    const MultiLevelArcFlags& arcFlags;
+    Vertex vertex;
+    std::vector<idx> localIndices;
+
+  public:
+    Filter(const MultiLevelArcFlags& arcFlags, Vertex vertex);
+
+    bool operator()(const Edge& edge) const
+    {
+      const PartitionHierarchy& hierarchy = arcFlags.hierarchy;
+      const idx numLevels = hierarchy.getNumLevels();
+
+      idx level = hierarchy.separatingLevel(edge.getEndpoint(arcFlags.direction),
+                                            vertex);
+
+      if(level == numLevels)
+      {
+        --level;
+      }
+
+      return arcFlags.hasFlag(edge, level, localIndices[level]);
+    }
+  };
+
+private:
+  const Graph& graph;
+  const PartitionHierarchy& hierarchy;
+  const Direction direction;
+
+  // the flags of each level, stored edge-wise
+  std::vector<std::vector<bool>> flags;
+
+public:
+  /**
+   * Constructs empty MultiLevelArcFlags. The given Direction
+   * is the one of the searches computing the flags,
+   * i.e., Direction::INCOMING for flags of paths
+   * leading into Region%s.
+   **/
+  MultiLevelArcFlags(const Graph& graph,
+                     const PartitionHierarchy& hierarchy,
+                     Direction direction);
+
+  MultiLevelArcFlags(const MultiLevelArcFlags& other) = delete;
+  MultiLevelArcFlags(MultiLevelArcFlags&& other) = default;
+  MultiLevelArcFlags& operator=(const MultiLevelArcFlags& other) = delete;
+
+  /**
+   * Sets the flag of the given Edge for the given Region of
+   * the given level. The anchor of the Edge must be contained
+   * in the parent of the Region.
+   **/
+  void setFlag(const Edge& edge, idx level, const Region& region);
+
+  bool hasFlag(const Edge& edge, idx level, idx localIndex) const
+  {
+    return flags[level][edge.getIndex() * hierarchy.getWidth(level) + localIndex];
+  }
+
+  /**
+   * Returns a Filter for the given Vertex.
+   **/
+  Filter getFilter(Vertex vertex) const
+  {
+    return Filter(*this, vertex);
+  }
+
+  const PartitionHierarchy& getHierarchy() const
+  {
+    return hierarchy;
+  }
+
+  Direction getDirection() const
+  {
+    return direction;
+  }
+
+  /**
+   * Returns the number of flags stored per Edge.
+   **/
+  idx getBitsPerEdge() const;
+
+  /**
+   * Returns the memory used by the flags of each level.
+   **/
+  MemoryUsage memoryUsage() const;
+
+  friend std::ostream& operator<<(std::ostream&, const MultiLevelArcFlags&);
+};
+
+#endif /* MULTILEVEL_ARCFLAGS_HH */
@@ -5,7 +5,8 @@
 
 Partition::Partition(const Graph& graph)
   : regionIndices(graph, Empty),
-    graph(graph)
+    graph(graph),
+    indexFlag(new std::once_flag())
 {
 
 }
@@ -13,7 +14,9 @@ Partition::Partition(const Graph& graph)
 Partition::Partition(Partition&& other)
   :regionIndices(std::move(other.regionIndices)),
    graph(other.graph),
-   regions(std::move(other.regions))
+   regions(std::move(other.regions)),
+   indexFlag(std::move(other.indexFlag)),
+   boundaryIndex(std::move(other.boundaryIndex))
 {
 
 }
@@ -45,6 +48,20 @@ bool Partition::isValid() const
   return true;
 }
 
+MemoryUsage Partition::memoryUsage() const
+{
+  MemoryUsage usage = MemoryUsage("Partition")
+    .add(regionIndices.memoryUsage("regionIndices"))
+    .add("regions", heapUsage(regions));
+
+  if(boundaryIndex)
+  {
+    usage.add(boundaryIndex->memoryUsage());
+  }
+
+  return usage;
+}
+
 Region& Partition::addRegion(const std::vector<Vertex>& vertices)
 {
   idx index = regions.size();
@@ -55,9 +72,27 @@ Region& Partition::addRegion(const std::vector<Vertex>& vertices)
     regionIndices(vertex) = index;
   }
 
+  indexFlag.reset(new std::once_flag());
+  boundaryIndex.reset();
+
   return *regions.rbegin();
 }
 
+const BoundaryIndex& Partition::getBoundaryIndex() const
+{
+  std::call_once(*indexFlag,
+                 [this]()
+                 {
+                   assert(isValid());
+
+                   boundaryIndex.reset(new BoundaryIndex(graph,
+                                                         regions,
+                                                         regionIndices));
+                 });
+
+  return *boundaryIndex;
+}
+
 Region& Partition::getRegion(Vertex vertex)
 {
   idx index = regionIndices(vertex);
@@ -85,24 +120,3 @@ const std::vector<Region>& Partition::getRegions() const
 {
   return regions;
 }
-
-std::unordered_set<Edge>
-Partition::internalEdges(const Region& region) const
-{
-  std::unordered_set<Edge> edges;
-
-  for(const Vertex& vertex: region.getVertices())
-  {
-    for(const Edge& edge : graph.getOutgoing(vertex))
-    {
-      if(getRegion(edge.getTarget()) == region)
-      {
-        edges.insert(edge);
-      }
-    }
-  }
-
-  return edges;
-}
-
-
@@ -1,12 +1,14 @@
 #ifndef PARTITION_HH
 #define PARTITION_HH
 
-#include <unordered_set>
+#include <memory>
+#include <mutex>
 
 #include "graph/graph.hh"
 #include "graph/vertex_map.hh"
 #include "util.hh"
 
+#include "boundary_index.hh"
 #include "region.hh"
 
 class Boundary
@@ -34,7 +36,10 @@ public:
 };
 
 /**
- * A partitioning of vertices into Region%s.
+ * A partitioning of vertices into Region%s. The boundaries
+ * of the Region%s are computed once (when first needed) and
+ * stored in a BoundaryIndex, which is discarded whenever
+ * another Region is added.
  **/
 class Partition
 {
@@ -43,6 +48,9 @@ private:
   const Graph& graph;
   std::vector<Region> regions;
 
+  mutable std::unique_ptr<std::once_flag> indexFlag;
+  mutable std::unique_ptr<BoundaryIndex> boundaryIndex;
+
   static const idx Empty = -1;
 
 public:
@@ -136,75 +144,71 @@ public:
     return RegionFilter(*this, region);
   }
 
-  template <Direction direction>
-  std::unordered_set<Vertex> boundaryVertices(const Region& region) const;
-
-  template <Direction direction>
-  std::unordered_set<Edge> boundaryEdges(const Region& region) const;
+  /**
+   * Returns the memory used by the Region%s and the
+   * assignment of the vertices.
+   **/
+  MemoryUsage memoryUsage() const;
 
-  std::unordered_set<Edge> internalEdges(const Region& region) const;
+  /**
+   * Returns the BoundaryIndex of this Partition,
+   * building it if necessary.
+   **/
+  const BoundaryIndex& getBoundaryIndex() const;
 
+  /**
+   * Returns the vertices of the given Region having an Edge in the
+   * given Direction which leaves the Region, sorted by index.
+   **/
   template <Direction direction>
-  Boundary getBoundary(const Region& region) const;
-};
-
-template <Direction direction>
-std::unordered_set<Vertex>
-Partition::boundaryVertices(const Region& region) const
-{
-  std::unordered_set<Vertex> vertices;
-
-  for(const Vertex& vertex: region.getVertices())
+  ArrayRange<Vertex> boundaryVertices(const Region& region) const
   {
-    for(const Edge& edge : graph.getEdges(vertex, direction))
-    {
-      if(getRegion(edge.getEndpoint(direction)) != region)
-      {
-        vertices.insert(vertex);
-      }
-    }
+    return getBoundaryIndex().getVertices<direction>(region.getIndex());
   }
 
-  return vertices;
-}
-
-template <Direction direction>
-std::unordered_set<Edge>
-Partition::boundaryEdges(const Region& region) const
-{
-  std::unordered_set<Edge> edges;
-
-  for(const Vertex& vertex: region.getVertices())
+  /**
+   * Returns the boundary vertices of all Region%s.
+   **/
+  template <Direction direction>
+  ArrayRange<Vertex> boundaryVertices() const
   {
-    for(const Edge& edge : graph.getEdges(vertex, direction))
-    {
-      if(getRegion(edge.getEndpoint(direction)) != region)
-      {
-        edges.insert(edge);
-      }
-    }
+    return getBoundaryIndex().getVertices<direction>();
   }
 
-  return edges;
-}
+  /**
+   * Returns the Edge%s leaving the given Region in the
+   * given Direction, sorted by index.
+   **/
+  template <Direction direction>
+  ArrayRange<Edge> boundaryEdges(const Region& region) const
+  {
+    return getBoundaryIndex().getEdges<direction>(region.getIndex());
+  }
 
-template <Direction direction>
-Boundary Partition::getBoundary(const Region& region) const
-{
-  std::vector<Vertex> vertices;
+  /**
+   * Returns the Edge%s connecting different Region%s.
+   **/
+  template <Direction direction>
+  ArrayRange<Edge> boundaryEdges() const
+  {
+    return getBoundaryIndex().getEdges<direction>();
+  }
 
-  for(const Vertex& vertex: region.getVertices())
+  /**
+   * Returns the Edge%s inside of the given Region, sorted by index.
+   **/
+  ArrayRange<Edge> internalEdges(const Region& region) const
   {
-    for(const Edge& edge : graph.getEdges(vertex, direction))
-    {
-      if(getRegion(edge.getEndpoint(direction)) != region)
-      {
-        vertices.push_back(vertex);
-      }
-    }
+    return getBoundaryIndex().getInternalEdges(region.getIndex());
   }
 
-  return Boundary(region, vertices);
-}
+  template <Direction direction>
+  Boundary getBoundary(const Region& region) const
+  {
+    const ArrayRange<Vertex> vertices = boundaryVertices<direction>(region);
+
+    return Boundary(region, std::vector<Vertex>(vertices.begin(), vertices.end()));
+  }
+};
 
 #endif /* PARTITION_HH */
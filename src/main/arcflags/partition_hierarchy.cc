@@ -0,0 +1,101 @@
+#include "partition_hierarchy.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+PartitionHierarchy::PartitionHierarchy(const Graph& graph)
+  : graph(graph)
+{
+}
+
+MemoryUsage PartitionHierarchy::memoryUsage() const
+{
+  MemoryUsage usage("PartitionHierarchy");
+
+  for(const Partition& partition : partitions)
+  {
+    usage.add(partition.memoryUsage());
+  }
+
+  return usage
+    .add("cells", heapUsage(cells))
+    .add("parents", heapUsage(parents))
+    .add("localIndices", heapUsage(localIndices));
+}
+
+void PartitionHierarchy::addLevel(Partition&& partition)
+{
+  if(!partition.isValid())
+  {
+    throw std::invalid_argument("Invalid partition");
+  }
+
+  const idx level = getNumLevels();
+  const idx numRegions = partition.getRegions().size();
+
+  std::vector<idx> currentParents(numRegions, 0);
+
+  if(level > 0)
+  {
+    for(const Region& region : partition.getRegions())
+    {
+      const std::vector<Vertex>& vertices = region.getVertices();
+
+      if(vertices.empty())
+      {
+        continue;
+      }
+
+      const idx parent = getCell(vertices.front(), level - 1);
+
+      for(const Vertex& vertex : vertices)
+      {
+        if(getCell(vertex, level - 1) != parent)
+        {
+          throw std::invalid_argument("Partition is not nested");
+        }
+      }
+
+      currentParents[region.getIndex()] = parent;
+    }
+  }
+
+  const idx numParents = (level == 0) ? 1 :
+    partitions.back().getRegions().size();
+
+  std::vector<idx> counts(numParents, 0);
+  std::vector<idx> currentIndices(numRegions, 0);
+
+  for(idx i = 0; i < numRegions; ++i)
+  {
+    currentIndices[i] = counts[currentParents[i]]++;
+  }
+
+  idx width = 0;
+
+  for(const idx& count : counts)
+  {
+    width = std::max(width, count);
+  }
+
+  std::vector<idx> nextCells(graph.getVertices().size() * (level + 1));
+
+  for(const Vertex& vertex : graph.getVertices())
+  {
+    for(idx i = 0; i < level; ++i)
+    {
+      nextCells[vertex.getIndex() * (level + 1) + i] = getCell(vertex, i);
+    }
+
+    nextCells[vertex.getIndex() * (level + 1) + level] =
+      partition.getRegion(vertex).getIndex();
+  }
+
+  cells = std::move(nextCells);
+
+  parents.push_back(std::move(currentParents));
+  localIndices.push_back(std::move(currentIndices));
+  widths.push_back(width);
+
+  partitions.push_back(std::move(partition));
+}
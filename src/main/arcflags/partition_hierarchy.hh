@@ -0,0 +1,147 @@
+#ifndef PARTITION_HIERARCHY_HH
+#define PARTITION_HIERARCHY_HH
+
+#include <vector>
+
+#include "graph/graph.hh"
+#include "util.hh"
+
+#include "partition.hh"
+
+/**
+ * A hierarchy of nested Partition%s. Level zero is the
+ * coarsest Partition, each Region of a finer level is contained
+ * in a single Region (its parent) of the next coarser level.
+ * The Region%s of level zero share a common (virtual) root.
+ *
+ * Each Region is assigned a local index among the Region%s
+ * sharing its parent, which is used to address the flags
+ * of MultiLevelArcFlags.
+ **/
+class PartitionHierarchy
+{
+private:
+  const Graph& graph;
+  std::vector<Partition> partitions;
+
+  // the region indices of all vertices, stored vertex-wise
+  std::vector<idx> cells;
+
+  std::vector<std::vector<idx>> parents;
+  std::vector<std::vector<idx>> localIndices;
+  std::vector<idx> widths;
+
+public:
+  /**
+   * Creates an empty PartitionHierarchy.
+   **/
+  PartitionHierarchy(const Graph& graph);
+
+  PartitionHierarchy(const PartitionHierarchy& other) = delete;
+  PartitionHierarchy& operator=(const PartitionHierarchy& other) = delete;
+
+  /**
+   * Adds the given Partition as the new finest level.
+   *
+   * @throws std::invalid_argument if the Partition is not valid
+   *         or if one of its Region%s is not contained in a
+   *         Region of the previous level.
+   **/
+  void addLevel(Partition&& partition);
+
+  const Graph& getGraph() const
+  {
+    return graph;
+  }
+
+  /**
+   * Returns the memory used by the Partition%s of all levels
+   * and the Region indices of the vertices.
+   **/
+  MemoryUsage memoryUsage() const;
+
+  idx getNumLevels() const
+  {
+    return partitions.size();
+  }
+
+  const Partition& getPartition(idx level) const
+  {
+    return partitions[level];
+  }
+
+  /**
+   * Returns the index of the Region containing the
+   * given Vertex on the given level.
+   **/
+  idx getCell(Vertex vertex, idx level) const
+  {
+    return cells[vertex.getIndex() * getNumLevels() + level];
+  }
+
+  /**
+   * Returns the index of the parent of the given Region
+   * of the given level. The parent of a Region of
+   * level zero is the root.
+   **/
+  idx getParent(idx level, const Region& region) const
+  {
+    return parents[level][region.getIndex()];
+  }
+
+  /**
+   * Returns the index of the given Region among the
+   * children of its parent.
+   **/
+  idx getLocalIndex(idx level, const Region& region) const
+  {
+    return localIndices[level][region.getIndex()];
+  }
+
+  idx getLocalIndex(idx level, idx cell) const
+  {
+    return localIndices[level][cell];
+  }
+
+  /**
+   * Returns the maximum number of children of a Region
+   * of the previous level (or of the root).
+   **/
+  idx getWidth(idx level) const
+  {
+    return widths[level];
+  }
+
+  /**
+   * Returns the coarsest level on which the given vertices
+   * are contained in different Region%s, or the number of
+   * levels if they share the same Region on all levels.
+   **/
+  idx separatingLevel(Vertex first, Vertex second) const
+  {
+    const idx numLevels = getNumLevels();
+    const idx* firstCells = cells.data() + first.getIndex() * numLevels;
+    const idx* secondCells = cells.data() + second.getIndex() * numLevels;
+
+    idx level = 0;
+
+    while(level < numLevels and firstCells[level] == secondCells[level])
+    {
+      ++level;
+    }
+
+    return level;
+  }
+
+  /**
+   * Returns whether the given Vertex is contained in the
+   * parent of the given Region of the given level.
+   **/
+  bool inParent(Vertex vertex, idx level, const Region& region) const
+  {
+    return level == 0 or
+      getCell(vertex, level - 1) == getParent(level, region);
+  }
+};
+
+#endif /* PARTITION_HIERARCHY_HH */
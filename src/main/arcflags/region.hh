@@ -2,6 +2,7 @@
 #define REGION_HH
 
 #include "graph/graph.hh"
+#include "memory_usage.hh"
 #include "util.hh"
 
 /**
@@ -44,6 +45,11 @@ public:
   }
 };
 
+inline std::size_t heapUsage(const Region& region)
+{
+  return heapUsage(region.getVertices());
+}
+
 namespace std
 {
   /**
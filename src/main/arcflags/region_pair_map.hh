@@ -3,6 +3,7 @@
 
 #include <unordered_map>
 
+#include "memory_usage.hh"
 #include "util.hh"
 
 #include "region.hh"
@@ -46,6 +47,14 @@ public:
     map[std::make_pair(first.getIndex(), second.getIndex())] = value;
   }
 
+  /**
+   * Returns the memory used by the stored values.
+   **/
+  MemoryUsage memoryUsage(const std::string& name = "RegionPairMap") const
+  {
+    return MemoryUsage(name, heapUsage(map));
+  }
+
 };
 
 
@@ -0,0 +1,129 @@
+#include "contraction_graph.hh"
+
+#include <algorithm>
+#include <cassert>
+
+ContractionGraph::ContractionGraph(const Graph& graph, float slack)
+  : used(0),
+    slots(graph.getVertices().size()),
+    removed(graph.getVertices().size(), false),
+    numEdges(graph.getEdges().size())
+{
+  idx total = 0;
+
+  for(const Direction& direction : {Direction::OUTGOING, Direction::INCOMING})
+  {
+    for(const Vertex& vertex : graph.getVertices())
+    {
+      const idx degree = graph.getEdges(vertex, direction).size();
+      total += degree + ((idx) (slack * degree)) + 1;
+    }
+  }
+
+  storage.resize(total);
+
+  for(const Direction& direction : {Direction::OUTGOING, Direction::INCOMING})
+  {
+    for(const Vertex& vertex : graph.getVertices())
+    {
+      const EdgeList& edges = graph.getEdges(vertex, direction);
+      Slot& slot = getSlot(vertex, direction);
+
+      slot.capacity = edges.size() + ((idx) (slack * edges.size())) + 1;
+      slot.begin = allocate(slot.capacity);
+      slot.size = edges.size();
+
+      std::copy(edges.begin(), edges.end(), storage.begin() + slot.begin);
+    }
+  }
+
+  assert(used == total);
+}
+
+idx ContractionGraph::allocate(idx capacity)
+{
+  if(used + capacity > storage.size())
+  {
+    storage.resize(std::max((idx) (2 * storage.size()), used + capacity));
+  }
+
+  const idx begin = used;
+  used += capacity;
+
+  return begin;
+}
+
+void ContractionGraph::append(Slot& slot, const Edge& edge)
+{
+  if(slot.size == slot.capacity)
+  {
+    const idx capacity = std::max(2 * slot.capacity, (idx) 4);
+    const idx begin = allocate(capacity);
+
+    std::copy(storage.begin() + slot.begin,
+              storage.begin() + slot.begin + slot.size,
+              storage.begin() + begin);
+
+    slot.begin = begin;
+    slot.capacity = capacity;
+  }
+
+  storage[slot.begin + slot.size++] = edge;
+}
+
+void ContractionGraph::erase(Slot& slot, const Edge& edge)
+{
+  auto first = storage.begin() + slot.begin;
+  auto last = first + slot.size;
+
+  auto it = std::find(first, last, edge);
+
+  assert(it != last);
+
+  *it = *(last - 1);
+  --slot.size;
+}
+
+void ContractionGraph::addEdge(const Edge& edge)
+{
+  assert(contains(edge.getSource()));
+  assert(contains(edge.getTarget()));
+
+  append(getSlot(edge.getSource(), Direction::OUTGOING), edge);
+  append(getSlot(edge.getTarget(), Direction::INCOMING), edge);
+
+  ++numEdges;
+}
+
+void ContractionGraph::removeVertex(Vertex vertex)
+{
+  assert(contains(vertex));
+
+  for(const Edge& edge : getOutgoing(vertex))
+  {
+    const Vertex target = edge.getTarget();
+
+    if(target != vertex)
+    {
+      erase(getSlot(target, Direction::INCOMING), edge);
+    }
+
+    --numEdges;
+  }
+
+  for(const Edge& edge : getIncoming(vertex))
+  {
+    const Vertex source = edge.getSource();
+
+    if(source != vertex)
+    {
+      erase(getSlot(source, Direction::OUTGOING), edge);
+      --numEdges;
+    }
+  }
+
+  getSlot(vertex, Direction::OUTGOING).size = 0;
+  getSlot(vertex, Direction::INCOMING).size = 0;
+
+  removed[vertex.getIndex()] = true;
+}
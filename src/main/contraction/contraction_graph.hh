@@ -0,0 +1,153 @@
+#ifndef CONTRACTION_GRAPH_HH
+#define CONTRACTION_GRAPH_HH
+
+#include <vector>
+
+#include "graph/graph.hh"
+
+/**
+ * The remaining core of a Graph during contraction. In contrast
+ * to the overlay Graph, which keeps all Edge%s in order to build
+ * the hierarchy, the Edge%s of contracted vertices are physically
+ * removed from the adjacency of their neighbors, so that
+ * witness searches only scan Edge%s within the core.
+ *
+ * The adjacency lists of all vertices are stored in one
+ * preallocated array. Each list has some spare capacity for
+ * shortcuts. A list which runs out of capacity is moved
+ * to the end of the array with doubled capacity.
+ **/
+class ContractionGraph
+{
+public:
+  /**
+   * A contiguous range of Edge%s which can be used in
+   * a range-based loop.
+   **/
+  class EdgeRange
+  {
+  private:
+    const Edge* first;
+    const Edge* last;
+
+  public:
+    EdgeRange(const Edge* first, const Edge* last)
+      : first(first),
+        last(last)
+    {}
+
+    const Edge* begin() const
+    {
+      return first;
+    }
+
+    const Edge* end() const
+    {
+      return last;
+    }
+
+    idx size() const
+    {
+      return last - first;
+    }
+
+    bool empty() const
+    {
+      return first == last;
+    }
+  };
+
+private:
+  class Slot
+  {
+  public:
+    Slot()
+      : begin(0),
+        size(0),
+        capacity(0)
+    {}
+
+    idx begin;
+    idx size;
+    idx capacity;
+  };
+
+  std::vector<Edge> storage;
+  idx used;
+
+  Bidirected<std::vector<Slot>> slots;
+  std::vector<bool> removed;
+  idx numEdges;
+
+  Slot& getSlot(Vertex vertex, Direction direction)
+  {
+    return slots.get(direction)[vertex.getIndex()];
+  }
+
+  const Slot& getSlot(Vertex vertex, Direction direction) const
+  {
+    return slots.get(direction)[vertex.getIndex()];
+  }
+
+  idx allocate(idx capacity);
+
+  void append(Slot& slot, const Edge& edge);
+
+  void erase(Slot& slot, const Edge& edge);
+
+public:
+  /**
+   * Constructs a new ContractionGraph containing all vertices and
+   * Edge%s of the given Graph.
+   *
+   * @param graph The underlying Graph.
+   * @param slack The spare capacity (relative to the degree) of
+   *              each adjacency list.
+   **/
+  ContractionGraph(const Graph& graph, float slack = 1.f);
+
+  EdgeRange getOutgoing(Vertex vertex) const
+  {
+    return getEdges(vertex, Direction::OUTGOING);
+  }
+
+  EdgeRange getIncoming(Vertex vertex) const
+  {
+    return getEdges(vertex, Direction::INCOMING);
+  }
+
+  EdgeRange getEdges(Vertex vertex, Direction direction) const
+  {
+    const Slot& slot = getSlot(vertex, direction);
+    const Edge* first = storage.data() + slot.begin;
+
+    return EdgeRange(first, first + slot.size);
+  }
+
+  /**
+   * Adds the given Edge (usually a shortcut which
+   * was added to the overlay Graph) to the core.
+   **/
+  void addEdge(const Edge& edge);
+
+  /**
+   * Removes the given Vertex from the core by detaching all
+   * its Edge%s from the adjacency lists of its neighbors.
+   **/
+  void removeVertex(Vertex vertex);
+
+  bool contains(Vertex vertex) const
+  {
+    return !removed[vertex.getIndex()];
+  }
+
+  /**
+   * Returns the number of Edge%s remaining in the core.
+   **/
+  idx getNumEdges() const
+  {
+    return numEdges;
+  }
+};
+
+#endif /* CONTRACTION_GRAPH_HH */
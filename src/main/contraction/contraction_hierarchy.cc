@@ -1,79 +1,97 @@
 #include "contraction_hierarchy.hh"
 
-#include <stack>
+#include <algorithm>
+#include <stdexcept>
 
 #include "router/label.hh"
 #include "router/label_heap.hh"
 
-class ContractionLabel : public AbstractLabel
-{
-private:
-  const ContractionEdge* edge;
-
-public:
-  ContractionLabel()
-    : edge(nullptr)
-  {}
-  ContractionLabel(Vertex vertex,
-                   const ContractionEdge& edge,
-                   num cost)
-    : AbstractLabel(vertex, cost),
-      edge(&edge)
-  {}
-
-  const ContractionEdge& getEdge() const
-  {
-    return *edge;
-  }
-
-};
-
-
 ContractionHierarchy::ContractionHierarchy(const Graph& overlayGraph,
                                            const EdgeFunc<num>& overlayCosts,
                                            const VertexMap<num>& ranks,
-                                           const EdgeFunc<EdgePair>& originalEdges)
+                                           const EdgeFunc<EdgePair>& edgePairs)
   : graph(Graph(overlayGraph.getVertices().size(), {})),
-    permutation(graph, Vertex()),
-    upwardEdges(graph, std::vector<ContractionEdge>()),
-    downwardEdges(graph, std::vector<ContractionEdge>()),
-    originalEdges(overlayGraph, originalEdges)
+    ranks(overlayGraph.getVertices().size()),
+    shortcuts(overlayGraph, edgePairs)
 {
-  for(const Vertex& originalVertex : graph.getVertices())
+  const idx size = overlayGraph.getVertices().size();
+
+  for(const Vertex& vertex : overlayGraph.getVertices())
   {
-    const Vertex& permutedVertex = graph.getVertices()[ranks(originalVertex)];
-    permutation(originalVertex) = permutedVertex;
+    this->ranks[vertex.getIndex()] = ranks(vertex);
   }
 
+  std::vector<QueryGraph::Arc> upwardArcs, downwardArcs;
+
   for(const Edge& edge : overlayGraph.getEdges())
   {
-    const Vertex& source = edge.getSource();
-    const Vertex& target = edge.getTarget();
-
-    bool upwards = ranks(source) < ranks(target);
+    const idx sourceRank = ranks(edge.getSource());
+    const idx targetRank = ranks(edge.getTarget());
 
-    Vertex permutedSource = permutation(source);
-    Vertex permutedTarget = permutation(target);
-
-    if(upwards)
+    if(sourceRank < targetRank)
     {
-      ContractionEdge contractionEdge(permutedTarget,
-                                      edge,
-                                      overlayCosts(edge));
-
-      upwardEdges(permutedSource).push_back(contractionEdge);
+      upwardArcs.push_back(QueryGraph::Arc(sourceRank,
+                                           targetRank,
+                                           edge.getIndex(),
+                                           overlayCosts(edge)));
     }
     else
     {
-      ContractionEdge contractionEdge(permutedSource,
-                                      edge,
-                                      overlayCosts(edge));
-
-      downwardEdges(permutedTarget).push_back(contractionEdge);
+      downwardArcs.push_back(QueryGraph::Arc(targetRank,
+                                             sourceRank,
+                                             edge.getIndex(),
+                                             overlayCosts(edge)));
     }
   }
+
+  upwardGraph = QueryGraph(size, upwardArcs);
+  downwardGraph = QueryGraph(size, downwardArcs);
+}
+
+ContractionHierarchy::ContractionHierarchy(std::vector<idx> ranks,
+                                           QueryGraph upwardGraph,
+                                           QueryGraph downwardGraph,
+                                           ShortcutTable shortcuts)
+  : graph(Graph(ranks.size(), {})),
+    ranks(std::move(ranks)),
+    upwardGraph(std::move(upwardGraph)),
+    downwardGraph(std::move(downwardGraph)),
+    shortcuts(std::move(shortcuts))
+{
+  if(this->upwardGraph.getNumVertices() != this->ranks.size() or
+     this->downwardGraph.getNumVertices() != this->ranks.size())
+  {
+    throw std::runtime_error("Inconsistent contraction hierarchy");
+  }
+
+  const idx size = this->ranks.size();
+
+  if(!std::all_of(this->ranks.begin(),
+                  this->ranks.end(),
+                  [size](idx rank) -> bool
+                  {
+                    return rank < size;
+                  }))
+  {
+    throw std::runtime_error("Invalid rank");
+  }
+
+  if(!(this->upwardGraph.isConsistent(this->shortcuts) and
+       this->downwardGraph.isConsistent(this->shortcuts)))
+  {
+    throw std::runtime_error("Invalid shortcut");
+  }
 }
 
+MemoryUsage ContractionHierarchy::memoryUsage() const
+{
+  return MemoryUsage("ContractionHierarchy")
+    .add(graph.memoryUsage())
+    .add("ranks", heapUsage(ranks))
+    .add(upwardGraph.memoryUsage("upwardGraph"))
+    .add(downwardGraph.memoryUsage("downwardGraph"))
+    .add(shortcuts.memoryUsage());
+}
 
 SearchResult ContractionHierarchy::Router::shortestPath(Vertex source,
                                                         Vertex target,
@@ -95,14 +113,17 @@ SearchResult ContractionHierarchy::Router::findShortestPath(Vertex source,
                                                             Vertex target,
                                                             num bound)
 {
-  Vertex permutedSource = hierarchy.permutation(source);
-  Vertex permutedTarget = hierarchy.permutation(target);
+  const Vertex permutedSource(hierarchy.ranks[source.getIndex()]);
+  const Vertex permutedTarget(hierarchy.ranks[target.getIndex()]);
 
-  LabelHeap<ContractionLabel> forwardHeap(hierarchy.graph);
-  LabelHeap<ContractionLabel> backwardHeap(hierarchy.graph);
+  const QueryGraph& upwardGraph = hierarchy.upwardGraph;
+  const QueryGraph& downwardGraph = hierarchy.downwardGraph;
 
-  forwardHeap.update(ContractionLabel(permutedSource, ContractionEdge(), 0));
-  backwardHeap.update(ContractionLabel(permutedTarget, ContractionEdge(), 0));
+  LabelHeap<QueryLabel> forwardHeap(hierarchy.graph);
+  LabelHeap<QueryLabel> backwardHeap(hierarchy.graph);
+
+  forwardHeap.update(QueryLabel(permutedSource, 0));
+  backwardHeap.update(QueryLabel(permutedTarget, 0));
 
   int settled = 0, labeled = 0;
   bool found = false;
@@ -125,61 +146,56 @@ SearchResult ContractionHierarchy::Router::findShortestPath(Vertex source,
       break;
     }
 
-    if(forwardValue < backwardValue)
-    {
-      ContractionLabel current = forwardHeap.extractMin();
+    const bool forward = forwardValue < backwardValue;
 
-      ++settled;
+    LabelHeap<QueryLabel>& heap = forward ? forwardHeap : backwardHeap;
+    const LabelHeap<QueryLabel>& otherHeap = forward ? backwardHeap : forwardHeap;
+    const QueryGraph& queryGraph = forward ? upwardGraph : downwardGraph;
+    const QueryGraph& reverseGraph = forward ? downwardGraph : upwardGraph;
 
-      for(const ContractionEdge& edge : hierarchy.upwardEdges(current.getVertex()))
-      {
-        Vertex nextVertex = edge.vertex;
-        num nextCost = current.getCost() + edge.cost;
-        ++labeled;
+    const QueryLabel current = heap.extractMin();
+    const idx index = current.getVertex().getIndex();
 
-        forwardHeap.update(ContractionLabel(nextVertex, edge, nextCost));
+    ++settled;
 
-        const ContractionLabel& other = backwardHeap.getLabel(nextVertex);
-
-        if(other.getState() != State::UNKNOWN)
-        {
-          num value = other.getCost() + nextCost;
-
-          if(value < splitValue)
-          {
-            splitValue = value;
-            split = nextVertex;
-            found = true;
-          }
-        }
-      }
-    }
-    else
+    if(stalling and isStalled(heap,
+                              reverseGraph,
+                              current,
+                              [&](idx arc) { return reverseGraph.getWeight(arc); }))
     {
-      ContractionLabel current = backwardHeap.extractMin();
+      continue;
+    }
 
-      ++settled;
+    for(idx arc = queryGraph.getBegin(index); arc < queryGraph.getEnd(index); ++arc)
+    {
+      const Vertex nextVertex(queryGraph.getHead(arc));
+      const num nextCost = current.getCost() + queryGraph.getWeight(arc);
 
-      for(const ContractionEdge& edge : hierarchy.downwardEdges(current.getVertex()))
+      // labels exceeding the bound can neither improve
+      // the split nor lead to a feasible path
+      if(nextCost >= splitValue or (bounded and nextCost > bound))
       {
-        Vertex nextVertex = edge.vertex;
-        num nextCost = current.getCost() + edge.cost;
-        ++labeled;
+        continue;
+      }
 
-        backwardHeap.update(ContractionLabel(nextVertex, edge, nextCost));
+      ++labeled;
 
-        const ContractionLabel& other = forwardHeap.getLabel(nextVertex);
+      heap.update(QueryLabel(nextVertex,
+                             current.getVertex(),
+                             queryGraph.getShortcut(arc),
+                             nextCost));
 
-        if(other.getState() != State::UNKNOWN)
+      const QueryLabel& other = otherHeap.getLabel(nextVertex);
+
+      if(other.getState() != State::UNKNOWN)
+      {
+        num value = other.getCost() + nextCost;
+
+        if(value < splitValue)
         {
-          num value = other.getCost() + nextCost;
-
-          if(value < splitValue)
-          {
-            splitValue = value;
-            split = nextVertex;
-            found = true;
-          }
+          splitValue = value;
+          split = nextVertex;
+          found = true;
         }
       }
     }
@@ -195,68 +211,14 @@ SearchResult ContractionHierarchy::Router::findShortestPath(Vertex source,
       }
     }
 
-    Path path;
-
-    ContractionLabel current = forwardHeap.getLabel(split);
-
-    while(current.getVertex() != permutedSource)
-    {
-      Edge edge = current.getEdge().edge;
-      path.prepend(edge);
-      current = forwardHeap.getLabel(hierarchy.permutation(edge.getSource()));
-    }
-
-    current = backwardHeap.getLabel(split);
-
-    while(current.getVertex() != permutedTarget)
-    {
-      Edge edge = current.getEdge().edge;
-      path.append(edge);
-      current = backwardHeap.getLabel(hierarchy.permutation(edge.getTarget()));
-    }
+    Path path = hierarchy.shortcuts.unpack(collectShortcuts(forwardHeap,
+                                                            backwardHeap,
+                                                            split));
 
     assert(path.connects(source, target));
 
-    if(bounded)
-    {
-      assert(splitValue <= bound);
-    }
-
-    path = hierarchy.unpack(path);
-
     return SearchResult(settled, labeled, true, path, splitValue);
   }
 
   return SearchResult::notFound(settled, labeled);
 }
-
-Path ContractionHierarchy::unpack(const Path& overlayPath) const
-{
-  Path path;
-
-  std::stack<Edge> edges;
-
-  for(const Edge& edge : overlayPath.getEdges())
-  {
-    edges.push(edge);
-  }
-
-  while(!edges.empty())
-  {
-    const Edge& edge = edges.top();
-    edges.pop();
-    const EdgePair& pair = originalEdges(edge);
-
-    if(pair.first == edge)
-    {
-      path.prepend(edge);
-    }
-    else
-    {
-      edges.push(pair.first);
-      edges.push(pair.second);
-    }
-  }
-
-  return path;
-}
@@ -8,31 +8,21 @@
 #include "router/router.hh"
 
 #include "edge_pair.hh"
+#include "query_graph.hh"
 
-class ContractionEdge
-{
-public:
-  ContractionEdge()
-  {}
-  ContractionEdge(Vertex vertex, Edge edge, num cost)
-    : vertex(vertex),
-      edge(edge),
-      cost(cost)
-  {}
-  Vertex vertex;
-  Edge edge;
-  num cost;
-};
-
+/**
+ * A contraction hierarchy. The upward and downward Edge%s are
+ * stored in rank-ordered QueryGraph%s, the information required
+ * to unpack shortcuts is kept in a separate ShortcutTable. The
+ * same layout is used to serialize the hierarchy.
+ **/
 class ContractionHierarchy
 {
 private:
   Graph graph;
-  VertexMap<Vertex> permutation;
-  VertexMap<std::vector<ContractionEdge>> upwardEdges, downwardEdges;
-  EdgeMap<EdgePair> originalEdges;
-
-  Path unpack(const Path& overlayPath) const;
+  std::vector<idx> ranks;
+  QueryGraph upwardGraph, downwardGraph;
+  ShortcutTable shortcuts;
 
 public:
   ContractionHierarchy(const Graph& overlayGraph,
@@ -40,6 +30,49 @@ public:
                        const VertexMap<num>& ranks,
                        const EdgeFunc<EdgePair>& edgePairs);
 
+  /**
+   * Constructs a ContractionHierarchy from its (deserialized)
+   * query layout.
+   *
+   * @throws std::runtime_error if the parts are inconsistent
+   **/
+  ContractionHierarchy(std::vector<idx> ranks,
+                       QueryGraph upwardGraph,
+                       QueryGraph downwardGraph,
+                       ShortcutTable shortcuts);
+
+  /**
+   * Returns the ranks of the vertices of the original Graph.
+   **/
+  const std::vector<idx>& getRanks() const
+  {
+    return ranks;
+  }
+
+  const QueryGraph& getUpwardGraph() const
+  {
+    return upwardGraph;
+  }
+
+  /**
+   * Returns the downward Edge%s, stored at their targets.
+   **/
+  const QueryGraph& getDownwardGraph() const
+  {
+    return downwardGraph;
+  }
+
+  const ShortcutTable& getShortcuts() const
+  {
+    return shortcuts;
+  }
+
+  /**
+   * Returns the memory used by the query layout and the
+   * ShortcutTable of the hierarchy.
+   **/
+  MemoryUsage memoryUsage() const;
+
   class Router : public ::Router
   {
   private:
@@ -49,11 +82,26 @@ public:
                                   num bound = inf);
 
     const ContractionHierarchy& hierarchy;
+    bool stalling;
   public:
     Router(const ContractionHierarchy& hierarchy)
-      : hierarchy(hierarchy)
+      : hierarchy(hierarchy),
+        stalling(true)
     {}
 
+    /**
+     * Enables or disables stall-on-demand, which is
+     * enabled by default.
+     **/
+    void setStalling(bool stalling)
+    {
+      this->stalling = stalling;
+    }
+
+    bool isStalling() const
+    {
+      return stalling;
+    }
 
     SearchResult shortestPath(Vertex source,
                               Vertex target,
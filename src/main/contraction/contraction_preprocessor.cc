@@ -4,6 +4,7 @@
 
 #include "graph/vertex_map.hh"
 
+#include "contraction_graph.hh"
 #include "fast_witness_path_search.hh"
 #include "hop_restricted_witness_path_search.hh"
 #include "simple_witness_path_search.hh"
@@ -32,7 +33,8 @@ ContractionHierarchy ContractionPreprocessor::computeHierarchy()
   EdgeValueMap<num> costValues = overlayCosts.getValues();
 
   //SimpleWitnessPathSearch search(overlayGraph, costValues, contracted);
-  FastWitnessPathSearch search(overlayGraph, costValues, contracted);
+  ContractionGraph core(overlayGraph);
+  FastWitnessPathSearch search(overlayGraph, costValues, contracted, core);
   //HopRestrictedWitnessPathSearch search(*this, 10);
   //EdgeQuotient scoreFunc(*this, search);
 
@@ -109,6 +111,13 @@ ContractionHierarchy ContractionPreprocessor::computeHierarchy()
 
     scoreFunc.vertexContracted(vertex, results);
 
+    for(const ContractionResult& result : results)
+    {
+      core.addEdge(result.getEdge());
+    }
+
+    core.removeVertex(vertex);
+
     assert(contracted(vertex));
 
     for(const Edge& edge : graph.getAdjacentEdges(vertex))
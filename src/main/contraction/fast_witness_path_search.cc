@@ -1,11 +1,44 @@
 #include "fast_witness_path_search.hh"
 
-#include "router/label_heap.hh"
+/**
+ * A predicate for searches within a ContractionGraph, which
+ * only contains Edge%s between uncontracted vertices.
+ **/
+class CoreSearchPredicate
+{
+private:
+  Vertex vertex;
+public:
+  CoreSearchPredicate(Vertex vertex)
+    : vertex(vertex)
+  {}
+
+  bool operator()(const Edge& edge) const
+  {
+    return edge.getSource() != vertex and
+      edge.getTarget() != vertex;
+  }
+};
 
 std::vector<ContractionPair> FastWitnessPathSearch::findPairs(Vertex vertex) const
 {
-  const std::vector<Edge>& incoming = graph.getIncoming(vertex);
-  const std::vector<Edge>& outgoing = graph.getOutgoing(vertex);
+  if(core)
+  {
+    assert(core->contains(vertex));
+
+    return findPairs(vertex, *core, CoreSearchPredicate(vertex));
+  }
+
+  return findPairs(vertex, graph, SearchPredicate(contracted, vertex));
+}
+
+template <class Adjacency, class Predicate>
+std::vector<ContractionPair> FastWitnessPathSearch::findPairs(Vertex vertex,
+                                                              const Adjacency& adjacency,
+                                                              Predicate predicate) const
+{
+  const auto& incoming = adjacency.getIncoming(vertex);
+  const auto& outgoing = adjacency.getOutgoing(vertex);
 
   std::vector<Edge> actualIncoming, actualOutgoing;
 
@@ -44,6 +77,8 @@ std::vector<ContractionPair> FastWitnessPathSearch::findPairs(Vertex vertex) con
       findPairs<Direction::OUTGOING>(vertex,
                                      incomingEdge,
                                      actualOutgoing,
+                                     adjacency,
+                                     predicate,
                                      std::back_inserter(pairs));
     }
   }
@@ -55,6 +90,8 @@ std::vector<ContractionPair> FastWitnessPathSearch::findPairs(Vertex vertex) con
       findPairs<Direction::INCOMING>(vertex,
                                      outgoingEdge,
                                      actualIncoming,
+                                     adjacency,
+                                     predicate,
                                      std::back_inserter(pairs));
     }
   }
@@ -62,20 +99,21 @@ std::vector<ContractionPair> FastWitnessPathSearch::findPairs(Vertex vertex) con
   return pairs;
 }
 
-template<Direction direction, class OutIt>
+template<Direction direction, class Adjacency, class Predicate, class OutIt>
 void FastWitnessPathSearch::findPairs(const Vertex vertex,
                                       const Edge edge,
                                       const std::vector<Edge>& edges,
+                                      const Adjacency& adjacency,
+                                      Predicate predicate,
                                       OutIt it) const
 {
   assert(edge.getEndpoint(direction) == vertex);
 
-  LabelHeap<SimpleLabel> labelHeap(graph);
-  SearchPredicate predicate(contracted, vertex);
+  WitnessSearch& search = searches.local();
 
   Vertex source = edge.getEndpoint(opposite(direction));
 
-  labelHeap.update(SimpleLabel(source, 0));
+  search.start(source);
 
   for(const Edge& other : edges)
   {
@@ -98,59 +136,15 @@ void FastWitnessPathSearch::findPairs(const Vertex vertex,
 
     const Vertex target = defaultPath.getEndpoint(direction);
 
-    bool found = false;
-
-    while(!labelHeap.isEmpty())
-    {
-      const SimpleLabel& targetLabel = labelHeap.getLabel(target);
-
-      if(targetLabel.getState() != State::UNKNOWN)
-      {
-        if(targetLabel.getCost() <= upperBound)
-        {
-          found = true;
-          break;
-        }
-      }
-
-      if(labelHeap.peek().getCost() > upperBound)
-      {
-        *it++ = ContractionPair(defaultPath.getSource(),
-                                defaultPath.getTarget(),
-                                defaultPath);
-
-        found = true;
-        break;
-      }
-
-      const SimpleLabel& currentLabel = labelHeap.extractMin();
-      Vertex currentVertex = currentLabel.getVertex();
-
-      for(const Edge& outEdge : graph.getEdges(currentVertex, direction))
-      {
-        if(!predicate(outEdge))
-        {
-          continue;
-        }
-
-        Vertex nextVertex = outEdge.getEndpoint(direction);
-        num nextCost = currentLabel.getCost() + costs(outEdge);
-
-        labelHeap.update(SimpleLabel(nextVertex, nextCost));
-      }
-    }
-
-    if(!found)
+    if(!search.search<direction>(target,
+                                 upperBound,
+                                 predicate,
+                                 costs,
+                                 adjacency))
     {
-      const SimpleLabel& targetLabel = labelHeap.getLabel(target);
-
-      if(targetLabel.getState() == State::UNKNOWN or
-         targetLabel.getCost() > upperBound)
-      {
-        *it++ = ContractionPair(defaultPath.getSource(),
-                                defaultPath.getTarget(),
-                                defaultPath);
-      }
+      *it++ = ContractionPair(defaultPath.getSource(),
+                              defaultPath.getTarget(),
+                              defaultPath);
     }
   }
 }
@@ -1,32 +1,75 @@
 #ifndef FAST_WITNESS_PATH_SEARCH_HH
 #define FAST_WITNESS_PATH_SEARCH_HH
 
+#include <tbb/enumerable_thread_specific.h>
+
+#include "contraction_graph.hh"
 #include "contraction_preprocessor.hh"
 
 #include "witness_path_search.hh"
+#include "witness_search.hh"
 
 /**
  * The FastWitnessPathSearch computes the ContractionPair%s of
  * a Vertex by computing partial shortest path trees for
  * adjacent vertices. This is usually faster than the
- * SimpleWitnessPathSearch.
+ * SimpleWitnessPathSearch. Each thread uses its own
+ * WitnessSearch workspace. If a ContractionGraph is given,
+ * the searches only scan the remaining core.
  **/
 class FastWitnessPathSearch : public WitnessPathSearch
 {
 private:
-  template <Direction direction, class OutIt>
+  mutable tbb::enumerable_thread_specific<WitnessSearch> searches;
+  const ContractionGraph* core;
+
+  template <class Adjacency, class Predicate>
+  std::vector<ContractionPair> findPairs(Vertex vertex,
+                                         const Adjacency& adjacency,
+                                         Predicate predicate) const;
+
+  template <Direction direction, class Adjacency, class Predicate, class OutIt>
   void findPairs(const Vertex vertex,
                  const Edge edge,
                  const std::vector<Edge>& edges,
+                 const Adjacency& adjacency,
+                 Predicate predicate,
                  OutIt it) const;
 
 public:
+  /**
+   * Constructs a new FastWitnessPathSearch. The limits
+   * are passed on to the underlying WitnessSearch.
+   **/
   FastWitnessPathSearch(const Graph& graph,
                         const EdgeFunc<num>& costs,
-                        const VertexFunc<bool>& contracted)
-    : WitnessPathSearch(graph, costs, contracted)
+                        const VertexFunc<bool>& contracted,
+                        idx settleLimit = 0,
+                        idx hopLimit = 0)
+    : WitnessPathSearch(graph, costs, contracted),
+      searches([&graph, settleLimit, hopLimit]()
+               {
+                 return WitnessSearch(graph, settleLimit, hopLimit);
+               }),
+      core(nullptr)
   {}
 
+  /**
+   * Constructs a new FastWitnessPathSearch operating on the given
+   * ContractionGraph, which must be kept in sync with the
+   * contracted vertices.
+   **/
+  FastWitnessPathSearch(const Graph& graph,
+                        const EdgeFunc<num>& costs,
+                        const VertexFunc<bool>& contracted,
+                        const ContractionGraph& core,
+                        idx settleLimit = 0,
+                        idx hopLimit = 0)
+    : FastWitnessPathSearch(graph, costs, contracted, settleLimit, hopLimit)
+  {
+    this->core = &core;
+  }
+
   std::vector<ContractionPair> findPairs(Vertex vertex) const override;
 };
 
@@ -33,8 +33,8 @@ HopRestrictedWitnessPathSearch::HopRestrictedWitnessPathSearch(
 std::vector<ContractionPair> HopRestrictedWitnessPathSearch::findPairs(
   Vertex vertex) const
 {
-  const std::vector<Edge>& incoming = graph.getIncoming(vertex);
-  const std::vector<Edge>& outgoing = graph.getOutgoing(vertex);
+  const EdgeList& incoming = graph.getIncoming(vertex);
+  const EdgeList& outgoing = graph.getOutgoing(vertex);
 
   std::vector<Edge> actualIncoming, actualOutgoing;
 
@@ -4,6 +4,7 @@
 
 #include "graph/vertex_set.hh"
 
+#include "contraction_graph.hh"
 #include "fast_witness_path_search.hh"
 #include "hop_restricted_witness_path_search.hh"
 #include "simple_witness_path_search.hh"
@@ -61,7 +62,8 @@ ContractionHierarchy ParallelContractionPreprocessor::computeHierarchy()
   EdgeValueMap<num> costValues = overlayCosts.getValues();
 
   //SimpleWitnessPathSearch search(overlayGraph, costValues, contracted);
-  FastWitnessPathSearch search(overlayGraph, costValues, contracted);
+  ContractionGraph core(overlayGraph);
+  FastWitnessPathSearch search(overlayGraph, costValues, contracted, core);
   //HopRestrictedWitnessPathSearch search(*this, 10);
   //EdgeQuotient scoreFunc(*this, search);
 
@@ -153,6 +155,13 @@ ContractionHierarchy ParallelContractionPreprocessor::computeHierarchy()
                                     pair.second);
 
       scoreFunc.vertexContracted(vertex, results);
+
+      for(const ContractionResult& result : results)
+      {
+        core.addEdge(result.getEdge());
+      }
+
+      core.removeVertex(vertex);
     }
 
     tbb::parallel_do(nextVertices.begin(),
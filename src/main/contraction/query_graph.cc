@@ -0,0 +1,156 @@
+#include "query_graph.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <stack>
+#include <stdexcept>
+
+const idx ShortcutTable::ORIGINAL = (idx) -1;
+
+QueryGraph::QueryGraph(idx numVertices, const std::vector<Arc>& arcs)
+  : offsets(numVertices + 1, 0),
+    heads(arcs.size()),
+    weights(arcs.size()),
+    shortcuts(arcs.size())
+{
+  for(const Arc& arc : arcs)
+  {
+    assert(arc.tail < numVertices);
+    ++offsets[arc.tail + 1];
+  }
+
+  for(idx i = 0; i < numVertices; ++i)
+  {
+    offsets[i + 1] += offsets[i];
+  }
+
+  std::vector<idx> positions(offsets.begin(), offsets.end() - 1);
+
+  for(const Arc& arc : arcs)
+  {
+    const idx position = positions[arc.tail]++;
+
+    heads[position] = arc.head;
+    weights[position] = arc.weight;
+    shortcuts[position] = arc.shortcut;
+  }
+}
+
+QueryGraph::QueryGraph(std::vector<idx> offsets,
+                       std::vector<idx> heads,
+                       std::vector<num> weights,
+                       std::vector<idx> shortcuts)
+  : offsets(std::move(offsets)),
+    heads(std::move(heads)),
+    weights(std::move(weights)),
+    shortcuts(std::move(shortcuts))
+{
+  if(this->offsets.empty() or
+     this->offsets.front() != 0 or
+     this->offsets.back() != this->heads.size() or
+     !std::is_sorted(this->offsets.begin(), this->offsets.end()) or
+     this->heads.size() != this->weights.size() or
+     this->heads.size() != this->shortcuts.size())
+  {
+    throw std::runtime_error("Inconsistent query graph");
+  }
+
+  const idx numVertices = getNumVertices();
+
+  for(const idx& head : this->heads)
+  {
+    if(head >= numVertices)
+    {
+      throw std::runtime_error("Invalid query graph arc");
+    }
+  }
+}
+
+bool QueryGraph::isConsistent(const ShortcutTable& shortcutTable) const
+{
+  return std::all_of(shortcuts.begin(),
+                     shortcuts.end(),
+                     [&](idx shortcut) -> bool
+                     {
+                       return shortcut < shortcutTable.size();
+                     });
+}
+
+MemoryUsage QueryGraph::memoryUsage(const std::string& name) const
+{
+  return MemoryUsage(name)
+    .add("offsets", heapUsage(offsets))
+    .add("heads", heapUsage(heads))
+    .add("weights", heapUsage(weights))
+    .add("shortcuts", heapUsage(shortcuts));
+}
+
+ShortcutTable::ShortcutTable(std::vector<Edge> edges,
+                             std::vector<idx> first,
+                             std::vector<idx> second)
+  : edges(std::move(edges)),
+    first(std::move(first)),
+    second(std::move(second))
+{
+  if(this->edges.size() != this->first.size() or
+     this->edges.size() != this->second.size())
+  {
+    throw std::runtime_error("Inconsistent shortcut table");
+  }
+
+  // shortcuts consist of shortcuts added before them, which
+  // ensures that unpacking them terminates
+  for(idx shortcut = 0; shortcut < this->edges.size(); ++shortcut)
+  {
+    const idx firstChild = this->first[shortcut];
+    const idx secondChild = this->second[shortcut];
+
+    if(firstChild == ORIGINAL and secondChild == ORIGINAL)
+    {
+      continue;
+    }
+
+    if(firstChild >= shortcut or secondChild >= shortcut)
+    {
+      throw std::runtime_error("Invalid shortcut");
+    }
+  }
+}
+
+MemoryUsage ShortcutTable::memoryUsage() const
+{
+  return MemoryUsage("ShortcutTable")
+    .add("edges", heapUsage(edges))
+    .add("first", heapUsage(first))
+    .add("second", heapUsage(second));
+}
+
+Path ShortcutTable::unpack(const std::vector<idx>& shortcuts) const
+{
+  Path path;
+
+  std::stack<idx> stack;
+
+  for(const idx& shortcut : shortcuts)
+  {
+    stack.push(shortcut);
+  }
+
+  while(!stack.empty())
+  {
+    const idx current = stack.top();
+    stack.pop();
+
+    if(first[current] == ORIGINAL)
+    {
+      path.prepend(edges[current]);
+    }
+    else
+    {
+      stack.push(first[current]);
+      stack.push(second[current]);
+    }
+  }
+
+  return path;
+}
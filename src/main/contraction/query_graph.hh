@@ -0,0 +1,351 @@
+#ifndef QUERY_GRAPH_HH
+#define QUERY_GRAPH_HH
+
+#include <algorithm>
+#include <vector>
+
+#include "graph/graph.hh"
+#include "path/path.hh"
+
+#include "router/label.hh"
+
+class ShortcutTable;
+
+/**
+ * A frozen, rank-ordered adjacency structure used by the queries
+ * on a (robust) contraction hierarchy. The arcs are stored in
+ * compressed sparse row format, the arcs leaving the Vertex of
+ * rank i being the ones in [getBegin(i), getEnd(i)). The heads,
+ * weights and shortcut ids of the arcs are kept in separate arrays,
+ * such that a query scanning the arcs of a Vertex only touches
+ * a minimal number of cache lines.
+ *
+ * The shortcut id of an arc refers to the ShortcutTable of the
+ * hierarchy, which is only needed to unpack a Path.
+ **/
+class QueryGraph
+{
+public:
+  class Arc
+  {
+  public:
+    Arc(idx tail, idx head, idx shortcut, num weight)
+      : tail(tail),
+        head(head),
+        shortcut(shortcut),
+        weight(weight)
+    {}
+
+    idx tail, head, shortcut;
+    num weight;
+  };
+
+private:
+  std::vector<idx> offsets;
+  std::vector<idx> heads;
+  std::vector<num> weights;
+  std::vector<idx> shortcuts;
+
+public:
+  QueryGraph()
+    : offsets(1, 0)
+  {}
+
+  /**
+   * Constructs a new QueryGraph with the given number of
+   * vertices from the given (unordered) arcs.
+   **/
+  QueryGraph(idx numVertices, const std::vector<Arc>& arcs);
+
+  /**
+   * Constructs a new QueryGraph from its underlying arrays.
+   *
+   * @throws std::runtime_error if the arrays do not form
+   *         a valid QueryGraph
+   **/
+  QueryGraph(std::vector<idx> offsets,
+             std::vector<idx> heads,
+             std::vector<num> weights,
+             std::vector<idx> shortcuts);
+
+  idx getBegin(idx vertex) const
+  {
+    return offsets[vertex];
+  }
+
+  idx getEnd(idx vertex) const
+  {
+    return offsets[vertex + 1];
+  }
+
+  idx getHead(idx arc) const
+  {
+    return heads[arc];
+  }
+
+  num getWeight(idx arc) const
+  {
+    return weights[arc];
+  }
+
+  idx getShortcut(idx arc) const
+  {
+    return shortcuts[arc];
+  }
+
+  idx getNumVertices() const
+  {
+    return offsets.size() - 1;
+  }
+
+  idx getNumArcs() const
+  {
+    return heads.size();
+  }
+
+  const std::vector<idx>& getOffsets() const
+  {
+    return offsets;
+  }
+
+  const std::vector<idx>& getHeads() const
+  {
+    return heads;
+  }
+
+  const std::vector<num>& getWeights() const
+  {
+    return weights;
+  }
+
+  const std::vector<idx>& getShortcuts() const
+  {
+    return shortcuts;
+  }
+
+  /**
+   * Returns whether all shortcut ids of the arcs refer
+   * to shortcuts contained in the given ShortcutTable.
+   **/
+  bool isConsistent(const ShortcutTable& shortcutTable) const;
+
+  /**
+   * Returns the memory used by the arrays of the QueryGraph.
+   **/
+  MemoryUsage memoryUsage(const std::string& name = "QueryGraph") const;
+};
+
+/**
+ * The cold part of a contraction hierarchy: The Edge%s of the
+ * overlay Graph together with the information needed to unpack
+ * shortcuts into paths in the original Graph. Shortcuts are
+ * identified by the indices of their Edge%s in the overlay Graph.
+ **/
+class ShortcutTable
+{
+private:
+  std::vector<Edge> edges;
+  std::vector<idx> first, second;
+
+public:
+  static const idx ORIGINAL;
+
+  ShortcutTable()
+  {}
+
+  /**
+   * Constructs a new ShortcutTable from the given overlay Graph
+   * and the pairs of Edge%s which were replaced by the overlay
+   * Edge%s. Original Edge%s are mapped onto themselves.
+   **/
+  template <class Pairs>
+  ShortcutTable(const Graph& overlayGraph, const Pairs& edgePairs);
+
+  /**
+   * Constructs a new ShortcutTable from its underlying arrays.
+   * Each shortcut must consist of shortcuts with smaller ids.
+   *
+   * @throws std::runtime_error if the arrays do not form
+   *         a valid ShortcutTable
+   **/
+  ShortcutTable(std::vector<Edge> edges,
+                std::vector<idx> first,
+                std::vector<idx> second);
+
+  const Edge& getEdge(idx shortcut) const
+  {
+    return edges[shortcut];
+  }
+
+  /**
+   * Returns the first child of the given shortcut, or ORIGINAL
+   * if the shortcut corresponds to an original Edge.
+   **/
+  idx getFirst(idx shortcut) const
+  {
+    return first[shortcut];
+  }
+
+  idx getSecond(idx shortcut) const
+  {
+    return second[shortcut];
+  }
+
+  idx size() const
+  {
+    return edges.size();
+  }
+
+  /**
+   * Unpacks the given sequence of shortcuts into a Path
+   * consisting of original Edge%s.
+   **/
+  Path unpack(const std::vector<idx>& shortcuts) const;
+
+  MemoryUsage memoryUsage() const;
+};
+
+template <class Pairs>
+ShortcutTable::ShortcutTable(const Graph& overlayGraph, const Pairs& edgePairs)
+  : edges(overlayGraph.getEdges().size()),
+    first(overlayGraph.getEdges().size(), ORIGINAL),
+    second(overlayGraph.getEdges().size(), ORIGINAL)
+{
+  for(const Edge& edge : overlayGraph.getEdges())
+  {
+    const idx index = edge.getIndex();
+    const auto& pair = edgePairs(edge);
+
+    edges[index] = edge;
+
+    if(!(pair.first == edge))
+    {
+      first[index] = pair.first.getIndex();
+      second[index] = pair.second.getIndex();
+    }
+  }
+}
+
+/**
+ * A label used by the queries on a QueryGraph. It stores the
+ * parent Vertex (with respect to the direction of the search)
+ * and the id of the shortcut leading to the labeled Vertex.
+ **/
+class QueryLabel : public AbstractLabel
+{
+private:
+  Vertex parent;
+  idx shortcut;
+
+public:
+  QueryLabel()
+    : shortcut(ShortcutTable::ORIGINAL)
+  {}
+  QueryLabel(Vertex vertex, num cost)
+    : AbstractLabel(vertex, cost),
+      parent(vertex),
+      shortcut(ShortcutTable::ORIGINAL)
+  {}
+  QueryLabel(Vertex vertex,
+             Vertex parent,
+             idx shortcut,
+             num cost)
+    : AbstractLabel(vertex, cost),
+      parent(parent),
+      shortcut(shortcut)
+  {}
+
+  Vertex getParent() const
+  {
+    return parent;
+  }
+
+  idx getShortcut() const
+  {
+    return shortcut;
+  }
+};
+
+/**
+ * Returns whether the Vertex of the given label, which has just
+ * been settled, can be stalled: If a higher-ranked Vertex has
+ * already been labeled and reaches the Vertex at a smaller cost
+ * via an arc leading downward, the label is not a shortest path
+ * distance and its arcs need not be relaxed. The arcs leading
+ * downward into the Vertex (with respect to the direction of
+ * the search) are given by the QueryGraph of the opposite
+ * direction. Their weights are obtained from the given
+ * function, which returns inf for unusable arcs.
+ **/
+template <class Heap, class Weight>
+bool isStalled(const Heap& heap,
+               const QueryGraph& reverseGraph,
+               const QueryLabel& label,
+               Weight weight)
+{
+  const idx index = label.getVertex().getIndex();
+
+  for(idx arc = reverseGraph.getBegin(index); arc < reverseGraph.getEnd(index); ++arc)
+  {
+    const QueryLabel& other = heap.getLabel(Vertex(reverseGraph.getHead(arc)));
+
+    if(other.getState() == State::UNKNOWN)
+    {
+      continue;
+    }
+
+    const num cost = weight(arc);
+
+    if(cost != inf and other.getCost() + cost < label.getCost())
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Collects the shortcuts on the path from the root of the
+ * forward search via the given split Vertex to the root
+ * of the backward search.
+ **/
+template <class Heap>
+std::vector<idx> collectShortcuts(const Heap& forwardHeap,
+                                  const Heap& backwardHeap,
+                                  Vertex split)
+{
+  std::vector<idx> result;
+
+  for(Vertex current = split;;)
+  {
+    const QueryLabel& label = forwardHeap.getLabel(current);
+
+    if(label.getParent() == current)
+    {
+      break;
+    }
+
+    result.push_back(label.getShortcut());
+    current = label.getParent();
+  }
+
+  std::reverse(result.begin(), result.end());
+
+  for(Vertex current = split;;)
+  {
+    const QueryLabel& label = backwardHeap.getLabel(current);
+
+    if(label.getParent() == current)
+    {
+      break;
+    }
+
+    result.push_back(label.getShortcut());
+    current = label.getParent();
+  }
+
+  return result;
+}
+
+#endif /* QUERY_GRAPH_HH */
@@ -0,0 +1,269 @@
+#ifndef WITNESS_SEARCH_HH
+#define WITNESS_SEARCH_HH
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "graph/graph.hh"
+#include "path/path.hh"
+
+#include "router/label.hh"
+
+/**
+ * A localized Dijkstra search used to find witness paths
+ * during the contraction. In contrast to a LabelHeap the
+ * WitnessSearch keeps its workspace between searches and
+ * only resets the labels of the vertices touched by the
+ * previous search, which is much cheaper than a
+ * reinitialization for the small searches
+ * typically performed during contraction.
+ *
+ * A search is started from a single source and can then be
+ * continued towards several targets one after another, reusing
+ * all vertices settled so far. The search can optionally be
+ * limited to a number of settled vertices and to a number of
+ * hops. If a limit is reached no witness is reported, which
+ * is conservative, since it only causes superfluous shortcuts.
+ *
+ * A WitnessSearch must not be shared between threads.
+ **/
+class WitnessSearch
+{
+private:
+  class Entry
+  {
+  public:
+    Entry()
+      : cost(inf),
+        hops(0),
+        state(State::UNKNOWN)
+    {}
+
+    num cost;
+    idx hops;
+    State state;
+    Edge edge;
+  };
+
+  typedef std::pair<num, idx> HeapEntry;
+
+  const Graph& graph;
+  std::vector<Entry> entries;
+  std::vector<idx> touched;
+  std::priority_queue<HeapEntry,
+                      std::vector<HeapEntry>,
+                      std::greater<HeapEntry>> heap;
+
+  Vertex source;
+  idx settled;
+  idx settleLimit;
+  idx hopLimit;
+
+  void update(Vertex vertex, num cost, const Edge& edge, idx hops)
+  {
+    Entry& entry = entries[vertex.getIndex()];
+
+    if(entry.state == State::SETTLED or entry.cost <= cost)
+    {
+      return;
+    }
+
+    if(entry.state == State::UNKNOWN)
+    {
+      touched.push_back(vertex.getIndex());
+      entry.state = State::LABELED;
+    }
+
+    entry.cost = cost;
+    entry.edge = edge;
+    entry.hops = hops;
+
+    heap.push(HeapEntry(cost, vertex.getIndex()));
+  }
+
+  /**
+   * Removes outdated entries from the top of the heap.
+   **/
+  void prune()
+  {
+    while(!heap.empty())
+    {
+      const HeapEntry& top = heap.top();
+      const Entry& entry = entries[top.second];
+
+      if(entry.state == State::LABELED and entry.cost == top.first)
+      {
+        return;
+      }
+
+      heap.pop();
+    }
+  }
+
+public:
+  /**
+   * Constructs a new WitnessSearch.
+   *
+   * @param graph       The underlying Graph.
+   * @param settleLimit The maximum number of vertices settled
+   *                    per source, zero meaning no limit.
+   * @param hopLimit    The maximum number of edges of witness
+   *                    paths, zero meaning no limit.
+   **/
+  WitnessSearch(const Graph& graph,
+                idx settleLimit = 0,
+                idx hopLimit = 0)
+    : graph(graph),
+      entries(graph.getVertices().size()),
+      settled(0),
+      settleLimit(settleLimit),
+      hopLimit(hopLimit)
+  {}
+
+  /**
+   * Starts a new search from the given source, resetting
+   * the labels of the vertices touched by the previous search.
+   **/
+  void start(Vertex source)
+  {
+    for(const idx& index : touched)
+    {
+      entries[index] = Entry();
+    }
+
+    touched.clear();
+    heap = decltype(heap)();
+
+    this->source = source;
+    settled = 0;
+
+    update(source, 0, Edge(), 0);
+  }
+
+  /**
+   * Continues the current search until the given target has been
+   * reached with a cost of at most the given upper bound.
+   *
+   * @tparam direction The direction of the search
+   * @tparam Predicate A filter for the Edge%s to be used
+   *
+   * @return Whether a witness path has been found
+   **/
+  template <Direction direction, class Predicate>
+  bool search(Vertex target,
+              num upperBound,
+              Predicate predicate,
+              const EdgeFunc<num>& costs)
+  {
+    return search<direction>(target, upperBound, predicate, costs, graph);
+  }
+
+  /**
+   * Continues the current search, scanning the adjacency
+   * lists of the given Adjacency (e.g. a ContractionGraph)
+   * instead of the ones of the underlying Graph.
+   **/
+  template <Direction direction, class Predicate, class Adjacency>
+  bool search(Vertex target,
+              num upperBound,
+              Predicate predicate,
+              const EdgeFunc<num>& costs,
+              const Adjacency& adjacency);
+
+  /**
+   * Returns the (tentative) cost of the given Vertex.
+   **/
+  num getCost(Vertex vertex) const
+  {
+    return entries[vertex.getIndex()].cost;
+  }
+
+  /**
+   * Returns the Path to the given (labeled) Vertex, respecting
+   * the direction of the search.
+   **/
+  template <Direction direction>
+  Path getPath(Vertex target) const;
+
+  idx getSettled() const
+  {
+    return settled;
+  }
+};
+
+template <Direction direction, class Predicate, class Adjacency>
+bool WitnessSearch::search(Vertex target,
+                           num upperBound,
+                           Predicate predicate,
+                           const EdgeFunc<num>& costs,
+                           const Adjacency& adjacency)
+{
+  while(true)
+  {
+    const Entry& targetEntry = entries[target.getIndex()];
+
+    if(targetEntry.state != State::UNKNOWN and
+       targetEntry.cost <= upperBound)
+    {
+      return true;
+    }
+
+    prune();
+
+    if(heap.empty() or heap.top().first > upperBound)
+    {
+      return false;
+    }
+
+    if(settleLimit and settled >= settleLimit)
+    {
+      return false;
+    }
+
+    const Vertex current(heap.top().second);
+    heap.pop();
+
+    Entry& entry = entries[current.getIndex()];
+    entry.state = State::SETTLED;
+    ++settled;
+
+    if(hopLimit and entry.hops >= hopLimit)
+    {
+      continue;
+    }
+
+    const num cost = entry.cost;
+    const idx hops = entry.hops + 1;
+
+    for(const Edge& edge : adjacency.getEdges(current, direction))
+    {
+      if(!predicate(edge))
+      {
+        continue;
+      }
+
+      update(edge.getEndpoint(direction), cost + costs(edge), edge, hops);
+    }
+  }
+}
+
+template <Direction direction>
+Path WitnessSearch::getPath(Vertex target) const
+{
+  assert(entries[target.getIndex()].state != State::UNKNOWN);
+
+  Path path;
+  Vertex current = target;
+
+  while(current != source)
+  {
+    const Edge& edge = entries[current.getIndex()].edge;
+    path.add(edge, opposite(direction));
+    current = edge.getEndpoint(opposite(direction));
+  }
+
+  return path;
+}
+
+#endif /* WITNESS_SEARCH_HH */
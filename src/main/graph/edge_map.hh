@@ -69,7 +69,7 @@ template <class T>
 class EdgeMap : public EdgeFunc<const T&>
 {
 private:
-  std::vector<T> values;
+  std::vector<T, LargeAllocator<T>> values;
 
 public:
   EdgeMap(const Graph& graph, T value)
@@ -118,6 +118,14 @@ public:
     return EdgeValueMap<T>(*this);
   }
 
+  /**
+   * Returns the memory used by the stored values.
+   **/
+  MemoryUsage memoryUsage(const std::string& name = "EdgeMap") const
+  {
+    return MemoryUsage(name, heapUsage(values));
+  }
+
   void extend(const Edge& edge, T value)
   {
     while(values.size() <= edge.getIndex())
@@ -5,23 +5,41 @@
 #include "vertex_set.hh"
 
 Graph::Graph(idx size, const std::vector<Edge>& edges)
-  :size(size), edges(edges)
+  :size(size), edges(edges), arena(std::make_shared<Arena>())
 {
-  idx i = 0;
+  std::vector<idx> outDegrees(size, 0), inDegrees(size, 0);
+
+  for(const Edge& edge : edges)
+  {
+    assert(edge.getSource().getIndex() < size);
+    assert(edge.getTarget().getIndex() < size);
+    ++outDegrees[edge.getSource().getIndex()];
+    ++inDegrees[edge.getTarget().getIndex()];
+  }
 
+  const ArenaAllocator<Edge> allocator(arena);
+
+  outgoing.reserve(size);
+  incoming.reserve(size);
+
+  // reserve all outgoing lists first to make them contiguous
   for(idx i = 0; i < size; ++i)
   {
-    outgoing.push_back(std::vector<Edge>());
-    incoming.push_back(std::vector<Edge>());
+    outgoing.push_back(EdgeList(allocator));
+    outgoing.back().reserve(outDegrees[i]);
   }
 
-  i = 0;
+  for(idx i = 0; i < size; ++i)
+  {
+    incoming.push_back(EdgeList(allocator));
+    incoming.back().reserve(inDegrees[i]);
+  }
+
+  idx i = 0;
 
   for(const Edge& edge : edges)
   {
     assert(edge.getIndex() == i);
-    assert(edge.getSource().getIndex() < size);
-    assert(edge.getTarget().getIndex() < size);
     i++;
     outgoing[edge.getSource().getIndex()].push_back(edge);
     incoming[edge.getTarget().getIndex()].push_back(edge);
@@ -30,6 +48,32 @@ Graph::Graph(idx size, const std::vector<Edge>& edges)
   assert(check());
 }
 
+Graph::Graph(const Graph& other)
+  : Graph(other.size, other.edges)
+{
+}
+
+Graph& Graph::operator=(const Graph& other)
+{
+  if(this != &other)
+  {
+    *this = Graph(other);
+  }
+
+  return *this;
+}
+
+MemoryUsage Graph::memoryUsage() const
+{
+  // the adjacency lists are allocated from the Arena,
+  // which holds all of its blocks regardless of their use
+  return MemoryUsage("Graph")
+    .add("edges", heapUsage(edges))
+    .add("outgoing", outgoing.capacity() * sizeof(EdgeList))
+    .add("incoming", incoming.capacity() * sizeof(EdgeList))
+    .add(arena->memoryUsage("lists"));
+}
+
 const std::vector<Edge>& Graph::getEdges() const
 {
   return edges;
@@ -40,18 +84,18 @@ Vertices Graph::getVertices() const
   return Vertices(size);
 }
 
-const std::vector<Edge>& Graph::getOutgoing(Vertex vertex) const
+const EdgeList& Graph::getOutgoing(Vertex vertex) const
 {
   return outgoing[vertex.getIndex()];
 }
 
-const std::vector<Edge>& Graph::getIncoming(Vertex vertex) const
+const EdgeList& Graph::getIncoming(Vertex vertex) const
 {
   return incoming[vertex.getIndex()];
 }
 
-const std::vector<Edge>& Graph::getEdges(Vertex vertex,
-                                         Direction direction) const
+const EdgeList& Graph::getEdges(Vertex vertex,
+                                Direction direction) const
 {
   return (direction == Direction::OUTGOING) ?
     getOutgoing(vertex) :
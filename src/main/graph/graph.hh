@@ -2,12 +2,21 @@
 #define GRAPH_HH
 
 #include <cassert>
+#include <memory>
 #include <vector>
 #include <queue>
 
+#include "allocation.hh"
+#include "memory_usage.hh"
+
 #include "edge.hh"
 #include "vertex.hh"
 
+/**
+ * The outgoing / incoming Edge%s of a Vertex.
+ **/
+typedef std::vector<Edge, ArenaAllocator<Edge>> EdgeList;
+
 /**
  * A class designed to iterate over the adjacent edges of a Vertex.
  *
@@ -20,11 +29,11 @@
 class AdjacentEdges
 {
 private:
-  const std::vector<Edge>& outgoing;
-  const std::vector<Edge>& incoming;
+  const EdgeList& outgoing;
+  const EdgeList& incoming;
 public:
-  AdjacentEdges(const std::vector<Edge>& outgoing,
-                const std::vector<Edge>& incoming)
+  AdjacentEdges(const EdgeList& outgoing,
+                const EdgeList& incoming)
     : outgoing(outgoing),
       incoming(incoming)
   {}
@@ -32,22 +41,28 @@ public:
   class Iterator
   {
   private:
-    const std::vector<Edge>& outgoing;
-    const std::vector<Edge>& incoming;
-    std::vector<Edge>::const_iterator iter;
+    const EdgeList& outgoing;
+    const EdgeList& incoming;
+    EdgeList::const_iterator iter;
+    // the lists may be adjacent in memory, the end of the incoming
+    // list can therefore coincide with the beginning of the outgoing one
+    bool inIncoming;
   public:
-    Iterator(const std::vector<Edge>& outgoing,
-             const std::vector<Edge>& incoming,
-             const std::vector<Edge>::const_iterator& iter)
+    Iterator(const EdgeList& outgoing,
+             const EdgeList& incoming,
+             const EdgeList::const_iterator& iter,
+             bool inIncoming)
       : outgoing(outgoing),
         incoming(incoming),
-        iter(iter)
+        iter(iter),
+        inIncoming(inIncoming)
     {}
-    Iterator(const std::vector<Edge>& outgoing,
-             const std::vector<Edge>& incoming)
+    Iterator(const EdgeList& outgoing,
+             const EdgeList& incoming)
       : outgoing(outgoing),
         incoming(incoming),
-        iter(outgoing.end())
+        iter(outgoing.end()),
+        inIncoming(false)
     {}
 
     const Edge& operator*()
@@ -57,23 +72,25 @@ public:
 
     const Iterator& operator++()
     {
-      if(++iter == incoming.end())
+      if(++iter == incoming.end() and inIncoming)
       {
         iter = outgoing.begin();
+        inIncoming = false;
       }
       return *this;
     }
 
     const bool operator!=(const Iterator& other)
     {
-      return iter != other.iter;
+      return iter != other.iter or inIncoming != other.inIncoming;
     }
   };
 
   Iterator begin()
   {
-    return Iterator(outgoing, incoming,
-                    incoming.empty() ? outgoing.begin() : incoming.begin());
+    return incoming.empty() ?
+      Iterator(outgoing, incoming, outgoing.begin(), false) :
+      Iterator(outgoing, incoming, incoming.begin(), true);
   }
   Iterator end()
   {
@@ -161,7 +178,8 @@ public:
 
 /**
  * A class modelling a graph. Vertices are stored implicitely.
- * Outgoing / incoming Edge%s are stored in vectors.
+ * Outgoing / incoming Edge%s are stored in vectors, which are
+ * allocated consecutively from an Arena owned by the Graph.
  **/
 class Graph
 {
@@ -169,7 +187,8 @@ private:
   idx size;
   std::vector<Edge> edges;
 
-  std::vector<std::vector<Edge>> outgoing, incoming;
+  std::shared_ptr<Arena> arena;
+  std::vector<EdgeList> outgoing, incoming;
 
   bool check() const;
 
@@ -183,6 +202,16 @@ public:
   Graph(idx size, const std::vector<Edge>& edges);
   Graph() {}
 
+  /**
+   * Copies the given Graph, placing the adjacency
+   * lists into a new Arena.
+   **/
+  Graph(const Graph& other);
+  Graph(Graph&& other) = default;
+
+  Graph& operator=(const Graph& other);
+  Graph& operator=(Graph&& other) = default;
+
   /**
    * Returns the Edge%s in this Graph.
    **/
@@ -197,19 +226,19 @@ public:
   /**
    * Returns the outgoing Edge%s of the given Vertex.
    **/
-  const std::vector<Edge>& getOutgoing(Vertex vertex) const;
+  const EdgeList& getOutgoing(Vertex vertex) const;
 
   /**
    * Returns the incoming Edge%s of the given Vertex.
    **/
-  const std::vector<Edge>& getIncoming(Vertex vertex) const;
+  const EdgeList& getIncoming(Vertex vertex) const;
 
   /**
    * Returns the all Edge%s incident to the given Vertex with
    * respect to a given Direction.
    **/
-  const std::vector<Edge>& getEdges(Vertex vertex,
-                                    Direction direction) const;
+  const EdgeList& getEdges(Vertex vertex,
+                           Direction direction) const;
 
   /**
    * Returns an iterator over the Edge%s which are incident to
@@ -222,6 +251,12 @@ public:
                          getIncoming(vertex));
   }
 
+  /**
+   * Returns the memory used by the Edge%s and adjacency lists.
+   * The lists are accounted by the blocks of their Arena.
+   **/
+  MemoryUsage memoryUsage() const;
+
   /**
    * Returns whether the Graph contains the given Edge.
    **/
@@ -229,7 +264,9 @@ public:
 
   /**
    * Adds an Edge between the given vertices to the Graph.
-   * The added Edge is returned.
+   * The added Edge is returned. Since the Arena does not reuse
+   * memory, the adjacency lists of Graph%s which are extended
+   * by many Edge%s occupy up to twice their regular size.
    **/
   Edge addEdge(Vertex source, Vertex target);
 
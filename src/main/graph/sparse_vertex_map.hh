@@ -0,0 +1,85 @@
+#ifndef SPARSE_VERTEX_MAP_HH
+#define SPARSE_VERTEX_MAP_HH
+
+#include <vector>
+
+#include "graph/graph.hh"
+#include "graph/vertex_map.hh"
+
+/**
+ * A VertexMap which keeps track of the Vertex%s whose values
+ * have been set. Resetting the map to its default value
+ * only touches these Vertex%s, which is considerably cheaper
+ * than resetting an entire VertexMap if only a small part
+ * of the Graph is explored in between resets.
+ **/
+template <class T>
+class SparseVertexMap : public VertexFunc<const T&>
+{
+private:
+  std::vector<T> values;
+  std::vector<idx> touched;
+  T defaultValue;
+
+public:
+  SparseVertexMap(const Graph& graph, T value)
+    : values(graph.getVertices().size(), value),
+      defaultValue(value)
+  {
+  }
+
+  SparseVertexMap()
+  {}
+
+  const T& operator()(const Vertex& vertex) const override
+  {
+    return values[vertex.getIndex()];
+  }
+
+  void setValue(const Vertex& vertex, const T& value)
+  {
+    T& current = values[vertex.getIndex()];
+
+    if(current == defaultValue)
+    {
+      touched.push_back(vertex.getIndex());
+    }
+
+    current = value;
+  }
+
+  /**
+   * Resets the values of all touched Vertex%s
+   * to the default value.
+   **/
+  void reset()
+  {
+    for(const idx& index : touched)
+    {
+      values[index] = defaultValue;
+    }
+
+    touched.clear();
+  }
+
+  /**
+   * Returns the number of Vertex%s touched since
+   * the last reset (possibly including duplicates).
+   **/
+  idx numTouched() const
+  {
+    return touched.size();
+  }
+
+  /**
+   * Returns the memory used by the stored values.
+   **/
+  MemoryUsage memoryUsage(const std::string& name = "SparseVertexMap") const
+  {
+    return MemoryUsage(name)
+      .add("values", heapUsage(values))
+      .add("touched", heapUsage(touched));
+  }
+};
+
+#endif /* SPARSE_VERTEX_MAP_HH */
@@ -81,7 +81,7 @@ template <class T>
 class VertexMap : public VertexFunc<const T&>
 {
 private:
-  std::vector<T> values;
+  std::vector<T, LargeAllocator<T>> values;
 
 public:
   VertexMap(const Graph& graph, T value)
@@ -116,6 +116,14 @@ public:
   {
     return VertexValueMap<T>(*this);
   }
+
+  /**
+   * Returns the memory used by the stored values.
+   **/
+  MemoryUsage memoryUsage(const std::string& name = "VertexMap") const
+  {
+    return MemoryUsage(name, heapUsage(values));
+  }
 };
 
 #endif /* VERTEX_MAP_HH */
@@ -0,0 +1,53 @@
+#include "memory_usage.hh"
+
+std::size_t MemoryUsage::getTotal() const
+{
+  std::size_t total = bytes;
+
+  for(const MemoryUsage& component : components)
+  {
+    total += component.getTotal();
+  }
+
+  return total;
+}
+
+void MemoryUsage::print(std::ostream& out, idx depth) const
+{
+  out << std::string(2 * depth, ' ')
+      << name << ": "
+      << getTotal() << " bytes\n";
+
+  for(const MemoryUsage& component : components)
+  {
+    component.print(out, depth + 1);
+  }
+}
+
+void MemoryUsage::printJSON(std::ostream& out) const
+{
+  out << "{\"name\": \"" << name << "\", "
+      << "\"bytes\": " << getTotal() << ", "
+      << "\"components\": [";
+
+  bool first = true;
+
+  for(const MemoryUsage& component : components)
+  {
+    if(!first)
+    {
+      out << ", ";
+    }
+
+    component.printJSON(out);
+    first = false;
+  }
+
+  out << "]}";
+}
+
+std::ostream& operator<<(std::ostream& out, const MemoryUsage& usage)
+{
+  usage.print(out);
+  return out;
+}
@@ -0,0 +1,170 @@
+#ifndef MEMORY_USAGE_HH
+#define MEMORY_USAGE_HH
+
+#include <climits>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "util.hh"
+
+/** @file **/
+
+/**
+ * A breakdown of the memory used by some data structure. Each
+ * MemoryUsage has a name, the number of bytes used directly by
+ * the component and a number of sub-components. The sizes are
+ * computed from the capacities of the underlying containers,
+ * including the heap allocations of nested containers.
+ **/
+class MemoryUsage
+{
+private:
+  std::string name;
+  std::size_t bytes;
+  std::vector<MemoryUsage> components;
+
+public:
+  MemoryUsage(const std::string& name, std::size_t bytes = 0)
+    : name(name),
+      bytes(bytes)
+  {}
+
+  /**
+   * Adds the given sub-component.
+   *
+   * @return this MemoryUsage
+   **/
+  MemoryUsage& add(const MemoryUsage& component)
+  {
+    components.push_back(component);
+    return *this;
+  }
+
+  MemoryUsage& add(const std::string& name, std::size_t bytes)
+  {
+    return add(MemoryUsage(name, bytes));
+  }
+
+  const std::string& getName() const
+  {
+    return name;
+  }
+
+  /**
+   * Returns the number of bytes used directly
+   * (i.e., not by the sub-components).
+   **/
+  std::size_t getBytes() const
+  {
+    return bytes;
+  }
+
+  /**
+   * Returns the number of bytes used including
+   * the sub-components.
+   **/
+  std::size_t getTotal() const;
+
+  const std::vector<MemoryUsage>& getComponents() const
+  {
+    return components;
+  }
+
+  /**
+   * Prints the breakdown as an indented tree.
+   **/
+  void print(std::ostream& out, idx depth = 0) const;
+
+  /**
+   * Prints the breakdown as a JSON object.
+   **/
+  void printJSON(std::ostream& out) const;
+};
+
+std::ostream& operator<<(std::ostream& out, const MemoryUsage& usage);
+
+/**
+ * Returns the number of bytes allocated on the heap by the given
+ * value. Values without heap allocations (such as numbers or
+ * Edge%s) use none.
+ **/
+template <class T>
+std::size_t heapUsage(const T& value);
+
+template <class T, class A>
+std::size_t heapUsage(const std::vector<T, A>& values);
+
+template <class A>
+std::size_t heapUsage(const std::vector<bool, A>& values);
+
+template <class K, class V, class H, class E, class A>
+std::size_t heapUsage(const std::unordered_map<K, V, H, E, A>& values);
+
+template <class K, class H, class E, class A>
+std::size_t heapUsage(const std::unordered_set<K, H, E, A>& values);
+
+template <class T>
+std::size_t heapUsage(const T&)
+{
+  return 0;
+}
+
+template <class T, class A>
+std::size_t heapUsage(const std::vector<T, A>& values)
+{
+  std::size_t bytes = values.capacity() * sizeof(T);
+
+  for(const T& value : values)
+  {
+    bytes += heapUsage(value);
+  }
+
+  return bytes;
+}
+
+template <class A>
+std::size_t heapUsage(const std::vector<bool, A>& values)
+{
+  return (values.capacity() + CHAR_BIT - 1) / CHAR_BIT;
+}
+
+/*
+ * The nodes of an unordered container store the value, the
+ * pointer to the next node and (typically) the cached hash.
+ */
+template <class K, class V, class H, class E, class A>
+std::size_t heapUsage(const std::unordered_map<K, V, H, E, A>& values)
+{
+  std::size_t bytes = values.bucket_count() * sizeof(void*) +
+    values.size() * (sizeof(std::pair<const K, V>) +
+                     sizeof(void*) +
+                     sizeof(std::size_t));
+
+  for(const auto& value : values)
+  {
+    bytes += heapUsage(value.first) + heapUsage(value.second);
+  }
+
+  return bytes;
+}
+
+template <class K, class H, class E, class A>
+std::size_t heapUsage(const std::unordered_set<K, H, E, A>& values)
+{
+  std::size_t bytes = values.bucket_count() * sizeof(void*) +
+    values.size() * (sizeof(K) +
+                     sizeof(void*) +
+                     sizeof(std::size_t));
+
+  for(const K& value : values)
+  {
+    bytes += heapUsage(value);
+  }
+
+  return bytes;
+}
+
+#endif /* MEMORY_USAGE_HH */
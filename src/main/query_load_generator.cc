@@ -0,0 +1,225 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "benchmark.hh"
+#include "log.hh"
+
+#include "server/query_channel.hh"
+
+namespace
+{
+  int connectSocket(const std::string& path)
+  {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if(path.size() >= sizeof(address.sun_path))
+    {
+      throw std::invalid_argument("Socket path is too long");
+    }
+
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    const int currentSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if(currentSocket < 0)
+    {
+      throw std::runtime_error("Could not create socket");
+    }
+
+    if(connect(currentSocket, (sockaddr*) &address, sizeof(address)) < 0)
+    {
+      close(currentSocket);
+      throw std::runtime_error("Could not connect to " + path);
+    }
+
+    return currentSocket;
+  }
+
+  /**
+   * Closes the owned socket on destruction.
+   **/
+  class SocketGuard
+  {
+  private:
+    const int socket;
+
+  public:
+    SocketGuard(int socket)
+      : socket(socket)
+    {}
+
+    SocketGuard(const SocketGuard& other) = delete;
+    SocketGuard& operator=(const SocketGuard& other) = delete;
+
+    ~SocketGuard()
+    {
+      close(socket);
+    }
+  };
+
+  /**
+   * The results of a single connection: the latency of each
+   * batch (in seconds) and the number of found paths.
+   **/
+  class ConnectionResult
+  {
+  public:
+    ConnectionResult()
+      : numFound(0)
+    {}
+
+    LatencyHistogram latencies;
+    idx numFound;
+    std::string error;
+  };
+
+  void runConnection(const std::string& path,
+                     idx numBatches,
+                     idx batchSize,
+                     idx seed,
+                     ConnectionResult& result)
+  {
+    try
+    {
+      const int currentSocket = connectSocket(path);
+      const SocketGuard guard(currentSocket);
+
+      QueryChannel channel(currentSocket);
+
+      const idx numVertices = channel.readHeader();
+
+      std::mt19937 engine(seed);
+      std::uniform_int_distribution<idx> distribution(0, numVertices - 1);
+
+      std::vector<Query> queries(batchSize);
+      std::vector<QueryAnswer> answers;
+
+      for(idx batch = 0; batch < numBatches; ++batch)
+      {
+        for(Query& query : queries)
+        {
+          query = Query(distribution(engine), distribution(engine));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        channel.writeQueries(queries);
+
+        if(!channel.readAnswers(answers) or answers.size() != queries.size())
+        {
+          throw std::runtime_error("Incomplete response");
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        result.latencies.add(elapsed.count());
+
+        for(const QueryAnswer& answer : answers)
+        {
+          if(answer.found)
+          {
+            ++result.numFound;
+          }
+        }
+      }
+    }
+    catch(const std::exception& exception)
+    {
+      result.error = exception.what();
+    }
+  }
+}
+
+/**
+ * Issues batches of random queries to a running query server
+ * over concurrent connections and reports the sustained
+ * throughput together with the tail latencies of the batches.
+ **/
+int main(int argc, char **argv)
+{
+  logInit();
+
+  if(argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0]
+              << " <socket>"
+              << " [<connections> [<batches> [<batch size> [<seed>]]]]"
+              << std::endl;
+
+    return 1;
+  }
+
+  const std::string path = argv[1];
+  const idx numConnections = (argc > 2) ? std::stoul(argv[2]) : 4;
+  const idx numBatches = (argc > 3) ? std::stoul(argv[3]) : 100;
+  const idx batchSize = (argc > 4) ? std::stoul(argv[4]) : 16;
+  const idx seed = (argc > 5) ? std::stoul(argv[5]) : 1;
+
+  std::vector<ConnectionResult> results(numConnections);
+  std::vector<std::thread> threads;
+
+  auto start = std::chrono::steady_clock::now();
+
+  for(idx i = 0; i < numConnections; ++i)
+  {
+    threads.push_back(std::thread(runConnection,
+                                  path,
+                                  numBatches,
+                                  batchSize,
+                                  seed + i,
+                                  std::ref(results[i])));
+  }
+
+  for(std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  LatencyHistogram latencies;
+  idx numFound = 0;
+
+  for(const ConnectionResult& result : results)
+  {
+    if(!result.error.empty())
+    {
+      Log(error) << "Connection failed: " << result.error;
+      return 1;
+    }
+
+    latencies.add(result.latencies);
+
+    numFound += result.numFound;
+  }
+
+  const idx numQueries = latencies.size() * batchSize;
+
+  std::cout << "Queries: " << numQueries
+            << " (" << numFound << " found)" << std::endl
+            << "Throughput: " << numQueries / elapsed.count()
+            << " queries per second" << std::endl;
+
+  if(!latencies.isEmpty())
+  {
+    std::cout << "Batch latency p50: " << latencies.percentile(0.5)
+              << " s, p90: " << latencies.percentile(0.9)
+              << " s, p99: " << latencies.percentile(0.99)
+              << " s, max: " << latencies.max()
+              << " s" << std::endl;
+  }
+
+  return 0;
+}
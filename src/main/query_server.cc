@@ -0,0 +1,294 @@
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <unistd.h>
+
+#include "log.hh"
+
+#include "reader/bidirected_arcflag_reader.hh"
+#include "reader/graph_reader.hh"
+#include "reader/hierarchy_reader.hh"
+#include "reader/required_values_reader.hh"
+
+#include "server/numa_topology.hh"
+#include "server/query_channel.hh"
+#include "server/query_replicas.hh"
+#include "server/query_routers.hh"
+#include "server/query_server.hh"
+
+namespace
+{
+  QueryServer* activeServer = nullptr;
+
+  void handleSignal(int signal)
+  {
+    if(activeServer)
+    {
+      activeServer->stop();
+    }
+  }
+
+  void printUsage(const char* name)
+  {
+    std::cerr << "Usage: " << name
+              << " <graphfile> <socket | ->"
+              << " [--router <name>]"
+              << " [--searching]"
+              << " [--numa]"
+              << " [--hierarchy <file>]"
+              << " [--robust-hierarchy <file>]"
+              << " [--flags <file>]"
+              << " [--values <file>]"
+              << " [--deviation-size <size>]"
+              << " [--threads <count>]"
+              << " [--grain-size <size>]"
+              << std::endl;
+
+    std::cerr << "Routers:";
+
+    for(const std::string& routerName : queryRouterNames())
+    {
+      std::cerr << " " << routerName;
+    }
+
+    std::cerr << std::endl;
+  }
+
+  std::ifstream openInput(const std::string& filename)
+  {
+    std::ifstream input(filename, std::ios_base::in | std::ios_base::binary);
+
+    if(!input)
+    {
+      throw std::runtime_error("Could not open " + filename);
+    }
+
+    return input;
+  }
+}
+
+/**
+ * Loads a Graph together with its preprocessed data once and
+ * answers robust queries on a Unix domain socket (or on stdin /
+ * stdout if the socket is given as "-") until it is interrupted.
+ * With --numa, the data is replicated on each NUMA node and each
+ * node answers queries using a pool of workers pinned to its CPUs,
+ * which replaces the number of threads given via --threads.
+ * @see QueryChannel for the framing of the queries.
+ **/
+int main(int argc, char **argv)
+{
+  logInit();
+
+  if(argc < 3)
+  {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  const std::string graphName = argv[1];
+  const std::string socketName = argv[2];
+
+  std::string routerName = "goal-directed";
+  std::string hierarchyName, robustHierarchyName, flagName, valueName;
+  bool searching = false, numa = false;
+  idx deviationSize = 5, numThreads = 0, grainSize = 1;
+
+  for(int i = 3; i < argc; ++i)
+  {
+    const std::string option = argv[i];
+
+    if(option == "--searching")
+    {
+      searching = true;
+      continue;
+    }
+
+    if(option == "--numa")
+    {
+      numa = true;
+      continue;
+    }
+
+    if(i + 1 >= argc)
+    {
+      printUsage(argv[0]);
+      return 1;
+    }
+
+    const std::string value = argv[++i];
+
+    if(option == "--router")
+    {
+      routerName = value;
+    }
+    else if(option == "--hierarchy")
+    {
+      hierarchyName = value;
+    }
+    else if(option == "--robust-hierarchy")
+    {
+      robustHierarchyName = value;
+    }
+    else if(option == "--flags")
+    {
+      flagName = value;
+    }
+    else if(option == "--values")
+    {
+      valueName = value;
+    }
+    else if(option == "--deviation-size")
+    {
+      deviationSize = std::stoul(value);
+    }
+    else if(option == "--threads")
+    {
+      numThreads = std::stoul(value);
+    }
+    else if(option == "--grain-size")
+    {
+      grainSize = std::stoul(value);
+    }
+    else
+    {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::ifstream graphInput = openInput(graphName);
+
+  ReadResult result = GraphReader().readGraph(graphInput);
+
+  const Graph& graph = result.graph;
+  const EdgeValueMap<num> costs = result.costs.getValues();
+  const EdgeValueMap<num> deviations = result.deviations.getValues();
+
+  std::unique_ptr<ContractionHierarchy> hierarchy;
+  std::unique_ptr<RobustContractionHierarchy> robustHierarchy;
+  std::unique_ptr<BidirectedArcFlagResult> flags;
+  std::unique_ptr<RequiredValuesReadResult> values;
+
+  if(!hierarchyName.empty())
+  {
+    std::ifstream input = openInput(hierarchyName);
+    hierarchy = HierarchyReader().readHierarchy(input);
+  }
+
+  if(!robustHierarchyName.empty())
+  {
+    std::ifstream input = openInput(robustHierarchyName);
+    robustHierarchy = HierarchyReader().readRobustHierarchy(input);
+  }
+
+  if(!flagName.empty())
+  {
+    std::ifstream input = openInput(flagName);
+    flags.reset(new BidirectedArcFlagResult(BidirectedArcFlagReader().readBidirectedArcFlags(graph,
+                                                                                             input)));
+  }
+
+  if(!valueName.empty())
+  {
+    std::ifstream input = openInput(valueName);
+    values.reset(new RequiredValuesReadResult(RequiredValuesReader().readRequiredValues(graph,
+                                                                                        input)));
+
+    // the required values are only valid for their deviation size
+    deviationSize = values->deviationSize;
+  }
+
+  QueryData data(graph, costs, deviations, deviationSize);
+
+  data.hierarchy = hierarchy.get();
+  data.robustHierarchy = robustHierarchy.get();
+
+  if(flags)
+  {
+    data.flagPartition = flags->partition.get();
+    data.incomingFlags = flags->incomingFlags.get();
+    data.outgoingFlags = flags->outgoingFlags.get();
+  }
+
+  if(values)
+  {
+    data.valuePartition = values->partition.get();
+    data.requiredValues = values->requiredValues.get();
+  }
+
+  RobustRouterFactory factory;
+
+  try
+  {
+    factory = createRouterFactory(routerName, searching, data);
+  }
+  catch(const std::invalid_argument& exception)
+  {
+    std::cerr << exception.what() << std::endl;
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  std::unique_ptr<ReplicatedQueryData> replicatedData;
+  std::unique_ptr<QueryServer> server;
+
+  if(numa)
+  {
+    const NumaTopology topology = NumaTopology::detect();
+
+    Log(info) << "Found " << topology.size() << " NUMA nodes";
+
+    // the data is only replicated if there are several nodes
+    replicatedData.reset(new ReplicatedQueryData(data, topology));
+
+    server.reset(new QueryServer(graph,
+                                 costs,
+                                 deviations,
+                                 deviationSize,
+                                 createRouterFactories(routerName,
+                                                       searching,
+                                                       *replicatedData),
+                                 topology,
+                                 grainSize));
+  }
+  else
+  {
+    server.reset(new QueryServer(graph,
+                                 costs,
+                                 deviations,
+                                 deviationSize,
+                                 factory,
+                                 numThreads,
+                                 grainSize));
+  }
+
+  Log(info) << "Serving " << routerName << " queries with a deviation size of "
+            << deviationSize;
+
+  // broken connections are reported by the QueryChannel
+  std::signal(SIGPIPE, SIG_IGN);
+
+  if(socketName == "-")
+  {
+    QueryChannel channel(STDIN_FILENO, STDOUT_FILENO);
+    server->serve(channel);
+
+    return 0;
+  }
+
+  activeServer = server.get();
+
+  std::signal(SIGINT, handleSignal);
+  std::signal(SIGTERM, handleSignal);
+
+  server->listen(socketName);
+
+  activeServer = nullptr;
+
+  return 0;
+}
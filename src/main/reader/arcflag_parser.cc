@@ -1,11 +1,19 @@
 #include "arcflag_parser.hh"
 
+#include <algorithm>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include "log.hh"
 
 #include "arcflags/arcflags.hh"
 
 const idx batchSize = 32;
 
+// the number of edges whose words are copied per task
+const idx grainSize = 1 << 12;
+
 std::unique_ptr<ArcFlags>
 ArcFlagParser::parseArcFlags(const Graph& graph,
                              const Partition& partition,
@@ -16,43 +24,102 @@ ArcFlagParser::parseArcFlags(const Graph& graph,
   std::unique_ptr<ArcFlags> arcFlags(new ArcFlags(graph, partition));
 
   const idx numRegions = partition.getRegions().size();
+  const idx numWords = arcFlags->getNumWords();
+  const std::vector<Edge>& edges = graph.getEdges();
 
-  if((numRegions % batchSize) != 0)
+  typedef ArcFlags::Word Word;
+
+  if(!PBFArcFlags.has_num_regions())
   {
-    throw std::runtime_error("Partition must contain of a multiple of 32 regions");
+    parseLegacyArcFlags(graph, partition, PBFArcFlags, *arcFlags);
+
+    Log(info) << "Parsed arc flags";
+
+    return arcFlags;
   }
 
-  const idx numBatches = numRegions / batchSize;
+  if(PBFArcFlags.num_regions() != numRegions)
+  {
+    throw std::runtime_error("Message has an invalid number of regions");
+  }
 
-  if(PBFArcFlags.flags_size() != (int) (graph.getEdges().size() * numBatches))
+  if((std::size_t) PBFArcFlags.words_size() != ((std::size_t) edges.size()) * numWords)
   {
     throw std::runtime_error("Message has an invalid length");
   }
 
-  idx currentIndex = 0;
+  const auto* data = PBFArcFlags.words().data();
 
-  for(const Edge& edge : graph.getEdges())
-  {
-    auto it = partition.getRegions().begin();
-
-    for(idx currentBatch = 0; currentBatch != numBatches; ++currentBatch)
-    {
-      google::protobuf::uint32 flags = PBFArcFlags.flags(currentIndex++);
-      for(idx batchIndex = 0; batchIndex != batchSize; ++batchIndex)
-      {
-        if(flags & (1 << batchIndex))
-        {
-          arcFlags->setFlag(edge, *(it));
-        }
-
-        ++it;
-      }
-    }
-
-    assert(it == partition.getRegions().end());
-  }
+  const idx numPadded = numRegions % ArcFlags::wordSize;
+
+  // clears the padding beyond the last region
+  const Word mask = (numPadded == 0) ?
+    ~((Word) 0) :
+    (((Word) 1) << numPadded) - 1;
+
+  tbb::parallel_for(tbb::blocked_range<idx>(0, edges.size(), grainSize),
+                    [&](const tbb::blocked_range<idx>& range)
+                    {
+                      if(range.empty() or numWords == 0)
+                      {
+                        return;
+                      }
+
+                      Word* first = arcFlags->getWords(edges[range.begin()]);
+
+                      std::copy(data + ((std::size_t) range.begin()) * numWords,
+                                data + ((std::size_t) range.end()) * numWords,
+                                first);
+
+                      for(idx i = 0; i < range.size(); ++i)
+                      {
+                        first[(i + 1) * numWords - 1] &= mask;
+                      }
+                    });
 
   Log(info) << "Parsed arc flags";
 
   return arcFlags;
 }
+
+void
+ArcFlagParser::parseLegacyArcFlags(const Graph& graph,
+                                   const Partition& partition,
+                                   const Protobuf::ArcFlags& PBFArcFlags,
+                                   ArcFlags& arcFlags)
+{
+  typedef ArcFlags::Word Word;
+
+  const idx numRegions = partition.getRegions().size();
+
+  if((numRegions % batchSize) != 0)
+  {
+    throw std::runtime_error("Partition must contain of a multiple of 32 regions");
+  }
+
+  const idx numBatches = numRegions / batchSize;
+  const std::vector<Edge>& edges = graph.getEdges();
+
+  if((std::size_t) PBFArcFlags.flags_size() != ((std::size_t) edges.size()) * numBatches)
+  {
+    throw std::runtime_error("Message has an invalid length");
+  }
+
+  const auto* data = PBFArcFlags.flags().data();
+
+  // each word consists of two consecutive batches
+  tbb::parallel_for(tbb::blocked_range<idx>(0, edges.size(), grainSize),
+                    [&](const tbb::blocked_range<idx>& range)
+                    {
+                      for(idx i = range.begin(); i != range.end(); ++i)
+                      {
+                        Word* words = arcFlags.getWords(edges[i]);
+                        const auto* batches = data + ((std::size_t) i) * numBatches;
+
+                        for(idx batch = 0; batch < numBatches; ++batch)
+                        {
+                          words[batch / 2] |= ((Word) batches[batch]) << (batchSize * (batch % 2));
+                        }
+                      }
+                    });
+}
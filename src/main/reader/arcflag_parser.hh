@@ -11,7 +11,22 @@
 
 class ArcFlagParser
 {
+private:
+  /**
+   * Parses flags stored in batches of 32 bits, requiring
+   * the number of Region%s to be a multiple of 32.
+   **/
+  void parseLegacyArcFlags(const Graph& graph,
+                           const Partition& partition,
+                           const Protobuf::ArcFlags& PBFArcFlags,
+                           ArcFlags& arcFlags);
+
 public:
+  /**
+   * Parses flags which are stored as whole words per Edge
+   * together with the number of Region%s, falling back
+   * to the legacy format if the latter is absent.
+   **/
   std::unique_ptr<ArcFlags> parseArcFlags(const Graph& graph,
                                           const Partition& partition,
                                           const Protobuf::ArcFlags& PBFArcFlags);
@@ -0,0 +1,133 @@
+#include "hierarchy_reader.hh"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+
+#include "log.hh"
+
+#include "graph.pb.h"
+
+namespace
+{
+  const int maxSize = std::numeric_limits<int32_t>::max();
+
+  void readMessage(std::istream& in,
+                   Protobuf::ContractionHierarchy& PBFHierarchy)
+  {
+    using namespace google::protobuf::io;
+
+    IstreamInputStream input(&in);
+    CodedInputStream codedInput(&input);
+
+    codedInput.SetTotalBytesLimit(maxSize, maxSize);
+
+    if(!in)
+    {
+      throw std::runtime_error("Could not open input");
+    }
+    else if(!PBFHierarchy.MergeFromCodedStream(&codedInput))
+    {
+      throw std::runtime_error("Failed to parse input");
+    }
+  }
+
+  template <class T, class Field>
+  std::vector<T> parseValues(const Field& field)
+  {
+    return std::vector<T>(field.begin(), field.end());
+  }
+
+  QueryGraph parseQueryGraph(const Protobuf::QueryGraph& PBFQueryGraph)
+  {
+    return QueryGraph(parseValues<idx>(PBFQueryGraph.offsets()),
+                      parseValues<idx>(PBFQueryGraph.heads()),
+                      parseValues<num>(PBFQueryGraph.weights()),
+                      parseValues<idx>(PBFQueryGraph.shortcuts()));
+  }
+
+  RangeTable parseRangeTable(const Protobuf::RangeTable& PBFRanges)
+  {
+    return RangeTable(parseValues<num>(PBFRanges.minimums()),
+                      parseValues<num>(PBFRanges.maximums()),
+                      parseValues<idx>(PBFRanges.slopes()),
+                      parseValues<idx>(PBFRanges.offsets()),
+                      parseValues<num>(PBFRanges.values()));
+  }
+
+  ShortcutTable parseShortcutTable(const Protobuf::ShortcutTable& PBFShortcuts,
+                                   idx numVertices)
+  {
+    const idx size = PBFShortcuts.sources_size();
+
+    if(PBFShortcuts.targets_size() != (int) size)
+    {
+      throw std::runtime_error("Inconsistent shortcut table");
+    }
+
+    std::vector<Edge> edges;
+    edges.reserve(size);
+
+    for(idx i = 0; i < size; ++i)
+    {
+      const idx source = PBFShortcuts.sources(i);
+      const idx target = PBFShortcuts.targets(i);
+
+      if(source >= numVertices or target >= numVertices)
+      {
+        throw std::runtime_error("Invalid shortcut");
+      }
+
+      edges.push_back(Edge(Vertex(source), Vertex(target), i));
+    }
+
+    return ShortcutTable(std::move(edges),
+                         parseValues<idx>(PBFShortcuts.first()),
+                         parseValues<idx>(PBFShortcuts.second()));
+  }
+}
+
+std::unique_ptr<ContractionHierarchy>
+HierarchyReader::readHierarchy(std::istream& in)
+{
+  Protobuf::ContractionHierarchy PBFHierarchy;
+
+  Log(info) << "Reading contraction hierarchy";
+
+  readMessage(in, PBFHierarchy);
+
+  const idx numVertices = PBFHierarchy.ranks_size();
+
+  return std::unique_ptr<ContractionHierarchy>(
+    new ContractionHierarchy(parseValues<idx>(PBFHierarchy.ranks()),
+                             parseQueryGraph(PBFHierarchy.upward_graph()),
+                             parseQueryGraph(PBFHierarchy.downward_graph()),
+                             parseShortcutTable(PBFHierarchy.shortcuts(),
+                                                numVertices)));
+}
+
+std::unique_ptr<RobustContractionHierarchy>
+HierarchyReader::readRobustHierarchy(std::istream& in)
+{
+  Protobuf::ContractionHierarchy PBFHierarchy;
+
+  Log(info) << "Reading robust contraction hierarchy";
+
+  readMessage(in, PBFHierarchy);
+
+  if(!(PBFHierarchy.has_upward_ranges() and
+       PBFHierarchy.has_downward_ranges()))
+  {
+    throw std::runtime_error("Input does not contain a robust hierarchy");
+  }
+
+  const idx numVertices = PBFHierarchy.ranks_size();
+
+  return std::unique_ptr<RobustContractionHierarchy>(
+    new RobustContractionHierarchy(parseValues<idx>(PBFHierarchy.ranks()),
+                                   parseQueryGraph(PBFHierarchy.upward_graph()),
+                                   parseQueryGraph(PBFHierarchy.downward_graph()),
+                                   parseRangeTable(PBFHierarchy.upward_ranges()),
+                                   parseRangeTable(PBFHierarchy.downward_ranges()),
+                                   parseShortcutTable(PBFHierarchy.shortcuts(),
+                                                      numVertices)));
+}
@@ -0,0 +1,24 @@
+#ifndef HIERARCHY_READER_HH
+#define HIERARCHY_READER_HH
+
+#include <iostream>
+#include <memory>
+
+#include "contraction/contraction_hierarchy.hh"
+#include "robust/contraction/robust_contraction_hierarchy.hh"
+
+/**
+ * Reads (robust) contraction hierarchies written
+ * by a HierarchyWriter. The input is validated, a
+ * std::runtime_error is thrown if it is corrupt.
+ **/
+class HierarchyReader
+{
+public:
+  std::unique_ptr<ContractionHierarchy> readHierarchy(std::istream& in);
+
+  std::unique_ptr<RobustContractionHierarchy> readRobustHierarchy(std::istream& in);
+};
+
+
+#endif /* HIERARCHY_READER_HH */
@@ -1,5 +1,7 @@
 #include "active_router.hh"
 
+#include <algorithm>
+
 #include "robust/reduced_costs.hh"
 
 namespace
@@ -34,16 +36,32 @@ namespace
     }
   };
 
+  /**
+   * The active Edge%s of an interval, given by a block of an
+   * ActiveEdgeArena. The Edge%s whose deviations reach the
+   * maximum value of the interval are only counted.
+   **/
   class ActiveEdgeSet
   {
   private:
-    const EdgeFunc<num>& deviations;
-    std::vector<Edge> edges;
+    const ActiveEdgeArena* arena;
+    idx begin, size;
     idx numHeavy;
     PathCost leftCost, rightCost;
 
+    /**
+     * Returns the total weight of the given number
+     * of Edge%s with the smallest deviations.
+     **/
+    int64_t getWeight(idx count) const
+    {
+      return arena->getSum(begin, count) -
+        ((int64_t) count) * rightCost.getValue();
+    }
+
   public:
-    ActiveEdgeSet(const EdgeFunc<num>& deviations,
+    ActiveEdgeSet(ActiveEdgeArena& arena,
+                  const EdgeFunc<num>& deviations,
                   const std::vector<Edge>& edges,
                   PathCost leftCost,
                   PathCost rightCost);
@@ -52,25 +70,16 @@ namespace
                   PathCost leftCost);
 
     num getLowerBound(const num value) const;
-
-    const EdgeFunc<num>& getDeviations() const
-    {
-      return deviations;
-    }
-
-    const std::vector<Edge>& getEdges() const
-    {
-      return edges;
-    }
   };
 
 
-  ActiveEdgeSet::ActiveEdgeSet(const EdgeFunc<num>& deviations,
-                               const std::vector<Edge>& otherEdges,
+  ActiveEdgeSet::ActiveEdgeSet(ActiveEdgeArena& arena,
+                               const EdgeFunc<num>& deviations,
+                               const std::vector<Edge>& edges,
                                PathCost leftCost,
                                PathCost rightCost)
-    : deviations(deviations),
-      numHeavy(0),
+    : arena(&arena),
+      begin(arena.size()),
       leftCost(leftCost),
       rightCost(rightCost)
   {
@@ -80,31 +89,16 @@ namespace
     assert(minValue < maxValue);
     assert(leftCost.getCost() <= rightCost.getCost());
 
-    for(const Edge& edge : otherEdges)
-    {
-      assert(deviations(edge) > minValue);
+    arena.add(deviations, edges, minValue, maxValue);
 
-      if(deviations(edge) >= maxValue)
-      {
-        ++numHeavy;
-      }
-      else
-      {
-        edges.push_back(edge);
-      }
-    }
-
-    std::sort(edges.begin(), edges.end(),
-              [&](const Edge& first, const Edge& second)
-              {
-                return deviations(first) < deviations(second);
-              });
+    size = arena.size() - begin;
+    numHeavy = edges.size() - size;
   }
 
   ActiveEdgeSet::ActiveEdgeSet(const ActiveEdgeSet& other,
                                PathCost leftCost)
-    : deviations(other.getDeviations()),
-      numHeavy(other.numHeavy),
+    : arena(other.arena),
+      begin(other.begin),
       leftCost(leftCost),
       rightCost(other.rightCost)
   {
@@ -116,21 +110,24 @@ namespace
     assert(minValue < maxValue);
     assert(leftCost.getCost() <= rightCost.getCost());
 
-    for(const Edge& edge : other.edges)
-    {
-      assert(deviations(edge) > minValue);
+    const num* first = arena->getDeviations(begin);
 
-      if(deviations(edge) >= maxValue)
-      {
-        ++numHeavy;
-      }
-      else
-      {
-        edges.push_back(edge);
-      }
-    }
+    size = std::lower_bound(first, first + other.size, maxValue) - first;
+    numHeavy = other.numHeavy + (other.size - size);
   }
 
+  /**
+   * Computes a lower bound on the reduced costs of a path with
+   * respect to the given value by solving a fractional knapsack
+   * problem: The capacity is the difference between the costs of
+   * the paths at the boundaries of the interval, the weight of an
+   * Edge is its deviation (capped at the maximum value) minus the
+   * minimum value, its gain is its deviation (capped at the given
+   * value) minus the minimum value. Since the Edge%s are sorted by
+   * their deviations, they are sorted by decreasing benefit. The
+   * knapsack is therefore solved by two binary searches on the
+   * prefix sums of the weights.
+   **/
   num ActiveEdgeSet::getLowerBound(const num value) const
   {
     const num capacity = rightCost.getCost() - leftCost.getCost();
@@ -143,121 +140,63 @@ namespace
     assert(value <= maxValue);
     assert(value > minValue);
 
-    float totalWeight = 0;
-    float totalGain = 0;
+    const num* first = arena->getDeviations(begin);
 
-    auto gains = [&](const Edge& edge) -> num
-      {
-        return (std::min(deviations(edge), value) - minValue);
-      };
+    // the gains of the light edges equal their weights
+    const idx numLight = std::upper_bound(first, first + size, value) - first;
+    const int64_t lightWeight = getWeight(numLight);
 
-    auto weights = [&](const Edge& edge) -> num
-      {
-        return (std::min(deviations(edge), maxValue) - minValue);
-      };
-
-    /*
-    auto benefits = [&](const Edge& edge) -> float
-      {
-        return gains(edge) / ((float) weights(edge));
-      };
-    */
-
-    auto it = edges.begin();
-
-    for(; it != edges.end(); ++it)
+    if(lightWeight >= capacity)
     {
-      const Edge& edge = *it;
-      const num deviation = deviations(edge);
+      return leftCost.getCost();
+    }
 
-      assert(totalWeight <= capacity);
+    const num gain = value - minValue;
 
-      if(deviation <= value)
-      {
-        assert(weights(edge) <= maxValue);
-        assert(gains(edge) == deviation - minValue);
-        assert(weights(edge) == deviation - minValue);
+    double totalGain = lightWeight;
+    int64_t remainingWeight = capacity - lightWeight;
 
-        const num remainingWeight = capacity - totalWeight;
-        const num currentWeight = deviation - minValue;
+    // the largest number of edges fitting into the knapsack
+    idx low = numLight, high = size;
 
-        if(currentWeight <= remainingWeight)
-        {
-          totalGain += currentWeight;
-          totalWeight += currentWeight;
-        }
-        else
-        {
-          float weightFraction = remainingWeight / ((float) currentWeight);
-          assert(weightFraction < 1);
-
-          float weight = weightFraction * currentWeight;
-
-          totalWeight += weight;
-          totalGain += weight;
+    while(low < high)
+    {
+      const idx middle = low + (high - low + 1) / 2;
 
-          return rightCost.getCost() - totalGain;
-        }
+      if(getWeight(middle) - lightWeight <= remainingWeight)
+      {
+        low = middle;
       }
       else
       {
-        break;
+        high = middle - 1;
       }
     }
 
-    std::vector<Edge> nextEdges;
+    totalGain += ((double) (low - numLight)) * gain;
+    remainingWeight -= getWeight(low) - lightWeight;
 
-    for(; it != edges.end(); ++it)
-    {
-        if(debuggingEnabled())
-        {
-        num deviation = deviations(*it);
-        assert(deviation > value);
-        }
-      nextEdges.push_back(*it);
-    }
+    assert(remainingWeight >= 0);
 
-    for(const Edge& edge : nextEdges)
+    if(low < size)
     {
-      assert(totalWeight <= capacity);
-      const num currentWeight = weights(edge);
-      const num currentGain = gains(edge);
+      const num currentWeight = first[low] - minValue;
 
-      assert(currentGain < currentWeight);
+      assert(remainingWeight < currentWeight);
 
-      if(totalWeight + currentWeight <= capacity)
-      {
-        totalWeight += currentWeight;
-        totalGain += currentGain;
-      }
-      else
-      {
-        num remainingWeight = capacity - totalWeight;
-        float weightFraction = remainingWeight / ((float) currentWeight);
-
-        assert(weightFraction < 1);
-
-        totalWeight += weightFraction;
-        totalGain += weightFraction * currentGain;
-        break;
-      }
+      totalGain += (remainingWeight / ((double) currentWeight)) * gain;
     }
-
-
-    if(numHeavy > 0 and totalWeight < capacity)
+    else if(numHeavy > 0)
     {
-      num remainingWeight = capacity - totalWeight;
-      float currentWeight = maxValue - minValue;
-      num currentGain = (value - minValue);
-      num gain = std::min((float) numHeavy,
-                          remainingWeight / currentWeight) * currentGain;
+      const num currentWeight = maxValue - minValue;
 
-      assert(currentGain < currentWeight);
+      assert(gain <= currentWeight);
 
-      totalGain += gain;
+      totalGain += std::min((double) numHeavy,
+                            remainingWeight / ((double) currentWeight)) * gain;
     }
 
-    float boundValue = rightCost.getCost() - totalGain;
+    const double boundValue = rightCost.getCost() - totalGain;
 
     return boundValue;
   }
@@ -277,6 +216,7 @@ namespace
                    const ActiveEdgeSet& activeEdges);
 
     ActiveInterval(const ValueVector& values,
+                   ActiveEdgeArena& arena,
                    const EdgeFunc<num>& deviations,
                    PathCost leftPathCost,
                    PathCost rightPathCost,
@@ -302,6 +242,8 @@ namespace
     std::pair<ActiveInterval, ActiveInterval>
     split(ValueIterator middle,
           num value,
+          ActiveEdgeArena& arena,
+          const EdgeFunc<num>& deviations,
           const std::vector<Edge>& activeEdges);
   };
 
@@ -320,12 +262,14 @@ namespace
   }
 
   ActiveInterval::ActiveInterval(const ValueVector& values,
+                                 ActiveEdgeArena& arena,
                                  const EdgeFunc<num>& deviations,
                                  PathCost leftPathCost,
                                  PathCost rightPathCost,
                                  const std::vector<Edge>& edges)
     : range(ValueRange(values).innerRange()),
-      activeEdges(deviations,
+      activeEdges(arena,
+                  deviations,
                   edges,
                   leftPathCost,
                   rightPathCost),
@@ -345,6 +289,8 @@ namespace
   std::pair<ActiveInterval, ActiveInterval>
   ActiveInterval::split(ValueIterator middle,
                         num cost,
+                        ActiveEdgeArena& arena,
+                        const EdgeFunc<num>& deviations,
                         const std::vector<Edge>& nextEdges)
   {
     num value = *middle;
@@ -356,7 +302,8 @@ namespace
       ActiveInterval(ranges.first,
                      leftPathCost,
                      pathCost,
-                     ActiveEdgeSet(activeEdges.getDeviations(),
+                     ActiveEdgeSet(arena,
+                                   deviations,
                                    nextEdges,
                                    leftPathCost,
                                    pathCost)),
@@ -370,6 +317,38 @@ namespace
 
 }
 
+idx ActiveEdgeArena::add(const EdgeFunc<num>& deviationFunc,
+                         const std::vector<Edge>& edges,
+                         num minValue,
+                         num maxValue)
+{
+  const idx begin = deviations.size();
+
+  for(const Edge& edge : edges)
+  {
+    const num deviation = deviationFunc(edge);
+
+    assert(deviation > minValue);
+
+    if(deviation < maxValue)
+    {
+      deviations.push_back(deviation);
+    }
+  }
+
+  std::sort(deviations.begin() + begin, deviations.end());
+
+  int64_t sum = 0;
+
+  for(idx i = begin; i < deviations.size(); ++i)
+  {
+    sum += deviations[i];
+    sums.push_back(sum);
+  }
+
+  return begin;
+}
+
 ActiveRouter::ActiveRouter(const Graph& graph,
                            const EdgeFunc<num>& costs,
                            const EdgeFunc<num>& deviations,
@@ -425,6 +404,8 @@ RobustSearchResult ActiveRouter::shortestPath(Vertex source,
 
   std::queue<ActiveInterval> intervals;
 
+  arena.clear();
+
   num leftValue = *(possibleValues.begin());
 
   auto leftResult = findMaxShortestPath(source,target, leftValue);
@@ -437,6 +418,7 @@ RobustSearchResult ActiveRouter::shortestPath(Vertex source,
   PathCost rightPathCost(rightValue, getPathCost(rightResult.path, rightValue));
 
   ActiveInterval interval(possibleValues,
+                          arena,
                           deviations,
                           leftPathCost,
                           rightPathCost,
@@ -512,7 +494,8 @@ RobustSearchResult ActiveRouter::shortestPath(Vertex source,
           intervals.push(ActiveInterval(range,
                                         leftPathCost,
                                         interval.rightPathCost,
-                                        interval.getActiveEdges()));
+                                        ActiveEdgeSet(interval.getActiveEdges(),
+                                                      leftPathCost)));
         }
 
         {
@@ -539,7 +522,8 @@ RobustSearchResult ActiveRouter::shortestPath(Vertex source,
             intervals.push(ActiveInterval(range,
                                           interval.leftPathCost,
                                           rightPathCost,
-                                          ActiveEdgeSet(deviations,
+                                          ActiveEdgeSet(arena,
+                                                        deviations,
                                                         result.getActiveEdges(),
                                                         interval.leftPathCost,
                                                         rightPathCost)));
@@ -554,7 +538,11 @@ RobustSearchResult ActiveRouter::shortestPath(Vertex source,
       auto result = evaluate(*middle);
       num pathCost = getPathCost(result.path, *middle);
 
-      auto currentPair = interval.split(middle, pathCost, result.getActiveEdges());
+      auto currentPair = interval.split(middle,
+                                        pathCost,
+                                        arena,
+                                        deviations,
+                                        result.getActiveEdges());
 
       const ActiveInterval& leftInterval = currentPair.first;
 
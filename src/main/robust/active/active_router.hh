@@ -5,8 +5,65 @@
 #include "robust/robust_utils.hh"
 #include "robust/value_range.hh"
 
+/**
+ * The storage of the active Edge%s of the intervals processed
+ * during a query of an ActiveRouter. The deviations of the Edge%s
+ * of each interval are stored as a sorted block together with
+ * their prefix sums. Since the intervals derived from an interval
+ * only keep the Edge%s with the smallest deviations, they refer to
+ * prefixes of existing blocks rather than copying them. The storage
+ * is cleared (but not deallocated) at the beginning of each query.
+ **/
+class ActiveEdgeArena
+{
+private:
+  std::vector<num> deviations;
+  std::vector<int64_t> sums;
+
+public:
+  void clear()
+  {
+    deviations.clear();
+    sums.clear();
+  }
+
+  /**
+   * Adds a new block consisting of the deviations of the given
+   * Edge%s which are larger than the given minimum and smaller
+   * than the given maximum value.
+   *
+   * @return The beginning of the new block
+   **/
+  idx add(const EdgeFunc<num>& deviationFunc,
+          const std::vector<Edge>& edges,
+          num minValue,
+          num maxValue);
+
+  idx size() const
+  {
+    return deviations.size();
+  }
+
+  const num* getDeviations(idx begin) const
+  {
+    return deviations.data() + begin;
+  }
+
+  /**
+   * Returns the sum of the first given number of
+   * deviations of the block with the given beginning.
+   **/
+  int64_t getSum(idx begin, idx count) const
+  {
+    return (count == 0) ? 0 : sums[begin + count - 1];
+  }
+};
+
 class ActiveRouter : public RobustRouter
 {
+private:
+  ActiveEdgeArena arena;
+
 protected:
 
   class ActiveSearchResult : public SearchResult
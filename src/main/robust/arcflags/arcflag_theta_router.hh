@@ -20,6 +20,7 @@ private:
   const Partition& partition;
   const Flags& incomingFlags;
   const Flags& outgoingFlags;
+  bool concurrent;
 
   template <bool bounded>
   SearchResult findShortestPath(Vertex source,
@@ -30,6 +31,21 @@ private:
                                 num boundValue)
   {
     ReducedCosts reducedCosts(costs, deviations, value);
+
+    if(concurrent)
+    {
+      BidirectionalRouter router(graph);
+
+      return router.concurrentShortestPath<typename Flags::ThetaFilter,
+                                           typename Flags::ThetaFilter,
+                                           bounded>(source,
+                                                    target,
+                                                    reducedCosts,
+                                                    forwardFilter,
+                                                    backwardFilter,
+                                                    boundValue);
+    }
+
     int settled = 0, labeled = 0;
     bool found = false;
 
@@ -186,7 +202,8 @@ public:
       deviations(deviations),
       partition(partition),
       incomingFlags(flags.get(Direction::INCOMING)),
-      outgoingFlags(flags.get(Direction::OUTGOING))
+      outgoingFlags(flags.get(Direction::OUTGOING)),
+      concurrent(false)
   {}
 
   ArcFlagThetaRouter(const Graph& graph,
@@ -200,9 +217,24 @@ public:
       deviations(deviations),
       partition(partition),
       incomingFlags(incomingFlags),
-      outgoingFlags(outgoingFlags)
+      outgoingFlags(outgoingFlags),
+      concurrent(false)
   {}
 
+  /**
+   * Returns whether the forward and backward searches are
+   * run concurrently. @see BidirectionalRouter::concurrentShortestPath
+   **/
+  bool isConcurrent() const
+  {
+    return concurrent;
+  }
+
+  void setConcurrent(bool value)
+  {
+    concurrent = value;
+  }
+
 
   virtual SearchResult shortestPath(Vertex source,
                                     Vertex target,
@@ -210,6 +242,7 @@ public:
                                     num bound) override
   {
     BidirectionalRouter router(graph);
+    router.setConcurrent(concurrent);
 
     const Region& sourceRegion = partition.getRegion(source);
     const Region& targetRegion = partition.getRegion(target);
@@ -253,6 +286,7 @@ public:
     if(sourceRegion == targetRegion)
     {
       BidirectionalRouter router(graph);
+      router.setConcurrent(concurrent);
 
       return router.shortestPath<AllEdgeFilter,
                                  AllEdgeFilter,
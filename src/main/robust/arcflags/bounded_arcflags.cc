@@ -74,3 +74,8 @@ bool BoundedArcFlags::filter(const Edge& edge,
 
   return true;
 }
+
+MemoryUsage BoundedArcFlags::memoryUsage() const
+{
+  return MemoryUsage("BoundedArcFlags").add(flagMaps.memoryUsage("flags"));
+}
@@ -62,6 +62,13 @@ public:
   bool filter(const Edge& edge,
               const Region& region,
               num theta) const override;
+
+  MemoryUsage memoryUsage() const override;
 };
 
+inline std::size_t heapUsage(const BoundedArcFlags::BoundedFlagMap& flagMap)
+{
+  return heapUsage(flagMap.flags);
+}
+
 #endif /* BOUNDED_ARCFLAGS_HH */
@@ -55,3 +55,8 @@ bool ExtendedArcFlags::filter(const Edge& edge,
 
   return true;
 }
+
+MemoryUsage ExtendedArcFlags::memoryUsage() const
+{
+  return MemoryUsage("ExtendedArcFlags").add(entryMap.memoryUsage("entries"));
+}
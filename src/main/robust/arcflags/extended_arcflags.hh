@@ -51,6 +51,8 @@ public:
   bool filter(const Edge& edge,
               const Region& region,
               num theta) const override;
+
+  MemoryUsage memoryUsage() const override;
 };
 
 #endif /* EXTENDED_ARCFLAGS_HH */
@@ -447,8 +447,6 @@ void FastArcFlagPreprocessor::computeFlags(RobustArcFlags& incomingFlags,
                                            idx numTrees,
                                            bool parallelComputation) const
 {
-  std::vector<Edge> overlappingEdges;
-
   Log(info) << "Computing arc flags for " << values.size()
             << " values using " << numTrees
             << " trees [parallel = "
@@ -456,35 +454,26 @@ void FastArcFlagPreprocessor::computeFlags(RobustArcFlags& incomingFlags,
             << parallelComputation
             << "]";
 
-  for(const Edge& edge : graph.getEdges())
+  for(const Region& region : partition.getRegions())
   {
-    const Region& sourceRegion = partition.getRegion(edge.getSource());
-    const Region& targetRegion = partition.getRegion(edge.getTarget());
-
-    if(sourceRegion == targetRegion)
+    for(const Edge& edge : partition.internalEdges(region))
     {
       incomingFlags.extend(edge,
-                           targetRegion);
+                           region);
 
       outgoingFlags.extend(edge,
-                           sourceRegion);
-    }
-    else
-    {
-      overlappingEdges.push_back(edge);
+                           region);
     }
   }
 
-  Log(info) << "Found " << overlappingEdges.size()
+  Log(info) << "Found " << partition.boundaryEdges<Direction::OUTGOING>().size()
             << " overlapping edges";
 
-  std::unordered_set<Vertex> sourceVertices, targetVertices;
+  const ArrayRange<Vertex> sourceVertices =
+    partition.boundaryVertices<Direction::OUTGOING>();
 
-  for(const Edge& edge : overlappingEdges)
-  {
-    sourceVertices.insert(edge.getSource());
-    targetVertices.insert(edge.getTarget());
-  }
+  const ArrayRange<Vertex> targetVertices =
+    partition.boundaryVertices<Direction::INCOMING>();
 
   if(parallelComputation)
   {
@@ -0,0 +1,308 @@
+#include "incremental_tree.hh"
+
+#include <algorithm>
+#include <functional>
+
+template <Direction direction>
+IncrementalTree<direction>::IncrementalTree(const Graph& graph,
+                                            const Partition& partition,
+                                            const EdgeFunc<num>& costs,
+                                            const EdgeFunc<num>& deviations,
+                                            Vertex root,
+                                            num value,
+                                            double maxFrontier)
+  : graph(graph),
+    partition(partition),
+    costs(costs),
+    deviations(deviations),
+    root(root),
+    value(value),
+    maxFrontier(maxFrontier),
+    nodes(graph, Node())
+{
+  recomputeTree();
+}
+
+template <Direction direction>
+void IncrementalTree<direction>::attach(Vertex vertex, const Edge& edge)
+{
+  assert(vertex == edge.getEndpoint(direction));
+
+  Node& node = nodes(vertex);
+  Node& parentNode = nodes(edge.getEndpoint(opposite(direction)));
+
+  node.setParent(edge);
+  node.previousSibling = None;
+  node.nextSibling = parentNode.firstChild;
+
+  if(parentNode.firstChild != None)
+  {
+    nodes(Vertex(parentNode.firstChild)).previousSibling = vertex.getIndex();
+  }
+
+  parentNode.firstChild = vertex.getIndex();
+}
+
+template <Direction direction>
+void IncrementalTree<direction>::detach(Vertex vertex)
+{
+  Node& node = nodes(vertex);
+
+  if(node.previousSibling != None)
+  {
+    nodes(Vertex(node.previousSibling)).nextSibling = node.nextSibling;
+  }
+  else
+  {
+    Node& parentNode = nodes(node.getParent().getEndpoint(opposite(direction)));
+    assert(parentNode.firstChild == vertex.getIndex());
+    parentNode.firstChild = node.nextSibling;
+  }
+
+  if(node.nextSibling != None)
+  {
+    nodes(Vertex(node.nextSibling)).previousSibling = node.previousSibling;
+  }
+
+  node.nextSibling = None;
+  node.previousSibling = None;
+}
+
+template <Direction direction>
+void IncrementalTree<direction>::push(num distance, Vertex vertex)
+{
+  heap.push_back(Entry(distance, vertex.getIndex()));
+  std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+}
+
+template <Direction direction>
+typename IncrementalTree<direction>::Entry IncrementalTree<direction>::pop()
+{
+  std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+  const Entry entry = heap.back();
+  heap.pop_back();
+  return entry;
+}
+
+template <Direction direction>
+void IncrementalTree<direction>::relax(const Edge& edge,
+                                       const EdgeFunc<num>& reducedCosts)
+{
+  const Vertex head = edge.getEndpoint(direction);
+  Node& headNode = nodes(head);
+
+  const num distance =
+    nodes(edge.getEndpoint(opposite(direction))).getDistance() + reducedCosts(edge);
+
+  if(distance >= headNode.getDistance())
+  {
+    return;
+  }
+
+  if(headNode.getDistance() != inf)
+  {
+    detach(head);
+  }
+
+  attach(head, edge);
+  headNode.setDistance(distance);
+
+  push(distance, head);
+}
+
+template <Direction direction>
+void IncrementalTree<direction>::recomputeTree()
+{
+  for(const Vertex& vertex : vertices)
+  {
+    nodes(vertex) = Node();
+  }
+
+  nodes(root) = Node();
+
+  vertices.clear();
+  heap.clear();
+
+  ReducedCosts reducedCosts(costs, deviations, value);
+
+  nodes(root).setDistance(0);
+  push(0, root);
+
+  while(!heap.empty())
+  {
+    const Entry entry = pop();
+    const Vertex vertex(entry.second);
+
+    if(entry.first != nodes(vertex).getDistance())
+    {
+      continue;
+    }
+
+    if(vertex != root)
+    {
+      vertices.push_back(vertex);
+    }
+
+    if(!expands(vertex))
+    {
+      continue;
+    }
+
+    for(const Edge& edge : graph.getEdges(vertex, direction))
+    {
+      relax(edge, reducedCosts);
+    }
+  }
+}
+
+template <Direction direction>
+bool IncrementalTree<direction>::repairTree()
+{
+  ReducedCosts reducedCosts(costs, deviations, value);
+
+  // propagate the decreased costs along the old tree
+  queue.clear();
+  queue.push_back(root);
+
+  for(idx i = 0; i < queue.size(); ++i)
+  {
+    const Vertex current = queue[i];
+    const num distance = nodes(current).getDistance();
+
+    for(idx child = nodes(current).firstChild;
+        child != None;
+        child = nodes(Vertex(child)).nextSibling)
+    {
+      Node& childNode = nodes(Vertex(child));
+
+      childNode.setDistance(distance + reducedCosts(childNode.getParent()));
+
+      queue.push_back(Vertex(child));
+    }
+  }
+
+  assert(queue.size() == vertices.size() + 1);
+
+  // queue the vertices whose distances decrease further...
+  heap.clear();
+
+  for(const Vertex& vertex : queue)
+  {
+    if(!expands(vertex))
+    {
+      continue;
+    }
+
+    for(const Edge& edge : graph.getEdges(vertex, direction))
+    {
+      relax(edge, reducedCosts);
+    }
+  }
+
+  // ...and rescan them until the frontier grows too large
+  const idx maxScanned = maxFrontier * vertices.size();
+  idx scanned = 0;
+
+  while(!heap.empty())
+  {
+    const Entry entry = pop();
+    const Vertex vertex(entry.second);
+
+    if(entry.first != nodes(vertex).getDistance())
+    {
+      continue;
+    }
+
+    if(++scanned > maxScanned)
+    {
+      return false;
+    }
+
+    if(!expands(vertex))
+    {
+      continue;
+    }
+
+    for(const Edge& edge : graph.getEdges(vertex, direction))
+    {
+      relax(edge, reducedCosts);
+    }
+  }
+
+  return true;
+}
+
+template <Direction direction>
+bool IncrementalTree<direction>::reset(num newValue)
+{
+  if(newValue == value)
+  {
+    return true;
+  }
+
+  const bool increasing = newValue > value;
+
+  value = newValue;
+
+  if(increasing and repairTree())
+  {
+    assert(check());
+    return true;
+  }
+
+  recomputeTree();
+
+  assert(check());
+
+  return false;
+}
+
+template <Direction direction>
+bool IncrementalTree<direction>::check() const
+{
+  ReducedCosts reducedCosts(costs, deviations, value);
+
+  if(getDistance(root) != 0)
+  {
+    return false;
+  }
+
+  for(const Vertex& vertex : vertices)
+  {
+    const Edge& parent = getParent(vertex);
+    const Vertex tail = parent.getEndpoint(opposite(direction));
+
+    if(parent.getEndpoint(direction) != vertex or !isReached(tail))
+    {
+      return false;
+    }
+
+    if(getDistance(vertex) != getDistance(tail) + reducedCosts(parent))
+    {
+      return false;
+    }
+  }
+
+  for(const Vertex& vertex : graph.getVertices())
+  {
+    if(!isReached(vertex) or !expands(vertex))
+    {
+      continue;
+    }
+
+    for(const Edge& edge : graph.getEdges(vertex, direction))
+    {
+      const Vertex head = edge.getEndpoint(direction);
+
+      if(getDistance(vertex) + reducedCosts(edge) < getDistance(head))
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+template class IncrementalTree<Direction::OUTGOING>;
+template class IncrementalTree<Direction::INCOMING>;
@@ -0,0 +1,172 @@
+#ifndef INCREMENTAL_TREE_HH
+#define INCREMENTAL_TREE_HH
+
+#include "graph/graph.hh"
+#include "graph/edge_map.hh"
+#include "graph/vertex_map.hh"
+
+#include "arcflags/partition.hh"
+
+#include "robust/reduced_costs.hh"
+
+/**
+ * The outgoing / incoming shortest path tree of a boundary Vertex
+ * with respect to ReducedCosts as used during the computation of
+ * robust arc flags: The Vertex%s inside the Region of the root
+ * are reached, but not expanded.
+ *
+ * Similar to the ThetaTree, the tree can be reset to a greater
+ * value of \f$ \theta \f$, which can only decrease the reduced
+ * costs. The distances are then propagated along the old tree and
+ * only the Vertex%s whose distances actually decrease are rescanned.
+ * If the number of rescanned Vertex%s exceeds the given fraction
+ * of the reached Vertex%s, the repair is abandoned in favor of
+ * a recomputation from scratch. Resetting the tree to a smaller
+ * value always triggers a recomputation.
+ **/
+template <Direction direction>
+class IncrementalTree
+{
+private:
+  static const idx None = -1;
+
+  class Node
+  {
+  private:
+    Edge parent;
+    num distance;
+
+  public:
+    idx firstChild;
+    idx nextSibling;
+    idx previousSibling;
+
+    Node()
+      : distance(inf),
+        firstChild(None),
+        nextSibling(None),
+        previousSibling(None)
+    {}
+
+    num getDistance() const
+    {
+      return distance;
+    }
+
+    void setDistance(num value)
+    {
+      distance = value;
+    }
+
+    const Edge& getParent() const
+    {
+      return parent;
+    }
+
+    void setParent(const Edge& value)
+    {
+      parent = value;
+    }
+  };
+
+  typedef std::pair<num, idx> Entry;
+
+  const Graph& graph;
+  const Partition& partition;
+  const EdgeFunc<num>& costs;
+  const EdgeFunc<num>& deviations;
+  Vertex root;
+  num value;
+  double maxFrontier;
+
+  VertexMap<Node> nodes;
+
+  // the reached vertices except for the root
+  std::vector<Vertex> vertices;
+
+  // buffers kept in between resets
+  std::vector<Vertex> queue;
+  std::vector<Entry> heap;
+
+  bool expands(Vertex vertex) const
+  {
+    return vertex == root or
+      partition.getRegion(vertex) != partition.getRegion(root);
+  }
+
+  void attach(Vertex vertex, const Edge& edge);
+
+  void detach(Vertex vertex);
+
+  void push(num distance, Vertex vertex);
+
+  Entry pop();
+
+  /**
+   * Attaches the head of the given Edge to its tail and
+   * queues it if the Edge yields a shorter distance.
+   **/
+  void relax(const Edge& edge, const EdgeFunc<num>& reducedCosts);
+
+  void recomputeTree();
+
+  bool repairTree();
+
+  bool check() const;
+
+public:
+  IncrementalTree(const Graph& graph,
+                  const Partition& partition,
+                  const EdgeFunc<num>& costs,
+                  const EdgeFunc<num>& deviations,
+                  Vertex root,
+                  num value,
+                  double maxFrontier = 0.5);
+
+  Vertex getRoot() const
+  {
+    return root;
+  }
+
+  num getValue() const
+  {
+    return value;
+  }
+
+  num getDistance(Vertex vertex) const
+  {
+    return nodes(vertex).getDistance();
+  }
+
+  bool isReached(Vertex vertex) const
+  {
+    return getDistance(vertex) != inf;
+  }
+
+  /**
+   * Returns the Edge connecting the given reached
+   * Vertex (other than the root) to its parent.
+   **/
+  const Edge& getParent(Vertex vertex) const
+  {
+    return nodes(vertex).getParent();
+  }
+
+  /**
+   * Returns the reached Vertex%s except for the root.
+   **/
+  const std::vector<Vertex>& getVertices() const
+  {
+    return vertices;
+  }
+
+  /**
+   * Resets the tree to the given value.
+   *
+   * @return whether the tree was repaired
+   *         rather than recomputed
+   **/
+  bool reset(num newValue);
+};
+
+#endif /* INCREMENTAL_TREE_HH */
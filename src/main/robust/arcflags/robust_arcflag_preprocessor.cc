@@ -1,7 +1,5 @@
 #include "robust_arcflag_preprocessor.hh"
 
-#include <unordered_set>
-
 #include <tbb/tbb.h>
 
 #include "log.hh"
@@ -12,11 +10,14 @@
 #include "robust/reduced_costs.hh"
 #include "robust/robust_utils.hh"
 
+#include "incremental_tree.hh"
+
 RobustArcFlagPreprocessor::RobustArcFlagPreprocessor(const Graph& graph,
                                                      const EdgeFunc<num>& costs,
                                                      const EdgeFunc<num>& deviations,
                                                      const Partition& partition)
-  : AbstractArcFlagPreprocessor(graph, costs, deviations, partition)
+  : AbstractArcFlagPreprocessor(graph, costs, deviations, partition),
+    incremental(false)
 {
 }
 
@@ -25,8 +26,38 @@ RobustArcFlagPreprocessor::RobustArcFlagPreprocessor(const Graph& graph,
                                                      const EdgeFunc<num>& deviations,
                                                      const Partition& partition,
                                                      const ValueVector& values)
-  : AbstractArcFlagPreprocessor(graph, costs, deviations, partition, values)
+  : AbstractArcFlagPreprocessor(graph, costs, deviations, partition, values),
+    incremental(false)
+{
+}
+
+template<Direction direction, class Func>
+void RobustArcFlagPreprocessor::computeTrees(const Vertex& vertex,
+                                             Func func) const
 {
+  if(values.empty())
+  {
+    return;
+  }
+
+  IncrementalTree<direction> tree(graph,
+                                  partition,
+                                  costs,
+                                  deviations,
+                                  vertex,
+                                  *values.rbegin());
+
+  for(auto it = values.rbegin(); it != values.rend(); ++it)
+  {
+    const num value = *it;
+
+    tree.reset(value);
+
+    for(const Vertex& current : tree.getVertices())
+    {
+      func(tree.getParent(current), value);
+    }
+  }
 }
 
 template<Direction direction>
@@ -35,6 +66,19 @@ void RobustArcFlagPreprocessor::computeFlags(const Vertex& vertex,
 {
   const Region& region = partition.getRegion(vertex);
 
+  if(incremental)
+  {
+    computeTrees<direction>(vertex,
+                            [&](const Edge& edge, num value)
+                            {
+                              flags.extend(edge, region, value);
+
+                              assert(flags.filter(edge, region, value));
+                            });
+
+    return;
+  }
+
   for(const num& value : values)
   {
     ReducedCosts reducedCosts(costs, deviations, value);
@@ -74,7 +118,7 @@ void RobustArcFlagPreprocessor::computeFlags(const Vertex& vertex,
 }
 
 template <Direction direction>
-void RobustArcFlagPreprocessor::computeFlagsParallel(const std::unordered_set<Vertex>& vertices,
+void RobustArcFlagPreprocessor::computeFlagsParallel(const ArrayRange<Vertex>& vertices,
                                                      RobustArcFlags& flags) const
 {
   tbb::spin_mutex mutex;
@@ -88,46 +132,61 @@ void RobustArcFlagPreprocessor::computeFlagsParallel(const std::unordered_set<Ve
 
                      const Region& vertexRegion = partition.getRegion(vertex);
 
-                     for(auto it = values.rbegin(); it != values.rend(); ++it)
+                     if(incremental)
                      {
-                       num value = *it;
-                       ReducedCosts reducedCosts(costs, deviations, value);
-
-                       LabelHeap<Label> heap(graph);
-                       heap.update(Label(vertex, Edge(), 0));
-
-                       while(!heap.isEmpty())
+                       computeTrees<direction>(vertex,
+                                               [&](const Edge& edge, num value)
+                                               {
+                                                 lowerBound(edge) = std::min(lowerBound(edge),
+                                                                             value);
+
+                                                 upperBound(edge) = std::max(upperBound(edge),
+                                                                             value);
+                                               });
+                     }
+                     else
+                     {
+                       for(auto it = values.rbegin(); it != values.rend(); ++it)
                        {
-                         const Label& current = heap.extractMin();
-                         Vertex currentVertex = current.getVertex();
+                         num value = *it;
+                         ReducedCosts reducedCosts(costs, deviations, value);
+
+                         LabelHeap<Label> heap(graph);
+                         heap.update(Label(vertex, Edge(), 0));
 
-                         if(current.getVertex() != vertex)
+                         while(!heap.isEmpty())
                          {
-                           const Edge& edge = current.getEdge();
+                           const Label& current = heap.extractMin();
+                           Vertex currentVertex = current.getVertex();
 
-                           lowerBound(edge) = std::min(lowerBound(edge),
-                                                       value);
+                           if(current.getVertex() != vertex)
+                           {
+                             const Edge& edge = current.getEdge();
 
-                           upperBound(edge) = std::max(upperBound(edge),
-                                                       value);
+                             lowerBound(edge) = std::min(lowerBound(edge),
+                                                         value);
 
-                           if(vertexRegion ==
-                              partition.getRegion(current.getVertex()))
-                           {
-                             continue;
+                             upperBound(edge) = std::max(upperBound(edge),
+                                                         value);
+
+                             if(vertexRegion ==
+                                partition.getRegion(current.getVertex()))
+                             {
+                               continue;
+                             }
                            }
-                         }
 
-                         for(const Edge& edge : graph.getEdges(currentVertex,
-                                                               direction))
-                         {
-                           Vertex nextVertex = edge.getEndpoint(direction);
-                           const num nextCost = current.getCost() +
-                             reducedCosts(edge);
+                           for(const Edge& edge : graph.getEdges(currentVertex,
+                                                                 direction))
+                           {
+                             Vertex nextVertex = edge.getEndpoint(direction);
+                             const num nextCost = current.getCost() +
+                               reducedCosts(edge);
 
-                           Label nextLabel = Label(nextVertex, edge, nextCost);
+                             Label nextLabel = Label(nextVertex, edge, nextCost);
 
-                           heap.update(nextLabel);
+                             heap.update(nextLabel);
+                           }
                          }
                        }
                      }
@@ -154,52 +213,40 @@ void RobustArcFlagPreprocessor::computeFlags(RobustArcFlags& incomingFlags,
                                              RobustArcFlags& outgoingFlags,
                                              bool parallelComputation) const
 {
-  std::vector<Edge> overlappingEdges;
-
   Log(info) << "Computing arc flags for " << values.size()
             << " values [parallel = "
             << std::boolalpha
             << parallelComputation
+            << ", incremental = "
+            << incremental
             << "]";
 
-  for(const Edge& edge : graph.getEdges())
+  for(const Region& region : partition.getRegions())
   {
-    const Region& sourceRegion = partition.getRegion(edge.getSource());
-    const Region& targetRegion = partition.getRegion(edge.getTarget());
-
-    if(sourceRegion == targetRegion)
+    for(const Edge& edge : partition.internalEdges(region))
     {
-      incomingFlags.extend(edge,
-                           targetRegion);
-
-      outgoingFlags.extend(edge,
-                           sourceRegion);
+      incomingFlags.extend(edge, region);
+      outgoingFlags.extend(edge, region);
 
       if(debuggingEnabled())
       {
         for(const num& value : values)
         {
-          assert(incomingFlags.filter(edge, targetRegion, value));
-          assert(outgoingFlags.filter(edge, sourceRegion, value));
+          assert(incomingFlags.filter(edge, region, value));
+          assert(outgoingFlags.filter(edge, region, value));
         }
       }
     }
-    else
-    {
-      overlappingEdges.push_back(edge);
-    }
   }
 
-  Log(info) << "Found " << overlappingEdges.size()
+  Log(info) << "Found " << partition.boundaryEdges<Direction::OUTGOING>().size()
             << " overlapping edges";
 
-  std::unordered_set<Vertex> sourceVertices, targetVertices;
+  const ArrayRange<Vertex> sourceVertices =
+    partition.boundaryVertices<Direction::OUTGOING>();
 
-  for(const Edge& edge : overlappingEdges)
-  {
-    sourceVertices.insert(edge.getSource());
-    targetVertices.insert(edge.getTarget());
-  }
+  const ArrayRange<Vertex> targetVertices =
+    partition.boundaryVertices<Direction::INCOMING>();
 
   if(parallelComputation)
   {
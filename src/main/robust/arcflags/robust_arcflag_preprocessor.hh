@@ -1,8 +1,6 @@
 #ifndef ROBUST_ARCFLAG_PREPROCESSOR_HH
 #define ROBUST_ARCFLAG_PREPROCESSOR_HH
 
-#include <unordered_set>
-
 #include "graph/graph.hh"
 #include "graph/edge_map.hh"
 
@@ -16,18 +14,29 @@
  * by determining the outgoing / incoming trees of the boundary
  * vertices of the Region%s of a given Partition for all
  * values of \f$ \theta \f$ one after another. The process
- * can be parallelized.
+ * can be parallelized. In incremental mode, the values are
+ * processed in ascending order, repairing the tree
+ * of the previous value.
  **/
 class RobustArcFlagPreprocessor : public AbstractArcFlagPreprocessor
 {
 private:
+  bool incremental;
 
   template <Direction direction>
   void computeFlags(const Vertex& vertex,
                     RobustArcFlags& flags) const;
 
+  /**
+   * Computes the IncrementalTree of the given Vertex for all
+   * values in ascending order, applying the given function
+   * to each tree Edge and the respective value.
+   **/
+  template <Direction direction, class Func>
+  void computeTrees(const Vertex& vertex, Func func) const;
+
   template <Direction direction>
-  void computeFlagsParallel(const std::unordered_set<Vertex>& vertices,
+  void computeFlagsParallel(const ArrayRange<Vertex>& vertices,
                             RobustArcFlags& flags) const;
 
 public:
@@ -42,6 +51,21 @@ public:
                             const Partition& partition,
                             const ValueVector& values);
 
+  /**
+   * Sets whether the tree of each boundary Vertex is repaired
+   * when moving from one value to the next (see IncrementalTree)
+   * rather than being recomputed from scratch.
+   **/
+  void setIncremental(bool value)
+  {
+    incremental = value;
+  }
+
+  bool isIncremental() const
+  {
+    return incremental;
+  }
+
   void computeFlags(RobustArcFlags& incomingFlags,
                     RobustArcFlags& outgoingFlags,
                     bool parallelComputation) const;
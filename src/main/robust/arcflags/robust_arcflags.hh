@@ -57,6 +57,11 @@ public:
                       const Region& region,
                       num value) const = 0;
 
+  /**
+   * Returns the memory used by the arc flags.
+   **/
+  virtual MemoryUsage memoryUsage() const = 0;
+
   /**
    * A filter which is used in the RobustArcFlagRouter.
    **/
@@ -36,3 +36,8 @@ bool SimpleArcFlags::filter(const Edge& edge,
 {
   return hasFlag(edge, region);
 }
+
+MemoryUsage SimpleArcFlags::memoryUsage() const
+{
+  return ArcFlags::memoryUsage("SimpleArcFlags");
+}
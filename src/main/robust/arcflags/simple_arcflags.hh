@@ -39,6 +39,8 @@ public:
   bool filter(const Edge& edge,
               const Region& region,
               num theta) const override;
+
+  MemoryUsage memoryUsage() const override;
 };
 
 
@@ -1,8 +1,5 @@
 #include "fast_robust_witness_path_search.hh"
 
-#include "router/label.hh"
-#include "router/label_heap.hh"
-
 #include "robust_search_predicate.hh"
 
 class SearchData
@@ -47,69 +44,26 @@ public:
 
 };
 
-template <Direction direction, class Predicate>
-Path searchPath(const Graph& graph,
-                Vertex source,
-                Vertex target,
-                num upperBound,
-                const Predicate& predicate,
-                const EdgeFunc<num>& costs,
-                LabelHeap<Label>& labelHeap)
+std::vector<RobustContractionPair>
+FastRobustWitnessPathSearch::findPairs(Vertex vertex) const
 {
-  while(true)
+  if(core)
   {
-    const Label& targetLabel = labelHeap.getLabel(target);
-
-    if(targetLabel.getState() != State::UNKNOWN)
-    {
-      if(targetLabel.getCost() <= upperBound)
-      {
-        Path path;
-        Label current = targetLabel;
-
-        while(current.getVertex() != source)
-        {
-          Edge edge = current.getEdge();
-          path.add(edge, opposite(direction));
-          current = labelHeap.getLabel(edge.getEndpoint(opposite(direction)));
-        }
-
-        return path;
-      }
-    }
-
-    if(labelHeap.isEmpty() or
-       labelHeap.peek().getCost() > upperBound)
-    {
-      break;
-    }
+    assert(core->contains(vertex));
 
-    const Label& currentLabel = labelHeap.extractMin();
-    Vertex currentVertex = currentLabel.getVertex();
-
-    for(const Edge& outEdge : graph.getEdges(currentVertex,
-                                             direction))
-    {
-      if(!predicate(outEdge))
-      {
-        continue;
-      }
-
-      Vertex nextVertex = outEdge.getEndpoint(direction);
-      num nextCost = currentLabel.getCost() + costs(outEdge);
-
-      labelHeap.update(Label(nextVertex, outEdge, nextCost));
-    }
+    return findPairs(vertex, *core);
   }
 
-  return Path();
+  return findPairs(vertex, graph);
 }
 
+template <class Adjacency>
 std::vector<RobustContractionPair>
-FastRobustWitnessPathSearch::findPairs(Vertex vertex) const
+FastRobustWitnessPathSearch::findPairs(Vertex vertex,
+                                       const Adjacency& adjacency) const
 {
-  const std::vector<Edge>& incoming = graph.getIncoming(vertex);
-  const std::vector<Edge>& outgoing = graph.getOutgoing(vertex);
+  const auto& incoming = adjacency.getIncoming(vertex);
+  const auto& outgoing = adjacency.getOutgoing(vertex);
 
   std::vector<Edge> actualIncoming, actualOutgoing;
 
@@ -148,6 +102,7 @@ FastRobustWitnessPathSearch::findPairs(Vertex vertex) const
       findPairs<Direction::OUTGOING>(vertex,
                                      incomingEdge,
                                      actualOutgoing,
+                                     adjacency,
                                      std::back_inserter(pairs));
     }
   }
@@ -159,6 +114,7 @@ FastRobustWitnessPathSearch::findPairs(Vertex vertex) const
       findPairs<Direction::INCOMING>(vertex,
                                      outgoingEdge,
                                      actualIncoming,
+                                     adjacency,
                                      std::back_inserter(pairs));
     }
   }
@@ -167,10 +123,11 @@ FastRobustWitnessPathSearch::findPairs(Vertex vertex) const
 }
 
 
-template <Direction direction, class OutIt>
+template <Direction direction, class Adjacency, class OutIt>
 void FastRobustWitnessPathSearch::findPairs(const Vertex vertex,
                                             const Edge edge,
                                             const std::vector<Edge>& edges,
+                                            const Adjacency& adjacency,
                                             OutIt outIt) const
 {
   ValueIterator begin = values.end(),
@@ -234,8 +191,8 @@ void FastRobustWitnessPathSearch::findPairs(const Vertex vertex,
     RobustSearchPredicate predicate(contracted, contractionRanges, vertex, value);
     ReducedContractionCosts costs(contractionRanges, value);
 
-    LabelHeap<Label> labelHeap(graph);
-    labelHeap.update(Label(source, Edge(), 0));
+    WitnessSearch& search = searches.local();
+    search.start(source);
 
     for(SearchData& currentData : searchData)
     {
@@ -268,17 +225,13 @@ void FastRobustWitnessPathSearch::findPairs(const Vertex vertex,
 
       assert(target != source);
 
-      Path path = searchPath<direction, RobustSearchPredicate>(graph,
-                                                               source,
-                                                               target,
-                                                               upperBound,
-                                                               predicate,
-                                                               costs,
-                                                               labelHeap);
-
-      if(path)
+      if(search.search<direction>(target,
+                                  upperBound,
+                                  predicate,
+                                  costs,
+                                  adjacency))
       {
-        lastPath = path;
+        lastPath = search.getPath<direction>(target);
         nextData.push_back(currentData);
       }
       else
@@ -313,8 +266,8 @@ void FastRobustWitnessPathSearch::findPairs(const Vertex vertex,
     RobustSearchPredicate predicate(contracted, contractionRanges, vertex, value);
     ReducedContractionCosts costs(contractionRanges, value);
 
-    LabelHeap<Label> labelHeap(graph);
-    labelHeap.update(Label(source, Edge(), 0));
+    WitnessSearch& search = searches.local();
+    search.start(source);
 
     for(SearchData& currentData : failedData)
     {
@@ -341,17 +294,13 @@ void FastRobustWitnessPathSearch::findPairs(const Vertex vertex,
 
       const Vertex target = defaultPath.getEndpoint(direction);
 
-      Path path = searchPath<direction, RobustSearchPredicate>(graph,
-                                                               source,
-                                                               target,
-                                                               upperBound,
-                                                               predicate,
-                                                               costs,
-                                                               labelHeap);
-
-      if(path)
+      if(search.search<direction>(target,
+                                  upperBound,
+                                  predicate,
+                                  costs,
+                                  adjacency))
       {
-        lastPath = path;
+        lastPath = search.getPath<direction>(target);
         nextData.push_back(currentData);
       }
       else
@@ -1,26 +1,77 @@
 #ifndef FAST_ROBUST_WITNESS_PATH_SEARCH_HH
 #define FAST_ROBUST_WITNESS_PATH_SEARCH_HH
 
+#include <tbb/enumerable_thread_specific.h>
+
+#include "contraction/contraction_graph.hh"
+#include "contraction/witness_search.hh"
+
 #include "robust_witness_path_search.hh"
 #include "robust_contraction_preprocessor.hh"
 
+/**
+ * A RobustWitnessPathSearch which computes partial shortest
+ * path trees from each neighbor, sweeping through the values
+ * and reusing witness paths as long as they remain valid.
+ * Each thread uses its own WitnessSearch workspace. If a
+ * ContractionGraph is given, the searches only scan the
+ * remaining core.
+ **/
 class FastRobustWitnessPathSearch : public RobustWitnessPathSearch
 {
 private:
-  template <Direction direction, class OutIt>
+  mutable tbb::enumerable_thread_specific<WitnessSearch> searches;
+
+  const ContractionGraph* core;
+
+  template <class Adjacency>
+  std::vector<RobustContractionPair> findPairs(Vertex vertex,
+                                               const Adjacency& adjacency) const;
+
+  template <Direction direction, class Adjacency, class OutIt>
   void findPairs(const Vertex vertex,
                  const Edge edge,
                  const std::vector<Edge>& edges,
+                 const Adjacency& adjacency,
                  OutIt outIt) const;
 
 public:
   FastRobustWitnessPathSearch(const Graph& graph,
                               const EdgeFunc<const ContractionRange&>& contractionRanges,
                               const ValueVector& values,
-                              const VertexFunc<bool>& contracted)
-    : RobustWitnessPathSearch(graph, contractionRanges, values, contracted)
+                              const VertexFunc<bool>& contracted,
+                              idx settleLimit = 0,
+                              idx hopLimit = 0)
+    : RobustWitnessPathSearch(graph, contractionRanges, values, contracted),
+      searches([&graph, settleLimit, hopLimit]()
+               {
+                 return WitnessSearch(graph, settleLimit, hopLimit);
+               }),
+      core(nullptr)
   {}
 
+  /**
+   * Constructs a new FastRobustWitnessPathSearch operating on the
+   * given ContractionGraph, which must be kept in sync with the
+   * contracted vertices.
+   **/
+  FastRobustWitnessPathSearch(const Graph& graph,
+                              const EdgeFunc<const ContractionRange&>& contractionRanges,
+                              const ValueVector& values,
+                              const VertexFunc<bool>& contracted,
+                              const ContractionGraph& core,
+                              idx settleLimit = 0,
+                              idx hopLimit = 0)
+    : FastRobustWitnessPathSearch(graph,
+                                  contractionRanges,
+                                  values,
+                                  contracted,
+                                  settleLimit,
+                                  hopLimit)
+  {
+    this->core = &core;
+  }
+
   virtual std::vector<RobustContractionPair> findPairs(Vertex vertex) const override;
 };
 
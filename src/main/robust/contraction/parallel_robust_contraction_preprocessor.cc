@@ -62,10 +62,13 @@ ParallelRobustContractionPreprocessor::computeHierarchy() const
 
   tightenEdges(overlayGraph, contractionRanges);
 
+  ContractionGraph core(overlayGraph);
+
   FastRobustWitnessPathSearch search(overlayGraph,
                                      contractionRanges,
                                      values,
-                                     contracted);
+                                     contracted,
+                                     core);
 
   ValueRangeQuotient scoreFunc(overlayGraph, contractionRanges);
 
@@ -149,6 +152,8 @@ ParallelRobustContractionPreprocessor::computeHierarchy() const
     {
       const Vertex& vertex = pair.first;
 
+      const idx numEdges = overlayGraph.getEdges().size();
+
       rankMap(vertex) = currentRank++;
       contractVertex(vertex,
                      overlayGraph,
@@ -157,6 +162,14 @@ ParallelRobustContractionPreprocessor::computeHierarchy() const
                      contracted,
                      pair.second);
 
+      // shortcuts are appended to the overlay graph
+      for(idx i = numEdges; i < overlayGraph.getEdges().size(); ++i)
+      {
+        core.addEdge(overlayGraph.getEdges()[i]);
+      }
+
+      core.removeVertex(vertex);
+
       //scoreFunc.vertexContracted(vertex, results);
     }
 
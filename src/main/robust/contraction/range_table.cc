@@ -0,0 +1,67 @@
+#include "range_table.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+RangeTable::RangeTable(const QueryGraph& queryGraph,
+                       const ShortcutTable& shortcuts,
+                       const EdgeFunc<const ContractionRange&>& contractionRanges)
+  : offsets(1, 0)
+{
+  const idx size = queryGraph.getNumArcs();
+
+  minimums.reserve(size);
+  maximums.reserve(size);
+  slopes.reserve(size);
+  offsets.reserve(size + 1);
+
+  for(idx arc = 0; arc < size; ++arc)
+  {
+    const Edge& edge = shortcuts.getEdge(queryGraph.getShortcut(arc));
+    const ContractionRange& range = contractionRanges(edge);
+
+    minimums.push_back(range.getMinimum());
+    maximums.push_back(range.getMaximum());
+    slopes.push_back(range.getSlope());
+
+    values.insert(values.end(),
+                  range.getValues().begin(),
+                  range.getValues().end());
+
+    offsets.push_back(values.size());
+  }
+}
+
+RangeTable::RangeTable(std::vector<num> minimums,
+                       std::vector<num> maximums,
+                       std::vector<idx> slopes,
+                       std::vector<idx> offsets,
+                       std::vector<num> values)
+  : minimums(std::move(minimums)),
+    maximums(std::move(maximums)),
+    slopes(std::move(slopes)),
+    offsets(std::move(offsets)),
+    values(std::move(values))
+{
+  const idx size = this->minimums.size();
+
+  if(this->maximums.size() != size or
+     this->slopes.size() != size or
+     this->offsets.size() != size + 1 or
+     this->offsets.front() != 0 or
+     this->offsets.back() != this->values.size() or
+     !std::is_sorted(this->offsets.begin(), this->offsets.end()))
+  {
+    throw std::runtime_error("Inconsistent range table");
+  }
+}
+
+MemoryUsage RangeTable::memoryUsage(const std::string& name) const
+{
+  return MemoryUsage(name)
+    .add("minimums", heapUsage(minimums))
+    .add("maximums", heapUsage(maximums))
+    .add("slopes", heapUsage(slopes))
+    .add("offsets", heapUsage(offsets))
+    .add("values", heapUsage(values));
+}
@@ -0,0 +1,119 @@
+#ifndef RANGE_TABLE_HH
+#define RANGE_TABLE_HH
+
+#include "contraction/query_graph.hh"
+
+#include "contraction_range.hh"
+
+/**
+ * The ContractionRange%s of the arcs of a QueryGraph, stored
+ * in arc order as flat arrays. The interval bounds are kept
+ * separately from the deviation values, which are only needed
+ * in order to compute reduced costs of arcs which are contained
+ * in the hierarchy of the respective theta value.
+ **/
+class RangeTable
+{
+private:
+  std::vector<num> minimums, maximums;
+  std::vector<idx> slopes;
+  std::vector<idx> offsets;
+  std::vector<num> values;
+
+public:
+  RangeTable()
+    : offsets(1, 0)
+  {}
+
+  /**
+   * Constructs a new RangeTable containing the ContractionRange%s
+   * of the arcs of the given QueryGraph.
+   **/
+  RangeTable(const QueryGraph& queryGraph,
+             const ShortcutTable& shortcuts,
+             const EdgeFunc<const ContractionRange&>& contractionRanges);
+
+  /**
+   * Constructs a new RangeTable from its underlying arrays.
+   *
+   * @throws std::runtime_error if the arrays do not form
+   *         a valid RangeTable
+   **/
+  RangeTable(std::vector<num> minimums,
+             std::vector<num> maximums,
+             std::vector<idx> slopes,
+             std::vector<idx> offsets,
+             std::vector<num> values);
+
+  /**
+   * Returns whether the given arc is required for the
+   * hierarchy corresponding to the given thetaValue.
+   **/
+  bool contains(idx arc, num thetaValue) const
+  {
+    return thetaValue >= minimums[arc] and
+      thetaValue <= maximums[arc];
+  }
+
+  /**
+   * Returns the reduced cost of the given arc with the given
+   * base cost. @see ContractionRange::getReducedCost
+   **/
+  num getReducedCost(idx arc, num cost, num thetaValue) const
+  {
+    assert(contains(arc, thetaValue));
+
+    num sum = cost;
+
+    for(idx i = offsets[arc]; i < offsets[arc + 1]; ++i)
+    {
+      if(values[i] <= thetaValue)
+      {
+        break;
+      }
+
+      sum += (values[i] - thetaValue);
+    }
+
+    sum += -(slopes[arc] * thetaValue);
+
+    return sum;
+  }
+
+  /**
+   * Returns the memory used by the arrays of the RangeTable.
+   **/
+  MemoryUsage memoryUsage(const std::string& name = "RangeTable") const;
+
+  idx size() const
+  {
+    return minimums.size();
+  }
+
+  const std::vector<num>& getMinimums() const
+  {
+    return minimums;
+  }
+
+  const std::vector<num>& getMaximums() const
+  {
+    return maximums;
+  }
+
+  const std::vector<idx>& getSlopes() const
+  {
+    return slopes;
+  }
+
+  const std::vector<idx>& getOffsets() const
+  {
+    return offsets;
+  }
+
+  const std::vector<num>& getValues() const
+  {
+    return values;
+  }
+};
+
+#endif /* RANGE_TABLE_HH */
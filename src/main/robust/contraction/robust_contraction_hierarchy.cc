@@ -1,79 +1,109 @@
 #include "robust_contraction_hierarchy.hh"
 
-#include <stack>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
 
 #include "router/label.hh"
 #include "router/label_heap.hh"
 
-class RobustContractionLabel : public AbstractLabel
-{
-private:
-  const RobustContractionEdge* edge;
-
-public:
-  RobustContractionLabel()
-    : edge(nullptr)
-  {}
-  RobustContractionLabel(Vertex vertex,
-                   const RobustContractionEdge& edge,
-                   num cost)
-    : AbstractLabel(vertex, cost),
-      edge(&edge)
-  {}
-
-  const RobustContractionEdge& getEdge() const
-  {
-    return *edge;
-  }
-
-};
-
-
 RobustContractionHierarchy::RobustContractionHierarchy(const Graph& overlayGraph,
                                                        const EdgeFunc<const ContractionRange&>& contractionRanges,
                                                        const VertexMap<num>& ranks,
                                                        const EdgeFunc<const EdgePair&>& edgePairs)
   : graph(Graph(overlayGraph.getVertices().size(), {})),
-    permutation(graph, Vertex()),
-    upwardEdges(graph, std::vector<RobustContractionEdge>()),
-    downwardEdges(graph, std::vector<RobustContractionEdge>()),
-    originalEdges(overlayGraph, EdgePair())
+    ranks(overlayGraph.getVertices().size()),
+    shortcuts(overlayGraph, edgePairs)
 {
-  for(const Vertex& originalVertex : overlayGraph.getVertices())
+  const idx size = overlayGraph.getVertices().size();
+
+  for(const Vertex& vertex : overlayGraph.getVertices())
   {
-    const Vertex& permutedVertex = overlayGraph.getVertices()[ranks(originalVertex)];
-    permutation(originalVertex) = permutedVertex;
+    this->ranks[vertex.getIndex()] = ranks(vertex);
   }
 
+  std::vector<QueryGraph::Arc> upwardArcs, downwardArcs;
+
   for(const Edge& edge : overlayGraph.getEdges())
   {
-    const Vertex& source = edge.getSource();
-    const Vertex& target = edge.getTarget();
-
-    bool upwards = ranks(source) < ranks(target);
-
-    Vertex permutedSource = permutation(source);
-    Vertex permutedTarget = permutation(target);
+    const idx sourceRank = ranks(edge.getSource());
+    const idx targetRank = ranks(edge.getTarget());
+    const num cost = contractionRanges(edge).getCost();
 
-    originalEdges(edge) = edgePairs(edge);
-
-    if(upwards)
+    if(sourceRank < targetRank)
     {
-      RobustContractionEdge contractionEdge(permutedTarget,
-                                            edge,
-                                            contractionRanges(edge));
-
-      upwardEdges(permutedSource).push_back(contractionEdge);
+      upwardArcs.push_back(QueryGraph::Arc(sourceRank,
+                                           targetRank,
+                                           edge.getIndex(),
+                                           cost));
     }
     else
     {
-      RobustContractionEdge contractionEdge(permutedSource,
-                                            edge,
-                                            contractionRanges(edge));
-
-      downwardEdges(permutedTarget).push_back(contractionEdge);
+      downwardArcs.push_back(QueryGraph::Arc(targetRank,
+                                             sourceRank,
+                                             edge.getIndex(),
+                                             cost));
     }
   }
+
+  upwardGraph = QueryGraph(size, upwardArcs);
+  downwardGraph = QueryGraph(size, downwardArcs);
+
+  upwardRanges = RangeTable(upwardGraph, shortcuts, contractionRanges);
+  downwardRanges = RangeTable(downwardGraph, shortcuts, contractionRanges);
+}
+
+RobustContractionHierarchy::RobustContractionHierarchy(std::vector<idx> ranks,
+                                                       QueryGraph upwardGraph,
+                                                       QueryGraph downwardGraph,
+                                                       RangeTable upwardRanges,
+                                                       RangeTable downwardRanges,
+                                                       ShortcutTable shortcuts)
+  : graph(Graph(ranks.size(), {})),
+    ranks(std::move(ranks)),
+    upwardGraph(std::move(upwardGraph)),
+    downwardGraph(std::move(downwardGraph)),
+    upwardRanges(std::move(upwardRanges)),
+    downwardRanges(std::move(downwardRanges)),
+    shortcuts(std::move(shortcuts))
+{
+  if(this->upwardGraph.getNumVertices() != this->ranks.size() or
+     this->downwardGraph.getNumVertices() != this->ranks.size() or
+     this->upwardRanges.size() != this->upwardGraph.getNumArcs() or
+     this->downwardRanges.size() != this->downwardGraph.getNumArcs())
+  {
+    throw std::runtime_error("Inconsistent robust contraction hierarchy");
+  }
+
+  const idx size = this->ranks.size();
+
+  if(!std::all_of(this->ranks.begin(),
+                  this->ranks.end(),
+                  [size](idx rank) -> bool
+                  {
+                    return rank < size;
+                  }))
+  {
+    throw std::runtime_error("Invalid rank");
+  }
+
+  if(!(this->upwardGraph.isConsistent(this->shortcuts) and
+       this->downwardGraph.isConsistent(this->shortcuts)))
+  {
+    throw std::runtime_error("Invalid shortcut");
+  }
+}
+
+MemoryUsage RobustContractionHierarchy::memoryUsage() const
+{
+  return MemoryUsage("RobustContractionHierarchy")
+    .add(graph.memoryUsage())
+    .add("ranks", heapUsage(ranks))
+    .add(upwardGraph.memoryUsage("upwardGraph"))
+    .add(downwardGraph.memoryUsage("downwardGraph"))
+    .add(upwardRanges.memoryUsage("upwardRanges"))
+    .add(downwardRanges.memoryUsage("downwardRanges"))
+    .add(shortcuts.memoryUsage());
 }
 
 SearchResult RobustContractionHierarchy::Router::shortestPath(Vertex source,
@@ -98,14 +128,14 @@ SearchResult RobustContractionHierarchy::Router::findShortestPath(Vertex source,
                                                                   num theta,
                                                                   num bound)
 {
-  Vertex permutedSource = hierarchy.permutation(source);
-  Vertex permutedTarget = hierarchy.permutation(target);
+  const Vertex permutedSource(hierarchy.ranks[source.getIndex()]);
+  const Vertex permutedTarget(hierarchy.ranks[target.getIndex()]);
 
-  LabelHeap<RobustContractionLabel> forwardHeap(hierarchy.graph);
-  LabelHeap<RobustContractionLabel> backwardHeap(hierarchy.graph);
+  LabelHeap<QueryLabel> forwardHeap(hierarchy.graph);
+  LabelHeap<QueryLabel> backwardHeap(hierarchy.graph);
 
-  forwardHeap.update(RobustContractionLabel(permutedSource, RobustContractionEdge(), 0));
-  backwardHeap.update(RobustContractionLabel(permutedTarget, RobustContractionEdge(), 0));
+  forwardHeap.update(QueryLabel(permutedSource, 0));
+  backwardHeap.update(QueryLabel(permutedTarget, 0));
 
   int settled = 0, labeled = 0;
   bool found = false;
@@ -128,71 +158,85 @@ SearchResult RobustContractionHierarchy::Router::findShortestPath(Vertex source,
       break;
     }
 
-    if(forwardValue < backwardValue)
-    {
-      RobustContractionLabel current = forwardHeap.extractMin();
+    const bool forward = forwardValue < backwardValue;
 
-      ++settled;
+    LabelHeap<QueryLabel>& heap = forward ? forwardHeap : backwardHeap;
+    const LabelHeap<QueryLabel>& otherHeap = forward ? backwardHeap : forwardHeap;
 
-      for(const RobustContractionEdge& edge : hierarchy.upwardEdges(current.getVertex()))
-      {
-        if(!edge.getRange().contains(theta))
-        {
-          continue;
-        }
+    const QueryGraph& queryGraph = forward ?
+      hierarchy.upwardGraph :
+      hierarchy.downwardGraph;
 
-        Vertex nextVertex = edge.getVertex();
-        num nextCost = current.getCost() + edge.getRange().getReducedCost(theta);
-        ++labeled;
+    const RangeTable& ranges = forward ?
+      hierarchy.upwardRanges :
+      hierarchy.downwardRanges;
 
-        forwardHeap.update(RobustContractionLabel(nextVertex, edge, nextCost));
+    const QueryGraph& reverseGraph = forward ?
+      hierarchy.downwardGraph :
+      hierarchy.upwardGraph;
 
-        const RobustContractionLabel& other = backwardHeap.getLabel(nextVertex);
+    const RangeTable& reverseRanges = forward ?
+      hierarchy.downwardRanges :
+      hierarchy.upwardRanges;
 
-        if(other.getState() != State::UNKNOWN)
+    const QueryLabel current = heap.extractMin();
+    const idx index = current.getVertex().getIndex();
+
+    ++settled;
+
+    auto reverseWeight = [&](idx arc) -> num
+      {
+        if(!reverseRanges.contains(arc, theta))
         {
-          num value = other.getCost() + nextCost;
-
-          if(value < splitValue)
-          {
-            splitValue = value;
-            split = nextVertex;
-            found = true;
-          }
+          return inf;
         }
-      }
+
+        return reverseRanges.getReducedCost(arc,
+                                            reverseGraph.getWeight(arc),
+                                            theta);
+      };
+
+    if(stalling and isStalled(heap, reverseGraph, current, reverseWeight))
+    {
+      continue;
     }
-    else
+
+    for(idx arc = queryGraph.getBegin(index); arc < queryGraph.getEnd(index); ++arc)
     {
-      RobustContractionLabel current = backwardHeap.extractMin();
+      if(!ranges.contains(arc, theta))
+      {
+        continue;
+      }
 
-      ++settled;
+      const Vertex nextVertex(queryGraph.getHead(arc));
+      const num nextCost = current.getCost() +
+        ranges.getReducedCost(arc, queryGraph.getWeight(arc), theta);
 
-      for(const RobustContractionEdge& edge : hierarchy.downwardEdges(current.getVertex()))
+      // labels exceeding the bound can neither improve
+      // the split nor lead to a feasible path
+      if(nextCost >= splitValue or (bounded and nextCost > bound))
       {
-        if(!edge.getRange().contains(theta))
-        {
-          continue;
-        }
+        continue;
+      }
 
-        Vertex nextVertex = edge.getVertex();
-        num nextCost = current.getCost() + edge.getRange().getReducedCost(theta);
-        ++labeled;
+      ++labeled;
 
-        backwardHeap.update(RobustContractionLabel(nextVertex, edge, nextCost));
+      heap.update(QueryLabel(nextVertex,
+                             current.getVertex(),
+                             queryGraph.getShortcut(arc),
+                             nextCost));
 
-        const RobustContractionLabel& other = forwardHeap.getLabel(nextVertex);
+      const QueryLabel& other = otherHeap.getLabel(nextVertex);
 
-        if(other.getState() != State::UNKNOWN)
+      if(other.getState() != State::UNKNOWN)
+      {
+        num value = other.getCost() + nextCost;
+
+        if(value < splitValue)
         {
-          num value = other.getCost() + nextCost;
-
-          if(value < splitValue)
-          {
-            splitValue = value;
-            split = nextVertex;
-            found = true;
-          }
+          splitValue = value;
+          split = nextVertex;
+          found = true;
         }
       }
     }
@@ -208,68 +252,159 @@ SearchResult RobustContractionHierarchy::Router::findShortestPath(Vertex source,
       }
     }
 
-    Path path;
+    Path path = hierarchy.shortcuts.unpack(collectShortcuts(forwardHeap,
+                                                            backwardHeap,
+                                                            split));
 
-    RobustContractionLabel current = forwardHeap.getLabel(split);
+    assert(path.connects(source, target));
 
-    while(current.getVertex() != permutedSource)
+    if(bounded)
     {
-      Edge edge = current.getEdge().getEdge();
-      path.prepend(edge);
-      current = forwardHeap.getLabel(hierarchy.permutation(edge.getSource()));
+      assert(splitValue <= bound);
     }
 
-    current = backwardHeap.getLabel(split);
+    return SearchResult(settled, labeled, true, path, splitValue);
+  }
+
+  return SearchResult::notFound(settled, labeled);
+}
+
+template <class Func>
+void RobustContractionHierarchy::Router::search(Vertex root,
+                                                const QueryGraph& queryGraph,
+                                                const RangeTable& ranges,
+                                                num theta,
+                                                num bound,
+                                                Func settle)
+{
+  labels.reset();
+  heap.clear();
+
+  const Vertex start(hierarchy.ranks[root.getIndex()]);
 
-    while(current.getVertex() != permutedTarget)
+  labels.setValue(start, 0);
+  heap.push_back(HeapEntry(0, start.getIndex()));
+
+  while(!heap.empty())
+  {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+
+    const num cost = heap.back().first;
+    const Vertex current(heap.back().second);
+
+    heap.pop_back();
+
+    // skip outdated entries
+    if(cost > labels(current))
     {
-      Edge edge = current.getEdge().getEdge();
-      path.append(edge);
-      current = backwardHeap.getLabel(hierarchy.permutation(edge.getTarget()));
+      continue;
     }
 
-    assert(path.connects(source, target));
-
-    if(bounded)
+    if(cost >= bound)
     {
-      assert(splitValue <= bound);
+      break;
     }
 
-    path = hierarchy.unpack(path);
+    settle(current, cost);
 
-    return SearchResult(settled, labeled, true, path, splitValue);
-  }
+    const idx index = current.getIndex();
 
-  return SearchResult::notFound(settled, labeled);
+    for(idx arc = queryGraph.getBegin(index); arc < queryGraph.getEnd(index); ++arc)
+    {
+      if(!ranges.contains(arc, theta))
+      {
+        continue;
+      }
+
+      const Vertex nextVertex(queryGraph.getHead(arc));
+      const num nextCost = cost +
+        ranges.getReducedCost(arc, queryGraph.getWeight(arc), theta);
+
+      if(nextCost >= bound or nextCost >= labels(nextVertex))
+      {
+        continue;
+      }
+
+      labels.setValue(nextVertex, nextCost);
+
+      heap.push_back(HeapEntry(nextCost, nextVertex.getIndex()));
+      std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+    }
+  }
 }
 
-Path RobustContractionHierarchy::unpack(const Path& overlayPath) const
+std::vector<num>
+RobustContractionHierarchy::Router::distances(const std::vector<Vertex>& sources,
+                                              const std::vector<Vertex>& targets,
+                                              num theta,
+                                              const std::vector<num>& bounds)
 {
-  Path path;
+  const idx numTargets = targets.size();
 
-  std::stack<Edge> edges;
+  assert(bounds.size() == sources.size() * numTargets);
 
-  for(const Edge& edge : overlayPath.getEdges())
+  std::vector<num> result(sources.size() * numTargets, inf);
+
+  if(buckets.empty())
   {
-    edges.push(edge);
+    labels = SparseVertexMap<num>(hierarchy.graph, inf);
+    buckets.resize(hierarchy.ranks.size());
   }
 
-  while(!edges.empty())
+  // buckets hold pairs of target indices and distances
+  for(const idx& index : bucketVertices)
   {
-    const Edge& edge = edges.top();
-    edges.pop();
-    const EdgePair& pair = originalEdges(edge);
+    buckets[index].clear();
+  }
 
-    if(pair.first == edge)
-    {
-      path.prepend(edge);
-    }
-    else
+  bucketVertices.clear();
+
+  for(idx j = 0; j < numTargets; ++j)
+  {
+    num bound = 0;
+
+    for(idx i = 0; i < sources.size(); ++i)
     {
-      edges.push(pair.first);
-      edges.push(pair.second);
+      bound = std::max(bound, bounds[i * numTargets + j]);
     }
+
+    search(targets[j],
+           hierarchy.downwardGraph,
+           hierarchy.downwardRanges,
+           theta,
+           bound,
+           [&](Vertex vertex, num cost)
+           {
+             std::vector<std::pair<idx, num>>& bucket = buckets[vertex.getIndex()];
+
+             if(bucket.empty())
+             {
+               bucketVertices.push_back(vertex.getIndex());
+             }
+
+             bucket.push_back(std::make_pair(j, cost));
+           });
+  }
+
+  for(idx i = 0; i < sources.size(); ++i)
+  {
+    const auto rowBegin = bounds.begin() + i * numTargets;
+    const num bound = *std::max_element(rowBegin, rowBegin + numTargets);
+
+    search(sources[i],
+           hierarchy.upwardGraph,
+           hierarchy.upwardRanges,
+           theta,
+           bound,
+           [&](Vertex vertex, num cost)
+           {
+             for(const std::pair<idx, num>& entry : buckets[vertex.getIndex()])
+             {
+               num& distance = result[i * numTargets + entry.first];
+               distance = std::min(distance, cost + entry.second);
+             }
+           });
   }
 
-  return path;
+  return result;
 }
@@ -1,78 +1,153 @@
 #ifndef ROBUST_CONTRACTION_HIERARCHY_HH
 #define ROBUST_CONTRACTION_HIERARCHY_HH
 
+#include <utility>
+#include <vector>
+
 #include "graph/graph.hh"
+#include "graph/sparse_vertex_map.hh"
 #include "router/router.hh"
 
 #include "contraction/edge_pair.hh"
+#include "contraction/query_graph.hh"
 
 #include "robust/theta/theta_router.hh"
 #include "contraction_range.hh"
+#include "range_table.hh"
 
 
-class RobustContractionEdge
+/**
+ * A robust contraction hierarchy. As the ContractionHierarchy,
+ * it stores the upward and downward Edge%s in rank-ordered
+ * QueryGraph%s, the weights of the arcs being their base costs.
+ * The intervals and deviation values required to compute reduced
+ * costs are stored in one RangeTable per QueryGraph.
+ **/
+class RobustContractionHierarchy
 {
 private:
-  Vertex vertex;
-  Edge edge;
-  ContractionRange range;
+  Graph graph;
+  std::vector<idx> ranks;
+  QueryGraph upwardGraph, downwardGraph;
+  RangeTable upwardRanges, downwardRanges;
+  ShortcutTable shortcuts;
 
 public:
-  RobustContractionEdge()
-  {}
-  RobustContractionEdge(Vertex vertex, Edge edge, const ContractionRange& range)
-    : vertex(vertex),
-      edge(edge),
-      range(range)
-  {}
-
-  const Edge& getEdge() const
+  RobustContractionHierarchy(const Graph& overlayGraph,
+                             const EdgeFunc<const ContractionRange&>& contractionRanges,
+                             const VertexMap<num>& ranks,
+                             const EdgeFunc<const EdgePair&>& originalEdges);
+
+  /**
+   * Constructs a RobustContractionHierarchy from its
+   * (deserialized) query layout.
+   *
+   * @throws std::runtime_error if the parts are inconsistent
+   **/
+  RobustContractionHierarchy(std::vector<idx> ranks,
+                             QueryGraph upwardGraph,
+                             QueryGraph downwardGraph,
+                             RangeTable upwardRanges,
+                             RangeTable downwardRanges,
+                             ShortcutTable shortcuts);
+
+  /**
+   * Returns the ranks of the vertices of the original Graph.
+   **/
+  const std::vector<idx>& getRanks() const
   {
-    return edge;
+    return ranks;
   }
 
-  const ContractionRange& getRange() const
+  const QueryGraph& getUpwardGraph() const
   {
-    return range;
+    return upwardGraph;
   }
 
-  const Vertex& getVertex() const
+  /**
+   * Returns the downward Edge%s, stored at their targets.
+   **/
+  const QueryGraph& getDownwardGraph() const
   {
-    return vertex;
+    return downwardGraph;
   }
-};
 
-class RobustContractionHierarchy
-{
-private:
-  Graph graph;
-  VertexMap<Vertex> permutation;
-  VertexMap<std::vector<RobustContractionEdge>> upwardEdges, downwardEdges;
-  EdgeMap<EdgePair> originalEdges;
+  const RangeTable& getUpwardRanges() const
+  {
+    return upwardRanges;
+  }
 
-  Path unpack(const Path& overlayPath) const;
+  const RangeTable& getDownwardRanges() const
+  {
+    return downwardRanges;
+  }
 
-public:
-  RobustContractionHierarchy(const Graph& overlayGraph,
-                             const EdgeFunc<const ContractionRange&>& contractionRanges,
-                             const VertexMap<num>& ranks,
-                             const EdgeFunc<const EdgePair&>& originalEdges);
+  const ShortcutTable& getShortcuts() const
+  {
+    return shortcuts;
+  }
+
+  /**
+   * Returns the memory used by the query layout, the RangeTable%s
+   * and the ShortcutTable of the hierarchy.
+   **/
+  MemoryUsage memoryUsage() const;
 
   class Router : public ThetaRouter
   {
   private:
+    typedef std::pair<num, idx> HeapEntry;
+
     template <bool bounded>
     SearchResult findShortestPath(Vertex source,
                                   Vertex target,
                                   num theta,
                                   num bound = inf);
 
+    /**
+     * Runs a Dijkstra search from the given (original) Vertex on
+     * the given QueryGraph, passing each settled (permuted) Vertex
+     * whose distance is below the bound to the given function.
+     * Only the labels touched by the previous search are reset.
+     **/
+    template <class Func>
+    void search(Vertex root,
+                const QueryGraph& queryGraph,
+                const RangeTable& ranges,
+                num theta,
+                num bound,
+                Func settle);
+
     const RobustContractionHierarchy& hierarchy;
+    bool stalling;
+
+    // the workspace of the many-to-many searches, which
+    // is allocated upon the first call of distances()
+    SparseVertexMap<num> labels;
+    std::vector<HeapEntry> heap;
+    std::vector<std::vector<std::pair<idx, num>>> buckets;
+    std::vector<idx> bucketVertices;
+
   public:
     Router(const RobustContractionHierarchy& hierarchy)
-      : hierarchy(hierarchy)
+      : hierarchy(hierarchy),
+        stalling(true)
     {}
 
+    /**
+     * Enables or disables stall-on-demand, which is enabled by
+     * default. Only arcs contained in the hierarchy with respect
+     * to the current theta value are used to stall vertices.
+     **/
+    void setStalling(bool stalling)
+    {
+      this->stalling = stalling;
+    }
+
+    bool isStalling() const
+    {
+      return stalling;
+    }
 
     SearchResult shortestPath(Vertex source,
                               Vertex target,
@@ -82,6 +157,25 @@ public:
                               Vertex target,
                               num theta,
                               num bound) override;
+
+    /**
+     * Computes the distances with respect to the given theta
+     * value between all pairs of sources and targets using a
+     * bucket-based many-to-many search: The backward searches
+     * from the targets store their distances in buckets at the
+     * settled vertices, which are then scanned by the forward
+     * searches from the sources.
+     *
+     * The searches are pruned by the given bounds (one per pair,
+     * stored row-wise): A distance is exact if it is smaller than
+     * its bound, otherwise it may be reported as inf.
+     *
+     * @return The distances, stored row-wise.
+     **/
+    std::vector<num> distances(const std::vector<Vertex>& sources,
+                               const std::vector<Vertex>& targets,
+                               num theta,
+                               const std::vector<num>& bounds);
   };
 
   Router getRouter() const
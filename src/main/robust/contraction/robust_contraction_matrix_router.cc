@@ -0,0 +1,130 @@
+#include "robust_contraction_matrix_router.hh"
+
+RobustContractionMatrixRouter::RobustContractionMatrixRouter(const Graph& graph,
+                                                             const EdgeFunc<num>& costs,
+                                                             const EdgeFunc<num>& deviations,
+                                                             idx deviationSize,
+                                                             const RobustContractionHierarchy& hierarchy)
+  : RobustRouter(graph, costs, deviations, deviationSize),
+    router(hierarchy),
+    simpleRouter(graph, costs, deviations, deviationSize, router),
+    searches(0)
+{
+}
+
+RobustSearchResult RobustContractionMatrixRouter::shortestPath(Vertex source,
+                                                               Vertex target,
+                                                               const ValueVector& possibleValues,
+                                                               num bound)
+{
+  return simpleRouter.shortestPath(source, target, possibleValues, bound);
+}
+
+RobustCostMatrix RobustContractionMatrixRouter::shortestPaths(const std::vector<Vertex>& sources,
+                                                              const std::vector<Vertex>& targets,
+                                                              const ValueVector& possibleValues,
+                                                              bool computePaths)
+{
+  RobustCostMatrix matrix(sources, targets);
+
+  const idx numPairs = sources.size() * targets.size();
+  std::vector<num> bounds(numPairs, inf);
+
+  // reachability does not depend on theta, pairs which
+  // are unreachable initially never need to be considered
+  std::vector<bool> reachable(numPairs, true);
+
+  searches = 0;
+
+  // The values are sorted in descending order
+  for(auto it = possibleValues.rbegin(); it != possibleValues.rend(); ++it)
+  {
+    const num value = *it;
+    const num offset = ((num) deviationSize) * value;
+
+    bool open = false;
+
+    for(idx i = 0; i < sources.size(); ++i)
+    {
+      for(idx j = 0; j < targets.size(); ++j)
+      {
+        const idx index = i * targets.size() + j;
+        const num cost = matrix.getCost(i, j);
+        num& bound = bounds[index];
+
+        if(!reachable[index])
+        {
+          bound = 0;
+        }
+        else
+        {
+          bound = (cost == inf) ? inf : std::max(cost - offset, 0);
+        }
+
+        open = open or (bound > 0);
+      }
+    }
+
+    if(!open)
+    {
+      break;
+    }
+
+    const std::vector<num> distances = router.distances(sources,
+                                                        targets,
+                                                        value,
+                                                        bounds);
+
+    // the first search is unbounded
+    const bool first = (searches++ == 0);
+
+    for(idx i = 0; i < sources.size(); ++i)
+    {
+      for(idx j = 0; j < targets.size(); ++j)
+      {
+        const idx index = i * targets.size() + j;
+        const num distance = distances[index];
+
+        if(distance == inf)
+        {
+          if(first)
+          {
+            reachable[index] = false;
+          }
+
+          continue;
+        }
+
+        RobustTargetResult& result = matrix.get(i, j);
+        const num cost = offset + distance;
+
+        if(cost < result.cost)
+        {
+          result.found = true;
+          result.cost = cost;
+          result.value = value;
+        }
+      }
+    }
+  }
+
+  if(computePaths)
+  {
+    for(idx i = 0; i < sources.size(); ++i)
+    {
+      for(idx j = 0; j < targets.size(); ++j)
+      {
+        RobustTargetResult& result = matrix.get(i, j);
+
+        if(result.found)
+        {
+          result.path = router.shortestPath(sources[i],
+                                            targets[j],
+                                            result.value).path;
+        }
+      }
+    }
+  }
+
+  return matrix;
+}
@@ -0,0 +1,57 @@
+#ifndef ROBUST_CONTRACTION_MATRIX_ROUTER_HH
+#define ROBUST_CONTRACTION_MATRIX_ROUTER_HH
+
+#include "robust/robust_router.hh"
+#include "robust/simple_robust_router.hh"
+
+#include "robust_contraction_hierarchy.hh"
+
+/**
+ * A RobustRouter based on a RobustContractionHierarchy
+ * which computes robust cost matrices using one bucket-based
+ * many-to-many search per theta value. The theta values are
+ * processed in ascending order, the search for each pair is
+ * bounded by \f$ c^{*} - \Gamma \theta \f$, where \f$ c^{*} \f$
+ * denotes the best robust cost found so far for the pair.
+ * Pairs which are unreachable for the first value are not
+ * considered any further.
+ * Single pairs are answered by a SimpleRobustRouter.
+ **/
+class RobustContractionMatrixRouter : public RobustRouter
+{
+private:
+  RobustContractionHierarchy::Router router;
+  SimpleRobustRouter simpleRouter;
+  idx searches;
+
+public:
+  RobustContractionMatrixRouter(const Graph& graph,
+                                const EdgeFunc<num>& costs,
+                                const EdgeFunc<num>& deviations,
+                                idx deviationSize,
+                                const RobustContractionHierarchy& hierarchy);
+
+  using RobustRouter::shortestPath;
+  using RobustRouter::shortestPaths;
+
+  RobustSearchResult shortestPath(Vertex source,
+                                  Vertex target,
+                                  const ValueVector& possibleValues,
+                                  num bound) override;
+
+  RobustCostMatrix shortestPaths(const std::vector<Vertex>& sources,
+                                 const std::vector<Vertex>& targets,
+                                 const ValueVector& possibleValues,
+                                 bool computePaths = true) override;
+
+  /**
+   * Returns the number of many-to-many searches performed
+   * during the last computation of a cost matrix.
+   **/
+  idx getSearches() const
+  {
+    return searches;
+  }
+};
+
+#endif /* ROBUST_CONTRACTION_MATRIX_ROUTER_HH */
@@ -0,0 +1,426 @@
+#include "robust_profile_router.hh"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace
+{
+  const idx NONE = (idx) -1;
+}
+
+idx RobustProfile::optimalIndex(idx deviationSize) const
+{
+  idx index = values.size();
+  num bestCost = inf;
+
+  for(idx i = 0; i < values.size(); ++i)
+  {
+    if(distances[i] == inf)
+    {
+      continue;
+    }
+
+    const num cost = ((num) deviationSize) * values[i] + distances[i];
+
+    if(cost < bestCost)
+    {
+      bestCost = cost;
+      index = i;
+    }
+  }
+
+  return index;
+}
+
+/**
+ * A single profile search. In robust mode, the key of each component
+ * is offset by \f$ \Gamma \theta \f$ and all components are pruned
+ * by the best robust cost. Otherwise, each component is pruned by
+ * the best distance found for its theta value.
+ **/
+class RobustProfileRouter::Search
+{
+private:
+  typedef std::pair<num, idx> HeapEntry;
+
+  class Side
+  {
+  public:
+    Side(idx numVertices)
+      : slots(numVertices, NONE)
+    {}
+
+    std::vector<idx> slots;
+    std::vector<Vertex> vertices;
+    std::vector<num> keys;
+
+    // the components of the labels, stored slot-wise
+    std::vector<num> distances;
+    std::vector<idx> parents;
+    std::vector<idx> shortcuts;
+
+    std::priority_queue<HeapEntry,
+                        std::vector<HeapEntry>,
+                        std::greater<HeapEntry>> heap;
+
+    num topKey() const
+    {
+      return heap.empty() ? inf : heap.top().first;
+    }
+  };
+
+  const RobustContractionHierarchy& hierarchy;
+  const ValueVector& values;
+  const idx size;
+  const bool robust;
+
+  std::vector<num> offsets;
+  Side sides[2];
+
+  std::vector<num> best;
+  num maxBest;
+
+public:
+  num bestCost;
+  Vertex meeting;
+  idx meetingIndex;
+
+  idx settled, labeled;
+
+  Search(const RobustContractionHierarchy& hierarchy,
+         const ValueVector& values,
+         idx deviationSize,
+         bool robust,
+         num bound)
+    : hierarchy(hierarchy),
+      values(values),
+      size(values.size()),
+      robust(robust),
+      offsets(values.size(), 0),
+      sides{Side(hierarchy.getRanks().size()),
+            Side(hierarchy.getRanks().size())},
+      best(values.size(), inf),
+      maxBest(inf),
+      bestCost(bound),
+      meetingIndex(NONE),
+      settled(0),
+      labeled(0)
+  {
+    if(robust)
+    {
+      for(idx i = 0; i < size; ++i)
+      {
+        offsets[i] = ((num) deviationSize) * values[i];
+      }
+    }
+  }
+
+  const std::vector<num>& getBest() const
+  {
+    return best;
+  }
+
+  void run(Vertex source, Vertex target);
+
+  std::vector<idx> collectShortcuts() const;
+
+private:
+  num limit(idx i) const
+  {
+    return robust ? bestCost : best[i];
+  }
+
+  num stopValue() const
+  {
+    return robust ? bestCost : maxBest;
+  }
+
+  idx getSlot(Side& side, Vertex vertex);
+
+  void meet(Vertex vertex);
+
+  void scan(idx direction);
+};
+
+idx RobustProfileRouter::Search::getSlot(Side& side, Vertex vertex)
+{
+  idx& slot = side.slots[vertex.getIndex()];
+
+  if(slot == NONE)
+  {
+    slot = side.vertices.size();
+    side.vertices.push_back(vertex);
+    side.keys.push_back(inf);
+    side.distances.resize(side.distances.size() + size, inf);
+    side.parents.resize(side.parents.size() + size, NONE);
+    side.shortcuts.resize(side.shortcuts.size() + size, ShortcutTable::ORIGINAL);
+  }
+
+  return slot;
+}
+
+void RobustProfileRouter::Search::meet(Vertex vertex)
+{
+  const idx forwardSlot = sides[0].slots[vertex.getIndex()];
+  const idx backwardSlot = sides[1].slots[vertex.getIndex()];
+
+  if(forwardSlot == NONE or backwardSlot == NONE)
+  {
+    return;
+  }
+
+  bool improved = false;
+
+  for(idx i = 0; i < size; ++i)
+  {
+    const num first = sides[0].distances[forwardSlot * size + i];
+    const num second = sides[1].distances[backwardSlot * size + i];
+
+    if(first == inf or second == inf)
+    {
+      continue;
+    }
+
+    const num distance = first + second;
+
+    if(distance < best[i])
+    {
+      best[i] = distance;
+      improved = true;
+    }
+
+    if(offsets[i] + distance < bestCost)
+    {
+      bestCost = offsets[i] + distance;
+      meeting = vertex;
+      meetingIndex = i;
+    }
+  }
+
+  if(improved and !robust)
+  {
+    maxBest = *std::max_element(best.begin(), best.end());
+  }
+}
+
+void RobustProfileRouter::Search::scan(idx direction)
+{
+  Side& side = sides[direction];
+
+  const HeapEntry entry = side.heap.top();
+  side.heap.pop();
+
+  const idx slot = entry.second;
+
+  if(entry.first != side.keys[slot])
+  {
+    return;
+  }
+
+  side.keys[slot] = inf;
+
+  const Vertex vertex = side.vertices[slot];
+  const idx index = vertex.getIndex();
+
+  const QueryGraph& queryGraph = (direction == 0) ?
+    hierarchy.getUpwardGraph() :
+    hierarchy.getDownwardGraph();
+
+  const RangeTable& ranges = (direction == 0) ?
+    hierarchy.getUpwardRanges() :
+    hierarchy.getDownwardRanges();
+
+  ++settled;
+
+  for(idx arc = queryGraph.getBegin(index); arc < queryGraph.getEnd(index); ++arc)
+  {
+    const Vertex head(queryGraph.getHead(arc));
+    const num weight = queryGraph.getWeight(arc);
+
+    idx headSlot = side.slots[head.getIndex()];
+    num key = inf;
+    bool improved = false;
+
+    for(idx i = 0; i < size; ++i)
+    {
+      const num current = side.distances[slot * size + i];
+
+      if(current == inf or !ranges.contains(arc, values[i]))
+      {
+        continue;
+      }
+
+      const num distance = current + ranges.getReducedCost(arc, weight, values[i]);
+
+      if(offsets[i] + distance >= limit(i))
+      {
+        continue;
+      }
+
+      if(headSlot == NONE)
+      {
+        headSlot = getSlot(side, head);
+      }
+
+      const idx position = headSlot * size + i;
+
+      if(distance < side.distances[position])
+      {
+        side.distances[position] = distance;
+        side.parents[position] = index;
+        side.shortcuts[position] = queryGraph.getShortcut(arc);
+
+        key = std::min(key, offsets[i] + distance);
+        improved = true;
+      }
+    }
+
+    if(!improved)
+    {
+      continue;
+    }
+
+    ++labeled;
+
+    // the remaining components are scanned anyway if the
+    // head is already queued with a smaller key
+    num& headKey = side.keys[headSlot];
+
+    if(key < headKey)
+    {
+      headKey = key;
+      side.heap.push(HeapEntry(headKey, headSlot));
+    }
+
+    meet(head);
+  }
+}
+
+void RobustProfileRouter::Search::run(Vertex source, Vertex target)
+{
+  const Vertex roots[2] = {
+    Vertex(hierarchy.getRanks()[source.getIndex()]),
+    Vertex(hierarchy.getRanks()[target.getIndex()])
+  };
+
+  for(idx direction = 0; direction < 2; ++direction)
+  {
+    Side& side = sides[direction];
+    const idx slot = getSlot(side, roots[direction]);
+
+    num key = inf;
+
+    for(idx i = 0; i < size; ++i)
+    {
+      side.distances[slot * size + i] = 0;
+      key = std::min(key, offsets[i]);
+    }
+
+    side.keys[slot] = key;
+    side.heap.push(HeapEntry(key, slot));
+  }
+
+  meet(roots[0]);
+
+  while(true)
+  {
+    const num forwardKey = sides[0].topKey();
+    const num backwardKey = sides[1].topKey();
+
+    if(std::min(forwardKey, backwardKey) >= stopValue())
+    {
+      break;
+    }
+
+    scan((forwardKey <= backwardKey) ? 0 : 1);
+  }
+}
+
+std::vector<idx> RobustProfileRouter::Search::collectShortcuts() const
+{
+  std::vector<idx> result;
+
+  for(idx direction = 0; direction < 2; ++direction)
+  {
+    const Side& side = sides[direction];
+    std::vector<idx> current;
+
+    idx index = meeting.getIndex();
+
+    while(true)
+    {
+      const idx position = side.slots[index] * size + meetingIndex;
+
+      if(side.parents[position] == NONE)
+      {
+        break;
+      }
+
+      current.push_back(side.shortcuts[position]);
+      index = side.parents[position];
+    }
+
+    if(direction == 0)
+    {
+      std::reverse(current.begin(), current.end());
+    }
+
+    result.insert(result.end(), current.begin(), current.end());
+  }
+
+  return result;
+}
+
+RobustProfileRouter::RobustProfileRouter(const Graph& graph,
+                                         const EdgeFunc<num>& costs,
+                                         const EdgeFunc<num>& deviations,
+                                         idx deviationSize,
+                                         const RobustContractionHierarchy& hierarchy)
+  : RobustRouter(graph, costs, deviations, deviationSize),
+    hierarchy(hierarchy)
+{
+}
+
+RobustSearchResult RobustProfileRouter::shortestPath(Vertex source,
+                                                     Vertex target,
+                                                     const ValueVector& possibleValues,
+                                                     num bound)
+{
+  Search search(hierarchy, possibleValues, deviationSize, true, bound);
+
+  search.run(source, target);
+
+  RobustSearchResult result;
+
+  result.calls = 1;
+  result.settled = search.settled;
+  result.labeled = search.labeled;
+
+  if(search.meetingIndex == NONE)
+  {
+    return result;
+  }
+
+  result.numFound = 1;
+  result.found = true;
+  result.path = hierarchy.getShortcuts().unpack(search.collectShortcuts());
+
+  assert(result.path.connects(source, target));
+
+  return result;
+}
+
+RobustProfile RobustProfileRouter::profile(Vertex source,
+                                           Vertex target,
+                                           const ValueVector& possibleValues)
+{
+  Search search(hierarchy, possibleValues, deviationSize, false, inf);
+
+  search.run(source, target);
+
+  RobustProfile result(possibleValues);
+  result.distances = search.getBest();
+
+  return result;
+}
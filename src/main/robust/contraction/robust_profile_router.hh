@@ -0,0 +1,79 @@
+#ifndef ROBUST_PROFILE_ROUTER_HH
+#define ROBUST_PROFILE_ROUTER_HH
+
+#include "robust/robust_router.hh"
+
+#include "robust_contraction_hierarchy.hh"
+
+/**
+ * The distances between a source and a target as a function
+ * of theta. The function is piecewise linear with breakpoints
+ * at the theta values, it is therefore represented by its
+ * values at the given theta values.
+ **/
+class RobustProfile
+{
+public:
+  RobustProfile(const ValueVector& values)
+    : values(values),
+      distances(values.size(), inf)
+  {}
+
+  ValueVector values;
+  std::vector<num> distances;
+
+  /**
+   * Returns the index of the theta value minimizing
+   * \f$ \Gamma \theta + d_{\theta}(s, t) \f$, or
+   * the number of values if the target is unreachable.
+   **/
+  idx optimalIndex(idx deviationSize) const;
+};
+
+/**
+ * A RobustRouter performing a single bidirectional profile search
+ * on a RobustContractionHierarchy instead of one search per theta
+ * value. The labels carry the distances with respect to all theta
+ * values at once, an arc updates all components for which it is
+ * contained in the hierarchy. Since the search is label-correcting,
+ * vertices may be scanned several times.
+ *
+ * The key of a label is the minimum of \f$ \Gamma \theta + d_{\theta} \f$
+ * over its components, which bounds the robust cost of every path
+ * through the labeled vertex from below. The search stops as soon as
+ * both keys exceed the best robust cost found, components which
+ * exceed it are pruned. The Path is extracted directly from
+ * the parents stored for the optimal component.
+ **/
+class RobustProfileRouter : public RobustRouter
+{
+private:
+  const RobustContractionHierarchy& hierarchy;
+
+  class Search;
+
+public:
+  RobustProfileRouter(const Graph& graph,
+                      const EdgeFunc<num>& costs,
+                      const EdgeFunc<num>& deviations,
+                      idx deviationSize,
+                      const RobustContractionHierarchy& hierarchy);
+
+  using RobustRouter::shortestPath;
+
+  RobustSearchResult shortestPath(Vertex source,
+                                  Vertex target,
+                                  const ValueVector& possibleValues,
+                                  num bound) override;
+
+  /**
+   * Computes the complete profile of distances between the
+   * given source and target with respect to the given
+   * theta values.
+   **/
+  RobustProfile profile(Vertex source,
+                        Vertex target,
+                        const ValueVector& possibleValues);
+};
+
+#endif /* ROBUST_PROFILE_ROUTER_HH */
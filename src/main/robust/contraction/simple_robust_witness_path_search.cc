@@ -2,7 +2,6 @@
 
 #include <cassert>
 
-#include "router/bidirectional_router.hh"
 
 #include "robust_search_predicate.hh"
 
@@ -46,6 +45,8 @@ void SimpleRobustWitnessPathSearch::findPair(const Vertex vertex,
   const Path defaultPath{incoming, outgoing};
   Path lastPath;
 
+  WitnessSearch& search = searches.local();
+
   for(it = begin; it != end; ++it)
   {
     const num value = *it;
@@ -53,7 +54,6 @@ void SimpleRobustWitnessPathSearch::findPair(const Vertex vertex,
 
     const num upperBound = defaultPath.cost(reducedCosts);
 
-    BidirectionalRouter router(graph);
     RobustSearchPredicate predicate(contracted, contractionRanges, vertex, value);
 
     if(lastPath)
@@ -67,27 +67,21 @@ void SimpleRobustWitnessPathSearch::findPair(const Vertex vertex,
       }
     }
 
-    auto result = router.shortestPath<RobustSearchPredicate,
-                                      RobustSearchPredicate,
-                                      true>(source,
-                                            target,
-                                            reducedCosts,
-                                            predicate,
-                                            predicate,
-                                            upperBound);
+    search.start(source);
 
-    if(result.found)
-    {
-      assert(result.path.connects(source, target));
-      assert(result.path.cost(reducedCosts) <= upperBound);
-      assert(result.path.satisfies(predicate));
-    }
-    else
+    if(!search.search<Direction::OUTGOING>(target,
+                                           upperBound,
+                                           predicate,
+                                           reducedCosts))
     {
       break;
     }
 
-    lastPath = result.path;
+    lastPath = search.getPath<Direction::OUTGOING>(target);
+
+    assert(lastPath.connects(source, target));
+    assert(lastPath.cost(reducedCosts) <= upperBound);
+    assert(lastPath.satisfies(predicate));
   }
 
   // witness paths were found for *all* values
@@ -108,7 +102,6 @@ void SimpleRobustWitnessPathSearch::findPair(const Vertex vertex,
 
     const num upperBound = defaultPath.cost(reducedCosts);
 
-    BidirectionalRouter router(graph);
     RobustSearchPredicate predicate(contracted, contractionRanges, vertex, value);
 
     if(lastPath)
@@ -122,27 +115,21 @@ void SimpleRobustWitnessPathSearch::findPair(const Vertex vertex,
       }
     }
 
-    auto result = router.shortestPath<RobustSearchPredicate,
-                                      RobustSearchPredicate,
-                                      true>(source,
-                                            target,
-                                            reducedCosts,
-                                            predicate,
-                                            predicate,
-                                            upperBound);
+    search.start(source);
 
-    if(result.found)
-    {
-      assert(result.path.connects(source, target));
-      assert(result.path.cost(reducedCosts) <= upperBound);
-      assert(result.path.satisfies(predicate));
-    }
-    else
+    if(!search.search<Direction::OUTGOING>(target,
+                                           upperBound,
+                                           predicate,
+                                           reducedCosts))
     {
       break;
     }
 
-    lastPath = result.path;
+    lastPath = search.getPath<Direction::OUTGOING>(target);
+
+    assert(lastPath.connects(source, target));
+    assert(lastPath.cost(reducedCosts) <= upperBound);
+    assert(lastPath.satisfies(predicate));
   }
 
   assert(rit <= rend);
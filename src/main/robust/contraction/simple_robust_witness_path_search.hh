@@ -1,12 +1,17 @@
 #ifndef SIMPLE_ROBUST_WITNESS_PATH_SEARCH_HH
 #define SIMPLE_ROBUST_WITNESS_PATH_SEARCH_HH
 
+#include <tbb/enumerable_thread_specific.h>
+
+#include "contraction/witness_search.hh"
+
 #include "robust_witness_path_search.hh"
 #include "robust_contraction_preprocessor.hh"
 
 class SimpleRobustWitnessPathSearch : public RobustWitnessPathSearch
 {
 private:
+  mutable tbb::enumerable_thread_specific<WitnessSearch> searches;
 
   template <class OutIt>
   void findPair(const Vertex vertex,
@@ -18,8 +23,14 @@ public:
   SimpleRobustWitnessPathSearch(const Graph& graph,
                                 const EdgeFunc<const ContractionRange&>& contractionRanges,
                                 const ValueVector& values,
-                                const VertexFunc<bool>& contracted)
-    : RobustWitnessPathSearch(graph, contractionRanges, values, contracted)
+                                const VertexFunc<bool>& contracted,
+                                idx settleLimit = 0,
+                                idx hopLimit = 0)
+    : RobustWitnessPathSearch(graph, contractionRanges, values, contracted),
+      searches([&graph, settleLimit, hopLimit]()
+               {
+                 return WitnessSearch(graph, settleLimit, hopLimit);
+               })
   {}
 
   virtual std::vector<RobustContractionPair> findPairs(Vertex vertex) const override;
@@ -122,6 +122,18 @@ DiscardingPreprocessor::DiscardingPreprocessor(const Graph& graph,
 }
 
 
+MemoryUsage DiscardingPreprocessor::memoryUsage() const
+{
+  return MemoryUsage("DiscardingPreprocessor")
+    .add("valueEdges", heapUsage(valueEdges))
+    .add("bestValues", heapUsage(bestValues))
+    .add(distances.memoryUsage("distances"))
+    .add(MemoryUsage("outgoingFlags")
+         .add(arcFlags.get<Direction::OUTGOING>().memoryUsage()))
+    .add(MemoryUsage("incomingFlags")
+         .add(arcFlags.get<Direction::INCOMING>().memoryUsage()));
+}
+
 bool DiscardingPreprocessor::canDiscard(Vertex source,
                                         Vertex target,
                                         num value,
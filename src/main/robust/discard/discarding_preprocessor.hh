@@ -52,6 +52,12 @@ public:
   {
     return partition;
   }
+
+  /**
+   * Returns the memory used by the distances between the
+   * Region%s, the arc flags and the value tables.
+   **/
+  MemoryUsage memoryUsage() const;
 };
 
 #endif /* DISCARDING_PREPROCESSOR_HH */
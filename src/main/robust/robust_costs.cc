@@ -1,6 +1,7 @@
 #include "robust_costs.hh"
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <queue>
 
@@ -76,6 +77,26 @@ num RobustCosts::get(const Path& path)
   return sum;
 }
 
+num RobustCosts::optimalValue(const Path& path)
+{
+  if(path.getEdges().size() <= deviationSize or deviationSize == 0)
+  {
+    return 0;
+  }
+
+  std::vector<num> values;
+
+  for(const Edge& edge : path.getEdges())
+  {
+    values.push_back(deviations(edge));
+  }
+
+  auto it = values.begin() + (deviationSize - 1);
+
+  std::nth_element(values.begin(), it, values.end(), std::greater<num>());
+
+  return *it;
+}
 
 num RobustCosts::optimalCost(const Path& path,
                              const ValueVector& values)
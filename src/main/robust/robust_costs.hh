@@ -47,6 +47,13 @@ public:
 
   num optimalCost(const Path& path,
                   const ValueVector& values);
+
+  /**
+   * Returns a theta value attaining the robust costs of
+   * the given Path, i.e., the \f$ \Gamma \f$-th largest
+   * deviation along the Path (or zero for shorter Path%s).
+   **/
+  num optimalValue(const Path& path);
 };
 
 
@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <functional>
 
+#include "robust_costs.hh"
+
 void RobustSearchResult::add(const SearchResult& other)
 {
   ++calls;
@@ -16,3 +18,41 @@ RobustSearchResult RobustRouter::shortestPath(Vertex source, Vertex target)
 {
   return shortestPath(source, target, inf);
 }
+
+RobustCostMatrix RobustRouter::shortestPaths(const std::vector<Vertex>& sources,
+                                             const std::vector<Vertex>& targets,
+                                             const ValueVector& possibleValues,
+                                             bool computePaths)
+{
+  RobustCostMatrix matrix(sources, targets);
+  RobustCosts robustCosts(costs, deviations, deviationSize);
+
+  for(idx i = 0; i < sources.size(); ++i)
+  {
+    for(idx j = 0; j < targets.size(); ++j)
+    {
+      RobustSearchResult searchResult = shortestPath(sources[i],
+                                                     targets[j],
+                                                     possibleValues,
+                                                     inf);
+
+      if(!searchResult.found)
+      {
+        continue;
+      }
+
+      RobustTargetResult& result = matrix.get(i, j);
+
+      result.found = true;
+      result.cost = robustCosts.get(searchResult.path);
+      result.value = robustCosts.optimalValue(searchResult.path);
+
+      if(computePaths)
+      {
+        result.path = searchResult.path;
+      }
+    }
+  }
+
+  return matrix;
+}
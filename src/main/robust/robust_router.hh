@@ -24,7 +24,8 @@ public:
       settled(settled),
       labeled(labeled),
       found(found),
-      path(path)
+      path(path),
+      gap(0)
   {}
 
   RobustSearchResult()
@@ -32,7 +33,8 @@ public:
       numFound(0),
       settled(0),
       labeled(0),
-      found(false)
+      found(false),
+      gap(0)
   {}
 
   idx calls;
@@ -42,9 +44,84 @@ public:
   bool found;
   Path path;
 
+  /**
+   * An upper bound on the difference between the robust cost
+   * of the Path and the optimal robust cost. The gap is zero
+   * unless the search was performed in an approximation mode.
+   **/
+  num gap;
+
   void add(const SearchResult& other);
 };
 
+/**
+ * The result of a robust search towards one of
+ * several targets: The robust cost of the best Path
+ * found, the theta value attaining it, and (optionally)
+ * the Path itself.
+ **/
+class RobustTargetResult
+{
+public:
+  RobustTargetResult()
+    : found(false),
+      cost(inf),
+      value(0)
+  {}
+
+  bool found;
+  num cost;
+  num value;
+  Path path;
+};
+
+/**
+ * A matrix of RobustTargetResult%s, one for
+ * each pair of a source and a target.
+ **/
+class RobustCostMatrix
+{
+private:
+  std::vector<Vertex> sources, targets;
+  std::vector<RobustTargetResult> results;
+
+public:
+  RobustCostMatrix(const std::vector<Vertex>& sources,
+                   const std::vector<Vertex>& targets)
+    : sources(sources),
+      targets(targets),
+      results(sources.size() * targets.size())
+  {}
+
+  const std::vector<Vertex>& getSources() const
+  {
+    return sources;
+  }
+
+  const std::vector<Vertex>& getTargets() const
+  {
+    return targets;
+  }
+
+  /**
+   * Returns the result for the i-th source and the j-th target.
+   **/
+  const RobustTargetResult& get(idx i, idx j) const
+  {
+    return results[i * targets.size() + j];
+  }
+
+  RobustTargetResult& get(idx i, idx j)
+  {
+    return results[i * targets.size() + j];
+  }
+
+  num getCost(idx i, idx j) const
+  {
+    return get(i, j).cost;
+  }
+};
+
 
 /**
  * A base class for all robust shortest path algorithms.
@@ -110,6 +187,29 @@ public:
   {
     return shortestPath(source, target, values, bound);
   }
+
+  /**
+   * Computes the robust costs (and optionally paths) between
+   * all pairs of the given sources and targets. The default
+   * implementation issues one query per pair, subclasses
+   * may share work between the pairs.
+   *
+   * @param sources        The source vertices.
+   * @param targets        The target vertices.
+   * @param possibleValues The theta values which can occur.
+   * @param computePaths   Whether to compute the Path%s as well.
+   **/
+  virtual RobustCostMatrix shortestPaths(const std::vector<Vertex>& sources,
+                                         const std::vector<Vertex>& targets,
+                                         const ValueVector& possibleValues,
+                                         bool computePaths = true);
+
+  RobustCostMatrix shortestPaths(const std::vector<Vertex>& sources,
+                                 const std::vector<Vertex>& targets,
+                                 bool computePaths = true)
+  {
+    return shortestPaths(sources, targets, values, computePaths);
+  }
 };
 
 #endif /* ROBUST_ROUTER_HH */
@@ -1,6 +1,7 @@
 #include "robust_utils.hh"
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 
 template class std::vector<num>;
@@ -33,3 +34,33 @@ ValueVector thetaValues(const Graph& graph,
 
   return values;
 }
+
+ValueVector approximateValues(const ValueVector& values,
+                              float epsilon)
+{
+  assert(epsilon >= 0);
+
+  ValueVector result;
+
+  if(values.empty())
+  {
+    return result;
+  }
+
+  auto it = values.begin();
+  result.push_back(*it);
+
+  while(++it != values.end())
+  {
+    const float threshold = result.back() / (1 + epsilon);
+
+    while((it + 1) != values.end() and *(it + 1) >= threshold)
+    {
+      ++it;
+    }
+
+    result.push_back(*it);
+  }
+
+  return result;
+}
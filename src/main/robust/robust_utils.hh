@@ -30,6 +30,25 @@ extern template class std::vector<ValueVector>;
 ValueVector thetaValues(const Graph& graph,
                         const EdgeFunc<num>& deviations);
 
+/**
+ * Coarsens the given theta values (sorted strictly descending)
+ * into geometric buckets: Each retained value is at least the
+ * previous one divided by (1 + epsilon), unless no values lie
+ * between them. The first and the last value are always
+ * retained.
+ *
+ * Since the path costs with respect to theta are non-increasing
+ * in theta, evaluating the retained values yields a robust cost
+ * within a factor of (1 + epsilon) of the optimum.
+ *
+ * @param values   The theta values
+ * @param epsilon  The (non-negative) approximation factor
+ *
+ * @return The retained values, sorted strictly descending.
+ */
+ValueVector approximateValues(const ValueVector& values,
+                              float epsilon);
+
 typedef ValueVector::const_iterator ValueIterator;
 
 typedef std::reverse_iterator<ValueIterator> ReverseValueIterator;
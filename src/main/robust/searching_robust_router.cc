@@ -18,7 +18,8 @@ SearchingRobustRouter::SearchingRobustRouter(const Graph& graph,
   : RobustRouter(graph, costs, deviations, deviationSize),
     router(router),
     options(options),
-    intervalSelection(LOWEST_BOUND)
+    intervalSelection(LOWEST_BOUND),
+    epsilon(0)
 {
 
 }
@@ -33,6 +34,10 @@ RobustSearchResult SearchingRobustRouter::shortestPath(Vertex source,
   bool found = false;
   RobustSearchResult robustSearchResult;
 
+  // a lower bound on the objective within the intervals
+  // which were not refined due to the approximation factor
+  num lowerBound = inf;
+
   auto evaluate = [&] (num value) -> num
     {
       const num costBound = getBound(bound, bestCost, value);
@@ -97,6 +102,12 @@ RobustSearchResult SearchingRobustRouter::shortestPath(Vertex source,
       continue;
     }
 
+    if(epsilon > 0 and interval.lowerBoundCost * (1 + epsilon) >= bestCost)
+    {
+      lowerBound = std::min(lowerBound, interval.lowerBoundCost);
+      continue;
+    }
+
     if(options & TIGHTENING)
     {
       if(interval.tighten(bestCost, deviationSize))
@@ -123,6 +134,11 @@ RobustSearchResult SearchingRobustRouter::shortestPath(Vertex source,
   {
     robustSearchResult.found = true;
     robustSearchResult.path = bestPath;
+
+    if(lowerBound < bestCost)
+    {
+      robustSearchResult.gap = bestCost - lowerBound;
+    }
   }
 
   return robustSearchResult;
@@ -177,3 +193,14 @@ num SearchingRobustRouter::getBound(num bound, num bestCost, num value)
     std::min(bound, bestCost - ((num) deviationSize) * value) :
     bound;
 }
+
+float SearchingRobustRouter::getEpsilon() const
+{
+  return epsilon;
+}
+
+void SearchingRobustRouter::setEpsilon(float epsilon)
+{
+  assert(epsilon >= 0);
+  this->epsilon = epsilon;
+}
@@ -63,6 +63,7 @@ protected:
   ThetaRouter& router;
   Options options;
   IntervalSelection intervalSelection;
+  float epsilon;
 
   bool verifyResult(const SearchResult& simpleResult,
                     Vertex source,
@@ -90,6 +91,15 @@ public:
 
   bool doesTightenIntervals() const;
   void setTightenIntervals(bool tightenIntervals);
+
+  /**
+   * Returns the approximation factor. If it is positive, intervals
+   * whose lower bound is within a factor of (1 + epsilon) of the
+   * best robust cost found so far are not refined any further. The
+   * RobustSearchResult reports the resulting (certified) gap.
+   **/
+  float getEpsilon() const;
+  void setEpsilon(float epsilon);
 };
 
 #endif /* SEARCHING_ROBUST_ROUTER_HH */
@@ -1,6 +1,7 @@
 #include "simple_robust_router.hh"
 
 #include <algorithm>
+#include <cassert>
 #include <functional>
 #include <iostream>
 
@@ -15,7 +16,8 @@ SimpleRobustRouter::SimpleRobustRouter(const Graph& graph,
                                        bool useBounds)
   : RobustRouter(graph, costs, deviations, deviationSize),
     useBounds(useBounds),
-    router(router)
+    router(router),
+    epsilon(0)
 {
 }
 
@@ -30,7 +32,27 @@ RobustSearchResult SimpleRobustRouter::shortestPath(Vertex source,
 
   RobustSearchResult robustSearchResult;
 
-  for(num value : possibleValues)
+  const bool approximate = epsilon > 0;
+
+  ValueVector approximatedValues;
+
+  if(approximate)
+  {
+    approximatedValues = approximateValues(possibleValues, epsilon);
+  }
+
+  const ValueVector& values = approximate ?
+    approximatedValues :
+    possibleValues;
+
+  // a lower bound on the objective for the skipped values
+  num lowerBound = inf;
+
+  // a lower bound on the path cost with respect to the previous value
+  num previousPathCost = inf;
+  auto previous = possibleValues.begin();
+
+  for(num value : values)
   {
     const num upperBound = getBound(bound, bestCost, value);
 
@@ -39,6 +61,28 @@ RobustSearchResult SimpleRobustRouter::shortestPath(Vertex source,
 
     robustSearchResult.add(result);
 
+    if(approximate)
+    {
+      auto current = std::find(previous, possibleValues.end(), value);
+
+      // path costs are non-increasing in theta
+      if(std::distance(previous, current) > 1 and previousPathCost != inf)
+      {
+        const num offset = ((num) deviationSize) * value;
+
+        // the cost bound of a failed search may be close to inf
+        if(previousPathCost < inf - offset)
+        {
+          lowerBound = std::min(lowerBound, previousPathCost + offset);
+        }
+      }
+
+      previous = current;
+      previousPathCost = result.found ?
+        result.cost :
+        std::max(upperBound, (num) 0);
+    }
+
     if(!result.found)
     {
       continue;
@@ -58,6 +102,11 @@ RobustSearchResult SimpleRobustRouter::shortestPath(Vertex source,
   robustSearchResult.found = found;
   robustSearchResult.path = bestPath;
 
+  if(found and lowerBound < bestCost)
+  {
+    robustSearchResult.gap = bestCost - lowerBound;
+  }
+
   return robustSearchResult;
 }
 
@@ -75,3 +124,14 @@ num SimpleRobustRouter::getBound(num bound, num bestCost, num value)
 {
   return useBounds ? std::min(bound, bestCost - ((num) deviationSize) * value) : bound;
 }
+
+float SimpleRobustRouter::getEpsilon() const
+{
+  return epsilon;
+}
+
+void SimpleRobustRouter::setEpsilon(float epsilon)
+{
+  assert(epsilon >= 0);
+  this->epsilon = epsilon;
+}
@@ -12,6 +12,7 @@ private:
 
   bool useBounds;
   ThetaRouter& router;
+  float epsilon;
 
 public:
   SimpleRobustRouter(const Graph& graph,
@@ -30,6 +31,16 @@ public:
 
   bool doesUseBounds() const;
   void setUseBounds(bool useBounds);
+
+  /**
+   * Returns the approximation factor. If it is positive,
+   * only the values retained by approximateValues() are
+   * evaluated and the RobustSearchResult reports a certified
+   * gap of at most epsilon / (1 + epsilon) times the robust
+   * cost of the Path found.
+   **/
+  float getEpsilon() const;
+  void setEpsilon(float epsilon);
 };
 
 #endif /* SIMPLE_ROBUST_ROUTER_HH */
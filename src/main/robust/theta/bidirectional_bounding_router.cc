@@ -18,8 +18,8 @@ BidirectionalBoundingRouter::BidirectionalBoundingRouter(const Graph& graph,
 
 void BidirectionalBoundingRouter::doReset()
 {
-  forwardBounds.reset(inf);
-  backwardBounds.reset(inf);
+  forwardBounds.reset();
+  backwardBounds.reset();
 }
 
 
@@ -86,7 +86,7 @@ BidirectionalBoundingRouter::findShortestPath(Vertex source,
         }
         else
         {
-          forwardBounds(nextVertex) = costBound;
+          forwardBounds.setValue(nextVertex, costBound);
         }
 
         forwardHeap.update(Label(nextVertex, edge, nextCost));
@@ -126,7 +126,7 @@ BidirectionalBoundingRouter::findShortestPath(Vertex source,
         }
         else
         {
-          backwardBounds(nextVertex) = costBound;
+          backwardBounds.setValue(nextVertex, costBound);
         }
 
         backwardHeap.update(Label(nextVertex, edge, nextCost));
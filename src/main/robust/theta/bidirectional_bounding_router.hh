@@ -1,6 +1,8 @@
 #ifndef BIDIRECTIONAL_BOUNDING_ROUTER_HH
 #define BIDIRECTIONAL_BOUNDING_ROUTER_HH
 
+#include "graph/sparse_vertex_map.hh"
+
 #include "stateful_theta_router.hh"
 
 class BidirectionalBoundingRouter : public StatefulThetaRouter
@@ -10,7 +12,7 @@ private:
   const EdgeFunc<num>& costs;
   const EdgeFunc<num>& deviations;
   const idx deviationSize;
-  VertexMap<num> forwardBounds, backwardBounds;
+  SparseVertexMap<num> forwardBounds, backwardBounds;
 
   template <bool bounded>
   SearchResult findShortestPath(Vertex source,
@@ -20,7 +20,7 @@ BoundingRouter::BoundingRouter(const Graph& graph,
 
 void BoundingRouter::doReset()
 {
-  upperBounds.reset(inf);
+  upperBounds.reset();
 }
 
 template <bool bounded>
@@ -77,7 +77,7 @@ SearchResult BoundingRouter::findShortestPath(Vertex source,
       }
       else
       {
-        upperBounds(nextVertex) = costBound;
+        upperBounds.setValue(nextVertex, costBound);
       }
 
       heap.update(nextLabel);
@@ -90,6 +90,7 @@ SearchResult BoundingRouter::findShortestPath(Vertex source,
     Path path;
 
     Label current = heap.getLabel(target);
+    const num cost = current.getCost();
 
     while(!(current.getVertex() == source))
     {
@@ -98,7 +99,7 @@ SearchResult BoundingRouter::findShortestPath(Vertex source,
       current = heap.getLabel(edge.getSource());
     }
 
-    return SearchResult(settled, labeled, true, path, current.getCost());
+    return SearchResult(settled, labeled, true, path, cost);
   }
 
   return SearchResult::notFound(settled, labeled);
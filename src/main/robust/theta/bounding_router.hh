@@ -1,6 +1,8 @@
 #ifndef BOUNDING_ROUTER_HH
 #define BOUNDING_ROUTER_HH
 
+#include "graph/sparse_vertex_map.hh"
+
 #include "stateful_theta_router.hh"
 
 /**
@@ -19,7 +21,7 @@ private:
   const EdgeFunc<num>& costs;
   const EdgeFunc<num>& deviations;
   const idx deviationSize;
-  VertexMap<num> upperBounds;
+  SparseVertexMap<num> upperBounds;
 
   template <bool bounded>
   SearchResult findShortestPath(Vertex source,
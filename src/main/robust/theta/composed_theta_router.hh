@@ -0,0 +1,430 @@
+#ifndef COMPOSED_THETA_ROUTER_HH
+#define COMPOSED_THETA_ROUTER_HH
+
+#include <cassert>
+
+#include "graph/graph.hh"
+
+#include "router/label.hh"
+#include "router/label_heap.hh"
+
+#include "robust/reduced_costs.hh"
+
+#include "theta_policies.hh"
+#include "theta_router.hh"
+
+/**
+ * A ThetaRouter combining an edge filter policy, a potential
+ * policy and a pruning policy (@see theta_policies.hh) in
+ * a single unidirectional search, all of which are resolved
+ * at compile time. For instance, the combination of
+ * ArcFlagEdgeFilter, ContractionGoalPotential and
+ * UpperBoundPruning restricts a goal-directed search
+ * to the Edge%s flagged for the target Region.
+ *
+ * Attention: Depending on its policies, this router is
+ * *stateful* and therefore not reentrant.
+ **/
+template <class FilterPolicy, class PotentialPolicy, class PruningPolicy>
+class ComposedThetaRouter : public ThetaRouter
+{
+private:
+  const Graph& graph;
+  const EdgeFunc<num>& costs;
+  const EdgeFunc<num>& deviations;
+  const idx deviationSize;
+
+  FilterPolicy filterPolicy;
+  PotentialPolicy potentialPolicy;
+  PruningPolicy pruningPolicy;
+
+  template <bool bounded>
+  SearchResult findShortestPath(Vertex source,
+                                Vertex target,
+                                num theta,
+                                num bound);
+
+public:
+  ComposedThetaRouter(const Graph& graph,
+                      const EdgeFunc<num>& costs,
+                      const EdgeFunc<num>& deviations,
+                      idx deviationSize,
+                      FilterPolicy filterPolicy,
+                      PotentialPolicy potentialPolicy,
+                      PruningPolicy pruningPolicy)
+    : graph(graph),
+      costs(costs),
+      deviations(deviations),
+      deviationSize(deviationSize),
+      filterPolicy(std::move(filterPolicy)),
+      potentialPolicy(std::move(potentialPolicy)),
+      pruningPolicy(std::move(pruningPolicy))
+  {}
+
+  /**
+   * Constructs a router whose policies are
+   * constructed from the Graph alone.
+   **/
+  ComposedThetaRouter(const Graph& graph,
+                      const EdgeFunc<num>& costs,
+                      const EdgeFunc<num>& deviations,
+                      idx deviationSize)
+    : ComposedThetaRouter(graph,
+                          costs,
+                          deviations,
+                          deviationSize,
+                          FilterPolicy(graph),
+                          PotentialPolicy(graph),
+                          PruningPolicy(graph))
+  {}
+
+  SearchResult shortestPath(Vertex source,
+                            Vertex target,
+                            num theta,
+                            num bound) override
+  {
+    return findShortestPath<true>(source, target, theta, bound);
+  }
+
+  SearchResult shortestPath(Vertex source,
+                            Vertex target,
+                            num theta) override
+  {
+    return findShortestPath<false>(source, target, theta, inf);
+  }
+};
+
+template <class FilterPolicy, class PotentialPolicy, class PruningPolicy>
+template <bool bounded>
+SearchResult
+ComposedThetaRouter<FilterPolicy, PotentialPolicy, PruningPolicy>::findShortestPath(Vertex source,
+                                                                                    Vertex target,
+                                                                                    num theta,
+                                                                                    num bound)
+{
+  if(source == target)
+  {
+    return SearchResult(0, 0, true, Path(), 0);
+  }
+
+  potentialPolicy.prepare(source, target, theta);
+  pruningPolicy.prepare(source, target, theta);
+
+  const num sourcePotential = potentialPolicy(source);
+
+  if(sourcePotential == inf)
+  {
+    return SearchResult::notFound(0, 0);
+  }
+
+  const typename FilterPolicy::Filter filter = filterPolicy.forward(source,
+                                                                    target,
+                                                                    theta);
+
+  ReducedCosts reducedCosts(costs, deviations, theta);
+
+  // the labels are keyed by the distance plus the potential
+  LabelHeap<Label> heap(graph);
+  int settled = 0, labeled = 0;
+  bool found = false;
+
+  heap.update(Label(source, Edge(), sourcePotential));
+
+  while(!heap.isEmpty())
+  {
+    const Label& current = heap.extractMin();
+    const Vertex currentVertex = current.getVertex();
+
+    ++settled;
+
+    if(bounded and current.getCost() > bound)
+    {
+      break;
+    }
+
+    if(currentVertex == target)
+    {
+      found = true;
+      break;
+    }
+
+    const num distance = current.getCost() - potentialPolicy(currentVertex);
+
+    for(const Edge& edge : graph.getOutgoing(currentVertex))
+    {
+      if(!filter(edge))
+      {
+        continue;
+      }
+
+      const Vertex nextVertex = edge.getTarget();
+      const num nextPotential = potentialPolicy(nextVertex);
+
+      if(nextPotential == inf)
+      {
+        continue;
+      }
+
+      ++labeled;
+
+      const num nextDistance = distance + reducedCosts(edge);
+
+      if(pruningPolicy.prune(nextVertex, deviationSize * theta + nextDistance))
+      {
+        continue;
+      }
+
+      heap.update(Label(nextVertex, edge, nextDistance + nextPotential));
+    }
+  }
+
+  if(found)
+  {
+    Path path;
+
+    Label current = heap.getLabel(target);
+    const num cost = current.getCost() - potentialPolicy(target);
+
+    while(!(current.getVertex() == source))
+    {
+      Edge edge = current.getEdge();
+      path.prepend(edge);
+      current = heap.getLabel(edge.getSource());
+    }
+
+    assert(path.cost(reducedCosts) == cost);
+
+    return SearchResult(settled, labeled, true, path, cost);
+  }
+
+  return SearchResult::notFound(settled, labeled);
+}
+
+/**
+ * The bidirectional counterpart of the ComposedThetaRouter,
+ * which combines an edge filter policy with a pruning policy.
+ * Each of the searches uses its own PruningPolicy.
+ *
+ * Attention: Depending on its policies, this router is
+ * *stateful* and therefore not reentrant.
+ **/
+template <class FilterPolicy, class PruningPolicy>
+class BidirectionalComposedThetaRouter : public ThetaRouter
+{
+private:
+  const Graph& graph;
+  const EdgeFunc<num>& costs;
+  const EdgeFunc<num>& deviations;
+  const idx deviationSize;
+
+  FilterPolicy filterPolicy;
+  PruningPolicy forwardPruning, backwardPruning;
+
+  template <bool bounded>
+  SearchResult findShortestPath(Vertex source,
+                                Vertex target,
+                                num theta,
+                                num bound);
+
+public:
+  BidirectionalComposedThetaRouter(const Graph& graph,
+                                   const EdgeFunc<num>& costs,
+                                   const EdgeFunc<num>& deviations,
+                                   idx deviationSize,
+                                   FilterPolicy filterPolicy,
+                                   PruningPolicy forwardPruning,
+                                   PruningPolicy backwardPruning)
+    : graph(graph),
+      costs(costs),
+      deviations(deviations),
+      deviationSize(deviationSize),
+      filterPolicy(std::move(filterPolicy)),
+      forwardPruning(std::move(forwardPruning)),
+      backwardPruning(std::move(backwardPruning))
+  {}
+
+  /**
+   * Constructs a router whose policies are
+   * constructed from the Graph alone.
+   **/
+  BidirectionalComposedThetaRouter(const Graph& graph,
+                                   const EdgeFunc<num>& costs,
+                                   const EdgeFunc<num>& deviations,
+                                   idx deviationSize)
+    : BidirectionalComposedThetaRouter(graph,
+                                       costs,
+                                       deviations,
+                                       deviationSize,
+                                       FilterPolicy(graph),
+                                       PruningPolicy(graph),
+                                       PruningPolicy(graph))
+  {}
+
+  SearchResult shortestPath(Vertex source,
+                            Vertex target,
+                            num theta,
+                            num bound) override
+  {
+    return findShortestPath<true>(source, target, theta, bound);
+  }
+
+  SearchResult shortestPath(Vertex source,
+                            Vertex target,
+                            num theta) override
+  {
+    return findShortestPath<false>(source, target, theta, inf);
+  }
+};
+
+template <class FilterPolicy, class PruningPolicy>
+template <bool bounded>
+SearchResult
+BidirectionalComposedThetaRouter<FilterPolicy, PruningPolicy>::findShortestPath(Vertex source,
+                                                                                Vertex target,
+                                                                                num theta,
+                                                                                num bound)
+{
+  if(source == target)
+  {
+    return SearchResult(0, 0, true, Path(), 0);
+  }
+
+  forwardPruning.prepare(source, target, theta);
+  backwardPruning.prepare(source, target, theta);
+
+  const typename FilterPolicy::Filter forwardFilter =
+    filterPolicy.forward(source, target, theta);
+
+  const typename FilterPolicy::Filter backwardFilter =
+    filterPolicy.backward(source, target, theta);
+
+  ReducedCosts reducedCosts(costs, deviations, theta);
+
+  int settled = 0, labeled = 0;
+  bool found = false;
+
+  Vertex split;
+  num splitValue = inf;
+
+  LabelHeap<Label> forwardHeap(graph);
+  LabelHeap<Label> backwardHeap(graph);
+
+  forwardHeap.update(Label(source, Edge(), 0));
+  backwardHeap.update(Label(target, Edge(), 0));
+
+  auto relax = [&](const Edge& edge,
+                   Vertex nextVertex,
+                   num nextCost,
+                   PruningPolicy& pruning,
+                   LabelHeap<Label>& heap,
+                   const LabelHeap<Label>& otherHeap)
+    {
+      ++labeled;
+
+      if(pruning.prune(nextVertex, deviationSize * theta + nextCost))
+      {
+        return;
+      }
+
+      heap.update(Label(nextVertex, edge, nextCost));
+
+      const Label& other = otherHeap.getLabel(nextVertex);
+
+      if(other.getState() != State::UNKNOWN)
+      {
+        const num value = other.getCost() + nextCost;
+
+        if(value < splitValue)
+        {
+          splitValue = value;
+          split = nextVertex;
+          found = true;
+        }
+      }
+    };
+
+  while(!(forwardHeap.isEmpty() or backwardHeap.isEmpty()))
+  {
+    const num bestValue = forwardHeap.peek().getCost()
+      + backwardHeap.peek().getCost();
+
+    if(bestValue >= splitValue)
+    {
+      break;
+    }
+
+    if(bounded and bestValue > bound)
+    {
+      break;
+    }
+
+    ++settled;
+
+    if(forwardHeap.peek().getCost() < backwardHeap.peek().getCost())
+    {
+      const Label current = forwardHeap.extractMin();
+
+      for(const Edge& edge : graph.getOutgoing(current.getVertex()))
+      {
+        if(forwardFilter(edge))
+        {
+          relax(edge,
+                edge.getTarget(),
+                current.getCost() + reducedCosts(edge),
+                forwardPruning,
+                forwardHeap,
+                backwardHeap);
+        }
+      }
+    }
+    else
+    {
+      const Label current = backwardHeap.extractMin();
+
+      for(const Edge& edge : graph.getIncoming(current.getVertex()))
+      {
+        if(backwardFilter(edge))
+        {
+          relax(edge,
+                edge.getSource(),
+                current.getCost() + reducedCosts(edge),
+                backwardPruning,
+                backwardHeap,
+                forwardHeap);
+        }
+      }
+    }
+  }
+
+  if(!found or (bounded and splitValue > bound))
+  {
+    return SearchResult::notFound(settled, labeled);
+  }
+
+  Path path;
+
+  Label current = forwardHeap.getLabel(split);
+
+  while(!(current.getVertex() == source))
+  {
+    Edge edge = current.getEdge();
+    path.prepend(edge);
+    current = forwardHeap.getLabel(edge.getSource());
+  }
+
+  current = backwardHeap.getLabel(split);
+
+  while(!(current.getVertex() == target))
+  {
+    Edge edge = current.getEdge();
+    path.append(edge);
+    current = backwardHeap.getLabel(edge.getTarget());
+  }
+
+  assert(path.connects(source, target));
+  assert(path.cost(reducedCosts) == splitValue);
+
+  return SearchResult(settled, labeled, true, path, splitValue);
+}
+
+#endif /* COMPOSED_THETA_ROUTER_HH */
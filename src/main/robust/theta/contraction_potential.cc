@@ -0,0 +1,91 @@
+#include "contraction_potential.hh"
+
+#include "router/label.hh"
+#include "router/label_heap.hh"
+
+namespace
+{
+  const num UNKNOWN = -1;
+}
+
+ContractionPotential::ContractionPotential(const Graph& graph,
+                                           const ContractionHierarchy& hierarchy)
+  : Potential(graph),
+    hierarchy(hierarchy),
+    rankGraph(graph.getVertices().size(), {}),
+    backwardDistances(graph.getVertices().size(), inf),
+    distances(graph.getVertices().size(), UNKNOWN),
+    target(-1)
+{
+  assert(hierarchy.getRanks().size() == graph.getVertices().size());
+}
+
+void ContractionPotential::setTarget(Vertex target)
+{
+  for(const idx& rank : touched)
+  {
+    distances[rank] = UNKNOWN;
+  }
+
+  touched.clear();
+
+  for(const idx& rank : backwardTouched)
+  {
+    backwardDistances[rank] = inf;
+  }
+
+  backwardTouched.clear();
+
+  this->target = target;
+
+  const QueryGraph& downwardGraph = hierarchy.getDownwardGraph();
+  LabelHeap<SimpleLabel> heap(rankGraph);
+
+  heap.update(SimpleLabel(Vertex(hierarchy.getRanks()[target.getIndex()]), 0));
+
+  while(!heap.isEmpty())
+  {
+    const SimpleLabel current = heap.extractMin();
+    const idx rank = current.getVertex().getIndex();
+
+    backwardDistances[rank] = current.getCost();
+    backwardTouched.push_back(rank);
+
+    for(idx arc = downwardGraph.getBegin(rank); arc < downwardGraph.getEnd(rank); ++arc)
+    {
+      heap.update(SimpleLabel(Vertex(downwardGraph.getHead(arc)),
+                              current.getCost() + downwardGraph.getWeight(arc)));
+    }
+  }
+}
+
+num ContractionPotential::evaluate(idx rank) const
+{
+  num& distance = distances[rank];
+
+  if(distance != UNKNOWN)
+  {
+    return distance;
+  }
+
+  // the upward edges lead to vertices of higher rank,
+  // therefore the recursion terminates
+  const QueryGraph& upwardGraph = hierarchy.getUpwardGraph();
+
+  num value = backwardDistances[rank];
+
+  for(idx arc = upwardGraph.getBegin(rank); arc < upwardGraph.getEnd(rank); ++arc)
+  {
+    const num headValue = evaluate(upwardGraph.getHead(arc));
+
+    if(headValue != inf)
+    {
+      value = std::min(value, upwardGraph.getWeight(arc) + headValue);
+    }
+  }
+
+  distances[rank] = value;
+  touched.push_back(rank);
+
+  return value;
+}
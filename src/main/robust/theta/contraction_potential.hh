@@ -0,0 +1,85 @@
+#ifndef CONTRACTION_POTENTIAL_HH
+#define CONTRACTION_POTENTIAL_HH
+
+#include "contraction/contraction_hierarchy.hh"
+
+#include "potential.hh"
+
+/**
+ * A Potential given by the exact distances towards a target with
+ * respect to the costs of a ContractionHierarchy. If the hierarchy
+ * is built on the nominal costs, which are a lower bound on the
+ * ReducedCosts for every theta value, the potential is valid for
+ * all theta values at once.
+ *
+ * Setting a target performs a backward search in the hierarchy.
+ * The distance of a Vertex is then evaluated lazily by combining
+ * its upward Edge%s with the distances of their heads, which are
+ * memoized. Vertices which cannot reach the target have an infinite
+ * potential and should be skipped using a ReachableFilter.
+ **/
+class ContractionPotential : public Potential
+{
+private:
+  const ContractionHierarchy& hierarchy;
+  Graph rankGraph;
+
+  std::vector<num> backwardDistances;
+  std::vector<idx> backwardTouched;
+  mutable std::vector<num> distances;
+  mutable std::vector<idx> touched;
+
+  Vertex target;
+
+  num evaluate(idx rank) const;
+
+public:
+  ContractionPotential(const Graph& graph,
+                       const ContractionHierarchy& hierarchy);
+
+  /**
+   * Sets the target, discarding all memoized distances.
+   **/
+  void setTarget(Vertex target);
+
+  Vertex getTarget() const
+  {
+    return target;
+  }
+
+  num operator()(const Vertex& vertex) const override
+  {
+    return evaluate(hierarchy.getRanks()[vertex.getIndex()]);
+  }
+
+  /**
+   * Returns the number of vertices whose distances
+   * have been evaluated since the target was set.
+   **/
+  idx getEvaluated() const
+  {
+    return touched.size();
+  }
+
+  /**
+   * An edge filter which only accepts Edge%s whose targets
+   * can reach the target of the ContractionPotential.
+   **/
+  class ReachableFilter
+  {
+  private:
+    const ContractionPotential& potential;
+
+  public:
+    ReachableFilter(const ContractionPotential& potential)
+      : potential(potential)
+    {}
+
+    bool operator()(const Edge& edge) const
+    {
+      return potential(edge.getTarget()) != inf;
+    }
+  };
+};
+
+#endif /* CONTRACTION_POTENTIAL_HH */
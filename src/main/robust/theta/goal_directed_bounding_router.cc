@@ -146,7 +146,7 @@ SearchResult GoalDirectedBoundingRouter::computeShortestPath(Vertex source,
       }
       else
       {
-        upperBounds(nextVertex) = costBound;
+        upperBounds.setValue(nextVertex, costBound);
       }
 
       heap.update(nextLabel);
@@ -179,5 +179,5 @@ SearchResult GoalDirectedBoundingRouter::computeShortestPath(Vertex source,
 void GoalDirectedBoundingRouter::doReset()
 {
   GoalDirectedRouter::doReset();
-  upperBounds.reset(inf);
+  upperBounds.reset();
 }
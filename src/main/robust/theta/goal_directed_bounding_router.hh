@@ -7,7 +7,7 @@ class GoalDirectedBoundingRouter : public GoalDirectedRouter
 {
 private:
   idx deviationSize;
-  VertexMap<num> upperBounds;
+  SparseVertexMap<num> upperBounds;
 
   template<bool bounded>
   SearchResult computeShortestPath(Vertex source,
@@ -17,6 +17,16 @@ GoalDirectedRouter::GoalDirectedRouter(const Graph& graph,
 
 }
 
+GoalDirectedRouter::GoalDirectedRouter(const Graph& graph,
+                                       const EdgeFunc<num>& costs,
+                                       const EdgeFunc<num>& deviations,
+                                       idx deviationSize,
+                                       const ContractionHierarchy& hierarchy)
+  : GoalDirectedRouter(graph, costs, deviations, deviationSize)
+{
+  contractionPotential.reset(new ContractionPotential(graph, hierarchy));
+}
+
 template <bool bounded>
 SearchResult GoalDirectedRouter::findShortestPath(Vertex source,
                                                   Vertex target,
@@ -28,6 +38,14 @@ SearchResult GoalDirectedRouter::findShortestPath(Vertex source,
     return SearchResult(0, 0, true, Path(), 0);
   }
 
+  if(contractionPotential)
+  {
+    return computeContractionPath<bounded>(source,
+                                           target,
+                                           thetaValue,
+                                           boundValue);
+  }
+
   if(reset(source, target, thetaValue))
   {
     auto result = recomputePotential<bounded>(source,
@@ -209,3 +227,54 @@ GoalDirectedRouter::computeShortestPath(Vertex source,
 
   return result;
 }
+
+template<bool bounded>
+SearchResult
+GoalDirectedRouter::computeContractionPath(Vertex source,
+                                           Vertex target,
+                                           num theta,
+                                           num bound)
+{
+  ContractionPotential& potential = *contractionPotential;
+
+  if(potential.getTarget() != target)
+  {
+    potential.setTarget(target);
+  }
+
+  if(potential(source) == inf)
+  {
+    return SearchResult::notFound(0, 0);
+  }
+
+  Dijkstra dijkstra(graph);
+
+  ReducedCosts reducedCosts(costs, deviations, theta);
+  PotentialCosts potentialCosts(reducedCosts, potential);
+
+  const num potentialCostBound = potential.potentialPathCost(bound, source, target);
+
+  auto result = dijkstra.shortestPath<ContractionPotential::ReachableFilter, bounded>(
+    source,
+    target,
+    potentialCosts,
+    ContractionPotential::ReachableFilter(potential),
+    potentialCostBound);
+
+  if(result.found)
+  {
+    result.cost = potential.actualPathCost(result.cost, source, target);
+  }
+
+  return result;
+}
+
+template SearchResult GoalDirectedRouter::recomputePotential<false>(Vertex source,
+                                                                    Vertex target,
+                                                                    num theta,
+                                                                    num bound);
+
+template SearchResult GoalDirectedRouter::recomputePotential<true>(Vertex source,
+                                                                   Vertex target,
+                                                                   num theta,
+                                                                   num bound);
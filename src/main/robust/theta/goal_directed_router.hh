@@ -1,7 +1,10 @@
 #ifndef GOAL_DIRECTED_ROUTER_HH
 #define GOAL_DIRECTED_ROUTER_HH
 
+#include <memory>
+
 #include "stateful_theta_router.hh"
+#include "contraction_potential.hh"
 #include "potential.hh"
 
 class GoalDirectedRouter : public StatefulThetaRouter
@@ -19,6 +22,8 @@ protected:
   // chosen according to a parameter test
   float recomputationFactor = 0.15;
 
+  std::unique_ptr<ContractionPotential> contractionPotential;
+
   template<bool bounded>
   SearchResult findShortestPath(Vertex source,
                                 Vertex target,
@@ -37,12 +42,31 @@ protected:
                                    num theta,
                                    num bound) const;
 
+  template<bool bounded>
+  SearchResult computeContractionPath(Vertex source,
+                                      Vertex target,
+                                      num theta,
+                                      num bound);
+
 public:
   GoalDirectedRouter(const Graph& graph,
                      const EdgeFunc<num>& costs,
                      const EdgeFunc<num>& deviations,
                      idx deviationSize);
 
+  /**
+   * Constructs a GoalDirectedRouter using a ContractionPotential
+   * based on the given ContractionHierarchy, which must have been
+   * built on the nominal costs. Instead of recomputing the potential
+   * by backward searches, the exact nominal distances towards the
+   * target are evaluated lazily.
+   **/
+  GoalDirectedRouter(const Graph& graph,
+                     const EdgeFunc<num>& costs,
+                     const EdgeFunc<num>& deviations,
+                     idx deviationSize,
+                     const ContractionHierarchy& hierarchy);
+
   SearchResult shortestPath(Vertex source,
                             Vertex target,
                             num theta,
@@ -3,6 +3,7 @@
 
 #include "graph/graph.hh"
 #include "graph/edge_map.hh"
+#include "graph/sparse_vertex_map.hh"
 #include "graph/vertex_map.hh"
 
 template <Direction direction>
@@ -11,7 +12,7 @@ class PartialDistanceMap : public VertexFunc<num>
 private:
   const Graph& graph;
   num defaultValue;
-  VertexMap<num> values;
+  SparseVertexMap<num> values;
 public:
   PartialDistanceMap(const Graph& graph)
     : graph(graph),
@@ -28,7 +29,7 @@ public:
   void reset()
   {
     defaultValue = inf;
-    values.reset(inf);
+    values.reset();
   }
 
   num operator()(const Vertex& vertex) const override
@@ -47,7 +48,7 @@ public:
 
   void setValue(const Vertex& vertex, num value)
   {
-    values(vertex) = value;
+    values.setValue(vertex, value);
   }
 
 };
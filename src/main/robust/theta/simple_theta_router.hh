@@ -21,6 +21,9 @@ public:
                     const EdgeFunc<num>& deviations,
                     idx deviationSize);
 
+  using BidirectionalRouter::isConcurrent;
+  using BidirectionalRouter::setConcurrent;
+
   virtual SearchResult shortestPath(Vertex source,
                                     Vertex target,
                                     num theta,
@@ -0,0 +1,299 @@
+#ifndef THETA_POLICIES_HH
+#define THETA_POLICIES_HH
+
+#include <memory>
+
+#include "graph/graph.hh"
+#include "graph/sparse_vertex_map.hh"
+
+#include "arcflags/arcflags.hh"
+#include "arcflags/partition.hh"
+
+#include "router/router.hh"
+
+#include "contraction_potential.hh"
+
+/**
+ * The policies used by the ComposedThetaRouter and the
+ * BidirectionalComposedThetaRouter. Each policy is prepared
+ * for a query given by a source, a target and a value
+ * \f$ \theta \f$ before the search is started.
+ *
+ * An edge filter policy provides a Filter type together with
+ * the functions forward() / backward() returning the Filter%s
+ * for the forward / backward search.
+ *
+ * A potential policy evaluates a potential which is valid with
+ * respect to the ReducedCosts of all values and vanishes at the
+ * target. Vertices with an infinite potential cannot reach the
+ * target and are skipped.
+ *
+ * A pruning policy decides whether a Vertex, which is labeled
+ * with a given bound on the objective value, can be pruned.
+ **/
+
+/**
+ * An edge filter policy accepting all Edge%s.
+ **/
+class UnfilteredEdges
+{
+public:
+  typedef AllEdgeFilter Filter;
+
+  UnfilteredEdges(const Graph& graph)
+  {}
+
+  Filter forward(Vertex source, Vertex target, num theta) const
+  {
+    return Filter();
+  }
+
+  Filter backward(Vertex source, Vertex target, num theta) const
+  {
+    return Filter();
+  }
+};
+
+/**
+ * An edge filter policy based on robust arc flags of the given
+ * kind. Queries inside a single Region are not filtered.
+ **/
+template <class Flags>
+class ArcFlagEdgeFilter
+{
+private:
+  const Partition& partition;
+  const Flags& incomingFlags;
+  const Flags& outgoingFlags;
+
+public:
+  class Filter
+  {
+  private:
+    const Flags* flags;
+    const Region* region;
+    num theta;
+
+  public:
+    Filter(const Flags* flags, const Region* region, num theta)
+      : flags(flags),
+        region(region),
+        theta(theta)
+    {}
+
+    bool operator()(const Edge& edge) const
+    {
+      return !flags or flags->filter(edge, *region, theta);
+    }
+  };
+
+  ArcFlagEdgeFilter(const Partition& partition,
+                    const Bidirected<Flags>& flags)
+    : partition(partition),
+      incomingFlags(flags.get(Direction::INCOMING)),
+      outgoingFlags(flags.get(Direction::OUTGOING))
+  {}
+
+  Filter forward(Vertex source, Vertex target, num theta) const
+  {
+    const Region& targetRegion = partition.getRegion(target);
+
+    if(partition.getRegion(source) == targetRegion)
+    {
+      return Filter(nullptr, nullptr, theta);
+    }
+
+    return Filter(&incomingFlags, &targetRegion, theta);
+  }
+
+  Filter backward(Vertex source, Vertex target, num theta) const
+  {
+    const Region& sourceRegion = partition.getRegion(source);
+
+    if(partition.getRegion(target) == sourceRegion)
+    {
+      return Filter(nullptr, nullptr, theta);
+    }
+
+    return Filter(&outgoingFlags, &sourceRegion, theta);
+  }
+};
+
+/**
+ * An edge filter policy based on ArcFlags which do not depend on
+ * the value, such as the ones computed by the ValueArcFlagPreprocessor.
+ * The Filter%s are only valid for the values the ArcFlags were
+ * computed for. Queries inside a single Region are not filtered.
+ **/
+class ValueArcFlagEdgeFilter
+{
+private:
+  const Partition& partition;
+  const ArcFlags& incomingFlags;
+  const ArcFlags& outgoingFlags;
+
+public:
+  class Filter
+  {
+  private:
+    const ArcFlags* flags;
+    const Region* region;
+
+  public:
+    Filter(const ArcFlags* flags, const Region* region)
+      : flags(flags),
+        region(region)
+    {}
+
+    bool operator()(const Edge& edge) const
+    {
+      return !flags or flags->hasFlag(edge, *region);
+    }
+  };
+
+  ValueArcFlagEdgeFilter(const Partition& partition,
+                         const ArcFlags& incomingFlags,
+                         const ArcFlags& outgoingFlags)
+    : partition(partition),
+      incomingFlags(incomingFlags),
+      outgoingFlags(outgoingFlags)
+  {}
+
+  Filter forward(Vertex source, Vertex target, num theta) const
+  {
+    const Region& targetRegion = partition.getRegion(target);
+
+    if(partition.getRegion(source) == targetRegion)
+    {
+      return Filter(nullptr, nullptr);
+    }
+
+    return Filter(&incomingFlags, &targetRegion);
+  }
+
+  Filter backward(Vertex source, Vertex target, num theta) const
+  {
+    const Region& sourceRegion = partition.getRegion(source);
+
+    if(partition.getRegion(target) == sourceRegion)
+    {
+      return Filter(nullptr, nullptr);
+    }
+
+    return Filter(&outgoingFlags, &sourceRegion);
+  }
+};
+
+/**
+ * A potential policy without any potential, which
+ * yields an ordinary Dijkstra search.
+ **/
+class NoPotential
+{
+public:
+  NoPotential(const Graph& graph)
+  {}
+
+  void prepare(Vertex source, Vertex target, num theta)
+  {}
+
+  num operator()(Vertex vertex) const
+  {
+    return 0;
+  }
+};
+
+/**
+ * A potential policy given by a ContractionPotential,
+ * which is only updated if the target changes.
+ **/
+class ContractionGoalPotential
+{
+private:
+  std::unique_ptr<ContractionPotential> potential;
+
+public:
+  ContractionGoalPotential(const Graph& graph,
+                           const ContractionHierarchy& hierarchy)
+    : potential(new ContractionPotential(graph, hierarchy))
+  {}
+
+  void prepare(Vertex source, Vertex target, num theta)
+  {
+    if(potential->getTarget() != target)
+    {
+      potential->setTarget(target);
+    }
+  }
+
+  num operator()(Vertex vertex) const
+  {
+    return (*potential)(vertex);
+  }
+};
+
+/**
+ * A pruning policy which never prunes.
+ **/
+class NoPruning
+{
+public:
+  NoPruning(const Graph& graph)
+  {}
+
+  void prepare(Vertex source, Vertex target, num theta)
+  {}
+
+  bool prune(Vertex vertex, num bound)
+  {
+    return false;
+  }
+};
+
+/**
+ * A pruning policy which maintains an upper bound on the
+ * objective value for each Vertex as in the BoundingRouter.
+ * The bounds are kept as long as the same source and target
+ * are queried with decreasing values.
+ **/
+class UpperBoundPruning
+{
+private:
+  SparseVertexMap<num> upperBounds;
+  Vertex lastSource, lastTarget;
+  num lastValue;
+
+public:
+  UpperBoundPruning(const Graph& graph)
+    : upperBounds(graph, inf),
+      lastSource(-1),
+      lastTarget(-1),
+      lastValue(inf)
+  {}
+
+  void prepare(Vertex source, Vertex target, num theta)
+  {
+    if(theta > lastValue or source != lastSource or target != lastTarget)
+    {
+      upperBounds.reset();
+    }
+
+    lastSource = source;
+    lastTarget = target;
+    lastValue = theta;
+  }
+
+  bool prune(Vertex vertex, num bound)
+  {
+    if(bound > upperBounds(vertex))
+    {
+      return true;
+    }
+
+    upperBounds.setValue(vertex, bound);
+
+    return false;
+  }
+};
+
+#endif /* THETA_POLICIES_HH */
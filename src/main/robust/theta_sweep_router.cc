@@ -0,0 +1,150 @@
+#include "theta_sweep_router.hh"
+
+#include <algorithm>
+
+ThetaSweepRouter::ThetaSweepRouter(const Graph& graph,
+                                   const EdgeFunc<num>& costs,
+                                   const EdgeFunc<num>& deviations,
+                                   idx deviationSize)
+  : RobustRouter(graph, costs, deviations, deviationSize)
+{
+}
+
+idx ThetaSweepRouter::sweep(Vertex source,
+                            const std::vector<Vertex>& targets,
+                            const ValueVector& possibleValues,
+                            num bound,
+                            bool computePaths,
+                            std::vector<RobustTargetResult>& results)
+{
+  results = std::vector<RobustTargetResult>(targets.size());
+
+  if(possibleValues.empty())
+  {
+    return 0;
+  }
+
+  // The values are sorted in descending order
+  ThetaTree tree(graph, source, costs, deviations, possibleValues.back());
+
+  idx calls = 0;
+
+  // reachability does not depend on theta, targets which
+  // are unreachable initially never need to be considered
+  std::vector<bool> reachable(targets.size(), true);
+
+  for(auto it = possibleValues.rbegin(); it != possibleValues.rend(); ++it)
+  {
+    const num value = *it;
+    const num offset = ((num) deviationSize) * value;
+
+    num maxCost = 0;
+
+    for(idx i = 0; i < targets.size(); ++i)
+    {
+      if(results[i].found)
+      {
+        maxCost = std::max(maxCost, results[i].cost);
+      }
+      else if(reachable[i])
+      {
+        maxCost = inf;
+      }
+    }
+
+    if(offset >= std::min(bound, maxCost))
+    {
+      break;
+    }
+
+    tree.reset(value);
+    ++calls;
+
+    for(idx i = 0; i < targets.size(); ++i)
+    {
+      const Vertex target = targets[i];
+      RobustTargetResult& result = results[i];
+
+      if(!tree.isReachable(target))
+      {
+        reachable[i] = false;
+        continue;
+      }
+
+      const num cost = offset + tree.getDistance(target);
+
+      if(cost < result.cost && cost <= bound)
+      {
+        result.found = true;
+        result.cost = cost;
+        result.value = value;
+
+        if(computePaths)
+        {
+          result.path = tree.getPath(target);
+        }
+      }
+    }
+  }
+
+  return calls;
+}
+
+RobustSearchResult ThetaSweepRouter::shortestPath(Vertex source,
+                                                  Vertex target,
+                                                  const ValueVector& possibleValues,
+                                                  num bound)
+{
+  std::vector<RobustTargetResult> results;
+
+  RobustSearchResult robustSearchResult;
+
+  robustSearchResult.calls = sweep(source,
+                                   {target},
+                                   possibleValues,
+                                   bound,
+                                   true,
+                                   results);
+
+  robustSearchResult.found = results.front().found;
+  robustSearchResult.numFound = idx(results.front().found);
+  robustSearchResult.path = results.front().path;
+
+  return robustSearchResult;
+}
+
+std::vector<RobustTargetResult>
+ThetaSweepRouter::shortestPaths(Vertex source,
+                                const std::vector<Vertex>& targets,
+                                const ValueVector& possibleValues,
+                                bool computePaths)
+{
+  std::vector<RobustTargetResult> results;
+
+  sweep(source, targets, possibleValues, inf, computePaths, results);
+
+  return results;
+}
+
+RobustCostMatrix ThetaSweepRouter::shortestPaths(const std::vector<Vertex>& sources,
+                                                 const std::vector<Vertex>& targets,
+                                                 const ValueVector& possibleValues,
+                                                 bool computePaths)
+{
+  RobustCostMatrix matrix(sources, targets);
+
+  for(idx i = 0; i < sources.size(); ++i)
+  {
+    std::vector<RobustTargetResult> results = shortestPaths(sources[i],
+                                                            targets,
+                                                            possibleValues,
+                                                            computePaths);
+
+    for(idx j = 0; j < targets.size(); ++j)
+    {
+      matrix.get(i, j) = results[j];
+    }
+  }
+
+  return matrix;
+}
@@ -0,0 +1,88 @@
+#ifndef THETA_SWEEP_ROUTER_HH
+#define THETA_SWEEP_ROUTER_HH
+
+#include "arcflags/region.hh"
+
+#include "robust_router.hh"
+#include "theta_tree.hh"
+
+/**
+ * A RobustRouter which sweeps the theta values in ascending
+ * order, maintaining a single ThetaTree rooted at the source
+ * which is repaired incrementally instead of being recomputed
+ * for each value. Since a tree answers all targets at once,
+ * the router is best suited to one-to-many queries, e.g.
+ * from one source to all vertices of a Region.
+ *
+ * The sweep stops as soon as \f$ \Gamma \theta \f$ exceeds
+ * the robust cost of every target, since the reduced costs
+ * are non-negative.
+ **/
+class ThetaSweepRouter : public RobustRouter
+{
+public:
+  ThetaSweepRouter(const Graph& graph,
+                   const EdgeFunc<num>& costs,
+                   const EdgeFunc<num>& deviations,
+                   idx deviationSize);
+
+  using RobustRouter::shortestPath;
+  using RobustRouter::shortestPaths;
+
+  RobustSearchResult shortestPath(Vertex source,
+                                  Vertex target,
+                                  const ValueVector& possibleValues,
+                                  num bound) override;
+
+  /**
+   * Computes robust shortest paths from the given source
+   * to each of the given targets in one sweep.
+   *
+   * @param source         The source vertex.
+   * @param targets        The target vertices.
+   * @param possibleValues The theta values which can occur.
+   * @param computePaths   Whether to extract the Path%s or only the costs.
+   *
+   * @return A result for each target, in the order of the targets.
+   **/
+  std::vector<RobustTargetResult> shortestPaths(Vertex source,
+                                                const std::vector<Vertex>& targets,
+                                                const ValueVector& possibleValues,
+                                                bool computePaths = true);
+
+  std::vector<RobustTargetResult> shortestPaths(Vertex source,
+                                                const std::vector<Vertex>& targets,
+                                                bool computePaths = true)
+  {
+    return shortestPaths(source, targets, values, computePaths);
+  }
+
+  /**
+   * Computes robust shortest paths from the given source
+   * to all vertices of the given Region.
+   **/
+  std::vector<RobustTargetResult> shortestPaths(Vertex source,
+                                                const Region& region,
+                                                bool computePaths = true)
+  {
+    return shortestPaths(source, region.getVertices(), values, computePaths);
+  }
+
+  /**
+   * Computes a robust cost matrix using one sweep per source.
+   **/
+  RobustCostMatrix shortestPaths(const std::vector<Vertex>& sources,
+                                 const std::vector<Vertex>& targets,
+                                 const ValueVector& possibleValues,
+                                 bool computePaths = true) override;
+
+private:
+  idx sweep(Vertex source,
+            const std::vector<Vertex>& targets,
+            const ValueVector& possibleValues,
+            num bound,
+            bool computePaths,
+            std::vector<RobustTargetResult>& results);
+};
+
+#endif /* THETA_SWEEP_ROUTER_HH */
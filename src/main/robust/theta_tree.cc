@@ -7,10 +7,71 @@
 #include "router/label.hh"
 #include "router/label_heap.hh"
 
+void ThetaTree::attach(Vertex vertex, const Edge& edge)
+{
+  assert(vertex == edge.getTarget());
+
+  Node& node = nodes(vertex);
+  Node& parentNode = nodes(edge.getSource());
+
+  node.setParent(edge);
+  node.previousSibling = None;
+  node.nextSibling = parentNode.firstChild;
+
+  if(parentNode.firstChild != None)
+  {
+    nodes(Vertex(parentNode.firstChild)).previousSibling = vertex.getIndex();
+  }
+
+  parentNode.firstChild = vertex.getIndex();
+}
+
+void ThetaTree::detach(Vertex vertex)
+{
+  Node& node = nodes(vertex);
+
+  if(node.previousSibling != None)
+  {
+    nodes(Vertex(node.previousSibling)).nextSibling = node.nextSibling;
+  }
+  else
+  {
+    Node& parentNode = nodes(node.getParent().getSource());
+    assert(parentNode.firstChild == vertex.getIndex());
+    parentNode.firstChild = node.nextSibling;
+  }
+
+  if(node.nextSibling != None)
+  {
+    nodes(Vertex(node.nextSibling)).previousSibling = node.previousSibling;
+  }
+
+  node.nextSibling = None;
+  node.previousSibling = None;
+}
+
+Path ThetaTree::getPath(Vertex vertex) const
+{
+  assert(isReachable(vertex));
+
+  Path path;
+
+  while(vertex != root)
+  {
+    const Edge& edge = nodes(vertex).getParent();
+    path.prepend(edge);
+    vertex = edge.getSource();
+  }
+
+  return path;
+}
+
 void ThetaTree::recomputeTree()
 {
   LabelHeap<Label> heap(graph);
 
+  nodes(root).setDistance(0);
+
   heap.update(Label(root, Edge(), 0));
 
   ReducedCosts reducedCosts(costs, deviations, value);
@@ -22,12 +83,8 @@ void ThetaTree::recomputeTree()
 
     if(current.getVertex() != root)
     {
-      const Edge& edge = current.getEdge();
-      Node& parentNode = nodes(edge.getSource());
-
       currentNode.setDistance(current.getCost());
-      currentNode.setParent(edge);
-      currentNode.setParentNode(parentNode, edge);
+      attach(current.getVertex(), current.getEdge());
     }
 
     for(const Edge& edge : graph.getOutgoing(current.getVertex()))
@@ -64,14 +121,15 @@ void ThetaTree::reset(num newValue)
     Vertex current = queue.front();
     queue.pop();
 
-    for(const Edge& edge : nodes(current).getChildren())
-    {
-      Vertex other = edge.getTarget();
+    forChildren(current,
+                [&](const Edge& edge)
+                {
+                  Vertex other = edge.getTarget();
 
-      nodes(other).setDistance(nodes(current).getDistance() + reducedCosts(edge));
+                  nodes(other).setDistance(nodes(current).getDistance() + reducedCosts(edge));
 
-      queue.push(other);
-    }
+                  queue.push(other);
+                });
   }
 
   assert(checkDistances());
@@ -102,10 +160,8 @@ void ThetaTree::reset(num newValue)
 
       if(newDistance < otherNode.getDistance())
       {
-        Node& oldParent = nodes(otherNode.getParent().getSource());
-
-        oldParent.removeChild(otherNode.getParent());
-        otherNode.setParentNode(currentNode, edge);
+        detach(other);
+        attach(other, edge);
         otherNode.setDistance(newDistance);
 
         heap.update(Label(other, edge, newDistance));
@@ -114,12 +170,11 @@ void ThetaTree::reset(num newValue)
       }
     }
 
-    for(const Edge& edge : currentNode.getChildren())
-    {
-      const Vertex other = edge.getTarget();
-
-      queue.push(other);
-    }
+    forChildren(current,
+                [&](const Edge& edge)
+                {
+                  queue.push(edge.getTarget());
+                });
   }
 
   while(!heap.isEmpty())
@@ -143,9 +198,8 @@ void ThetaTree::reset(num newValue)
         Label nextLabel = Label(other,
                                 edge, current.getCost() + reducedCosts(edge));
 
-        Node& oldParent = nodes(otherNode.getParent().getSource());
-        oldParent.removeChild(otherNode.getParent());
-        otherNode.setParentNode(currentNode, edge);
+        detach(other);
+        attach(other, edge);
         otherNode.setDistance(newDistance);
 
         heap.update(nextLabel);
@@ -171,23 +225,31 @@ bool ThetaTree::check() const
 
     queue.pop();
 
-    for(const Edge& edge : currentNode.getChildren())
-    {
-      Vertex other = edge.getTarget();
+    bool valid = true;
 
-      const Node& otherNode = nodes(other);
+    forChildren(current,
+                [&](const Edge& edge)
+                {
+                  Vertex other = edge.getTarget();
 
-      if(otherNode.getParent().getSource() != current)
-      {
-        return false;
-      }
+                  const Node& otherNode = nodes(other);
 
-      if(otherNode.getDistance() - currentNode.getDistance() != reducedCosts(edge))
-      {
-        return false;
-      }
+                  if(otherNode.getParent().getSource() != current)
+                  {
+                    valid = false;
+                  }
+
+                  if(otherNode.getDistance() - currentNode.getDistance() != reducedCosts(edge))
+                  {
+                    valid = false;
+                  }
 
-      queue.push(other);
+                  queue.push(other);
+                });
+
+    if(!valid)
+    {
+      return false;
     }
   }
 
@@ -209,18 +271,26 @@ bool ThetaTree::checkDistances() const
 
     queue.pop();
 
-    for(const Edge& edge : currentNode.getChildren())
-    {
-      Vertex other = edge.getTarget();
+    bool valid = true;
 
-      const Node& otherNode = nodes(other);
+    forChildren(current,
+                [&](const Edge& edge)
+                {
+                  Vertex other = edge.getTarget();
 
-      if(otherNode.getDistance() - currentNode.getDistance() != reducedCosts(edge))
-      {
-        return false;
-      }
+                  const Node& otherNode = nodes(other);
 
-      queue.push(other);
+                  if(otherNode.getDistance() - currentNode.getDistance() != reducedCosts(edge))
+                  {
+                    valid = false;
+                  }
+
+                  queue.push(other);
+                });
+
+    if(!valid)
+    {
+      return false;
     }
   }
 
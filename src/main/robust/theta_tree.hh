@@ -3,6 +3,8 @@
 
 #include "graph/vertex_map.hh"
 
+#include "path/path.hh"
+
 #include "reduced_costs.hh"
 #include "robust_utils.hh"
 
@@ -18,28 +20,32 @@
  **/
 class ThetaTree
 {
+  static const idx None = -1;
+
+  /**
+   * A node of the tree. Instead of storing a vector of
+   * children per node, the children of each node
+   * are linked via their siblings, keeping all nodes
+   * in one contiguous array.
+   **/
   class Node
   {
   private:
-    std::vector<Edge> children;
     Edge parent;
     num distance;
 
   public:
+    idx firstChild;
+    idx nextSibling;
+    idx previousSibling;
+
     Node()
-      : distance(0)
+      : distance(inf),
+        firstChild(None),
+        nextSibling(None),
+        previousSibling(None)
     {}
 
-    const std::vector<Edge>& getChildren() const
-    {
-      return children;
-    }
-
-    std::vector<Edge>& getChildren()
-    {
-      return children;
-    }
-
     num getDistance() const
     {
       return distance;
@@ -59,24 +65,6 @@ class ThetaTree
     {
       parent = value;
     }
-
-    void removeChild(const Edge& edge)
-    {
-      std::vector<Edge>& children = getChildren();
-
-      assert(std::find(children.begin(), children.end(), edge) != children.end());
-
-      children.erase(std::remove(children.begin(), children.end(), edge),
-                     children.end());
-    }
-
-    void setParentNode(Node& parentNode,
-                       const Edge& edge)
-    {
-      assert(parent.getTarget() == edge.getTarget());
-      setParent(edge);
-      parentNode.getChildren().push_back(edge);
-    }
   };
 
   const Graph& graph;
@@ -87,16 +75,34 @@ class ThetaTree
 
   VertexMap<Node> nodes;
 
+  /**
+   * Links the given Vertex to the source of the given Edge.
+   **/
+  void attach(Vertex vertex, const Edge& edge);
+
+  /**
+   * Unlinks the given Vertex from its current parent.
+   **/
+  void detach(Vertex vertex);
+
+  /**
+   * Applies the given function to the Edge%s connecting
+   * the given Vertex to its children.
+   **/
+  template <class Func>
+  void forChildren(Vertex vertex, Func func) const;
+
 public:
   ThetaTree(const Graph& graph,
-             const Vertex& root,
-             const EdgeFunc<num>& costs,
-             const EdgeFunc<num>& deviations)
+            const Vertex& root,
+            const EdgeFunc<num>& costs,
+            const EdgeFunc<num>& deviations,
+            num value = 0)
     : graph(graph),
       root(root),
       costs(costs),
       deviations(deviations),
-      value(0),
+      value(value),
       nodes(graph, Node())
   {
     recomputeTree();
@@ -112,11 +118,26 @@ public:
     return value;
   }
 
+  /**
+   * Returns the distance of the given Vertex from the root,
+   * which is infinite for unreachable vertices.
+   **/
   num getDistance(const Vertex& vertex) const
   {
     return nodes(vertex).getDistance();
   }
 
+  bool isReachable(const Vertex& vertex) const
+  {
+    return getDistance(vertex) != inf;
+  }
+
+  /**
+   * Returns the tree Path from the root to the given
+   * (reachable) Vertex.
+   **/
+  Path getPath(Vertex vertex) const;
+
   void reset(num newValue);
 
 private:
@@ -127,5 +148,15 @@ private:
   bool checkDistances() const;
 };
 
+template <class Func>
+void ThetaTree::forChildren(Vertex vertex, Func func) const
+{
+  for(idx child = nodes(vertex).firstChild;
+      child != None;
+      child = nodes(Vertex(child)).nextSibling)
+  {
+    func(nodes(Vertex(child)).getParent());
+  }
+}
 
 #endif /* THETA_TREE_HH */
@@ -11,8 +11,8 @@
 DistanceMap AbstractValuePreprocessor::findShortestPaths(const Region& sourceRegion,
                                                          const Region& targetRegion) const
 {
-  const auto& sourceBoundaries = partition.boundaryVertices<Direction::OUTGOING>(sourceRegion);
-  const auto& targetBoundaries = partition.boundaryVertices<Direction::INCOMING>(targetRegion);
+  const auto sourceBoundaries = partition.boundaryVertices<Direction::OUTGOING>(sourceRegion);
+  const auto targetBoundaries = partition.boundaryVertices<Direction::INCOMING>(targetRegion);
 
   DistanceMap boundaryDistances;
 
@@ -12,10 +12,10 @@ FastValuePreprocessor::requiredValues(const Region& sourceRegion,
 {
   std::unordered_set<num> requiredValues;
 
-  const std::unordered_set<Vertex>& sourceBoundaries =
+  const ArrayRange<Vertex> sourceBoundaries =
     partition.boundaryVertices<Direction::OUTGOING>(sourceRegion);
 
-  const std::unordered_set<Vertex>& targetBoundaries =
+  const ArrayRange<Vertex> targetBoundaries =
     partition.boundaryVertices<Direction::INCOMING>(targetRegion);
 
   DistanceMap boundaryDistances = findShortestPaths(sourceRegion, targetRegion);
@@ -305,8 +305,8 @@ FastValuePreprocessor::updateBounds(const Region& sourceRegion,
 
 void FastValuePreprocessor::setLowerBounds(const Region& sourceRegion,
                                            const Region& targetRegion,
-                                           const std::unordered_set<Vertex>& sourceBoundaries,
-                                           const std::unordered_set<Vertex>& targetBoundaries,
+                                           const ArrayRange<Vertex>& sourceBoundaries,
+                                           const ArrayRange<Vertex>& targetBoundaries,
                                            const DistanceMap& boundaryDistances,
                                            VertexPairMap<Bound>& currentBounds,
                                            idx i) const
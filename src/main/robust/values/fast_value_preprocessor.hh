@@ -26,8 +26,8 @@ private:
 
   void setLowerBounds(const Region& sourceRegion,
                       const Region& targetRegion,
-                      const std::unordered_set<Vertex>& sourceBoundaries,
-                      const std::unordered_set<Vertex>& targetBoundaries,
+                      const ArrayRange<Vertex>& sourceBoundaries,
+                      const ArrayRange<Vertex>& targetBoundaries,
                       const DistanceMap& boundaryDistances,
                       VertexPairMap<Bound>& currentBounds,
                       idx i) const;
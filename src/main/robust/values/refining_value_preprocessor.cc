@@ -245,10 +245,10 @@ RefiningValuePreprocessor::requiredValues(const Region& sourceRegion) const
           continue;
         }
 
-        const Boundary targetBoundary =
-          partition.getBoundary<Direction::INCOMING>(targetRegion);
+        const ArrayRange<Vertex> targetBoundary =
+          partition.boundaryVertices<Direction::INCOMING>(targetRegion);
 
-        for(const Vertex& target : targetBoundary.getVertices())
+        for(const Vertex& target : targetBoundary)
         {
           const Label& label = heap.getLabel(target);
 
@@ -260,7 +260,7 @@ RefiningValuePreprocessor::requiredValues(const Region& sourceRegion) const
         VertexSet considered(graph);
         considered.insert(source);
 
-        for(const Vertex& target : targetBoundary.getVertices())
+        for(const Vertex& target : targetBoundary)
         {
           Label current = heap.getLabel(target);
 
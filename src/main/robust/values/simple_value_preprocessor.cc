@@ -11,10 +11,10 @@ SimpleValuePreprocessor::requiredValues(const Region& sourceRegion,
 {
   std::unordered_set<num> requiredValues;
 
-  const std::unordered_set<Vertex>& sourceBoundaries =
+  const ArrayRange<Vertex> sourceBoundaries =
     partition.boundaryVertices<Direction::OUTGOING>(sourceRegion);
 
-  const std::unordered_set<Vertex>& targetBoundaries =
+  const ArrayRange<Vertex> targetBoundaries =
     partition.boundaryVertices<Direction::INCOMING>(targetRegion);
 
   DistanceMap boundaryDistances = findShortestPaths(sourceRegion, targetRegion);
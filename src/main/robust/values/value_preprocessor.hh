@@ -26,7 +26,7 @@ private:
 
   template<Direction direction, class Func>
   void computeShortestPaths(const Region& region,
-                            std::unordered_set<Vertex>& boundaryVertices,
+                            const ArrayRange<Vertex>& boundaryVertices,
                             Func func) const;
 
 public:
@@ -45,7 +45,7 @@ public:
 
 template<Direction direction, class Func>
 void ValuePreprocessor::computeShortestPaths(const Region& region,
-                                             std::unordered_set<Vertex>& boundaryVertices,
+                                             const ArrayRange<Vertex>& boundaryVertices,
                                              Func func) const
 {
   for(const Vertex& boundaryVertex : boundaryVertices)
@@ -1,6 +1,12 @@
 #ifndef BIDIRECTIONAL_ROUTER_HH
 #define BIDIRECTIONAL_ROUTER_HH
 
+#include <atomic>
+#include <vector>
+
+#include <tbb/spin_mutex.h>
+#include <tbb/task_group.h>
+
 #include "graph/graph.hh"
 #include "graph/edge_map.hh"
 
@@ -13,13 +19,84 @@
  **/
 class BidirectionalRouter
 {
+private:
+  /**
+   * The state shared between the concurrent forward and
+   * backward searches: The best meeting point found so far,
+   * the smallest keys of both heaps and a flag indicating
+   * that one of the searches has proven optimality.
+   **/
+  class Meeting
+  {
+  public:
+    Meeting()
+      : splitValue(inf),
+        done(false)
+    {
+      tops[0] = 0;
+      tops[1] = 0;
+    }
+
+    std::atomic<num> splitValue;
+    Vertex split;
+    std::atomic<num> tops[2];
+    std::atomic<bool> done;
+    tbb::spin_mutex mutex;
+
+    void update(Vertex vertex, num value)
+    {
+      if(value >= splitValue.load())
+      {
+        return;
+      }
+
+      tbb::spin_mutex::scoped_lock lock(mutex);
+
+      if(value < splitValue.load())
+      {
+        split = vertex;
+        splitValue.store(value);
+      }
+    }
+  };
+
+  template<Direction direction,
+           class Filter,
+           bool bounded>
+  void search(const EdgeFunc<num>& costs,
+              Filter filter,
+              const num boundValue,
+              LabelHeap<Label>& heap,
+              std::vector<std::atomic<num>>& distances,
+              const std::vector<std::atomic<num>>& otherDistances,
+              Meeting& meeting,
+              int& settled,
+              int& labeled);
+
+  bool concurrent;
+
 protected:
   const Graph& graph;
 public:
   BidirectionalRouter(const Graph& graph)
-    : graph(graph)
+    : concurrent(false),
+      graph(graph)
   {}
 
+  /**
+   * Returns whether the forward and backward searches
+   * are run concurrently. @see concurrentShortestPath
+   **/
+  bool isConcurrent() const
+  {
+    return concurrent;
+  }
+
+  void setConcurrent(bool value)
+  {
+    concurrent = value;
+  }
+
   /**
    * Finds a shortest path between the given source and target Vertex
    * which satisfies the given filters and which is bounded by
@@ -49,6 +126,28 @@ public:
                             ForwardFiler forwardFilter = ForwardFiler(),
                             BackwardFilter backwardFilter = BackwardFilter(),
                             const num boundValue = inf);
+
+  /**
+   * Finds a shortest path in the same way as shortestPath(), but
+   * runs the forward and the backward search as two concurrent
+   * tasks. Both searches publish their tentative distances and
+   * smallest keys, the best meeting point is maintained under
+   * a lock. A search stops as soon as the sum of both smallest
+   * keys exceeds the best meeting value (or the bound), after
+   * which the other search stops as well.
+   *
+   * If no second thread is available the tasks simply
+   * run one after another, yielding a unidirectional search.
+   **/
+  template<class ForwardFiler = AllEdgeFilter,
+           class BackwardFilter = AllEdgeFilter,
+           bool bounded = false>
+  SearchResult concurrentShortestPath(Vertex source,
+                                      Vertex target,
+                                      const EdgeFunc<num>& costs,
+                                      ForwardFiler forwardFilter = ForwardFiler(),
+                                      BackwardFilter backwardFilter = BackwardFilter(),
+                                      const num boundValue = inf);
 };
 
 template<class ForwardFiler,
@@ -61,6 +160,18 @@ SearchResult BidirectionalRouter::shortestPath(Vertex source,
                                                BackwardFilter backwardFilter,
                                                const num boundValue)
 {
+  if(concurrent)
+  {
+    return concurrentShortestPath<ForwardFiler,
+                                  BackwardFilter,
+                                  bounded>(source,
+                                           target,
+                                           costs,
+                                           forwardFilter,
+                                           backwardFilter,
+                                           boundValue);
+  }
+
   int settled = 0, labeled = 0;
   bool found = false;
 
@@ -205,6 +316,196 @@ SearchResult BidirectionalRouter::shortestPath(Vertex source,
   return SearchResult::notFound(settled, labeled);
 }
 
+template<Direction direction,
+         class Filter,
+         bool bounded>
+void BidirectionalRouter::search(const EdgeFunc<num>& costs,
+                                 Filter filter,
+                                 const num boundValue,
+                                 LabelHeap<Label>& heap,
+                                 std::vector<std::atomic<num>>& distances,
+                                 const std::vector<std::atomic<num>>& otherDistances,
+                                 Meeting& meeting,
+                                 int& settled,
+                                 int& labeled)
+{
+  const idx own = (direction == Direction::OUTGOING) ? 0 : 1;
+
+  while(!(meeting.done.load() or heap.isEmpty()))
+  {
+    const num top = heap.peek().getCost();
+    meeting.tops[own].store(top);
+
+    // read the other key before the split value, all meeting points
+    // found by the other search before publishing its key are visible
+    const num otherTop = meeting.tops[1 - own].load();
+
+    if(otherTop == inf)
+    {
+      break;
+    }
+
+    const num bestValue = top + otherTop;
+
+    if(bestValue >= meeting.splitValue.load())
+    {
+      break;
+    }
+
+    if(bounded and bestValue > boundValue)
+    {
+      break;
+    }
+
+    Label current = heap.extractMin();
+
+    ++settled;
+
+    for(const Edge& edge : graph.getEdges(current.getVertex(), direction))
+    {
+      if(!filter(edge))
+      {
+        continue;
+      }
+
+      Vertex nextVertex = edge.getEndpoint(direction);
+      num nextCost = current.getCost() + costs(edge);
+      ++labeled;
+
+      heap.update(Label(nextVertex, edge, nextCost));
+
+      std::atomic<num>& distance = distances[nextVertex.getIndex()];
+
+      if(nextCost < distance.load())
+      {
+        distance.store(nextCost);
+      }
+
+      // the distance is published before the other one is read,
+      // so at least one of the searches discovers each meeting point
+      const num otherDistance = otherDistances[nextVertex.getIndex()].load();
+
+      if(otherDistance != inf)
+      {
+        meeting.update(nextVertex, otherDistance + nextCost);
+      }
+    }
+  }
+
+  meeting.tops[own].store(inf);
+  meeting.done.store(true);
+}
+
+template<class ForwardFiler,
+         class BackwardFilter,
+         bool bounded>
+SearchResult BidirectionalRouter::concurrentShortestPath(Vertex source,
+                                                         Vertex target,
+                                                         const EdgeFunc<num>& costs,
+                                                         ForwardFiler forwardFilter,
+                                                         BackwardFilter backwardFilter,
+                                                         const num boundValue)
+{
+  if(source == target)
+  {
+    return SearchResult(0, 0, true, Path(), 0);
+  }
+
+  const idx size = graph.getVertices().size();
+
+  LabelHeap<Label> forwardHeap(graph);
+  LabelHeap<Label> backwardHeap(graph);
+
+  std::vector<std::atomic<num>> forwardDistances(size), backwardDistances(size);
+
+  for(idx i = 0; i < size; ++i)
+  {
+    forwardDistances[i].store(inf, std::memory_order_relaxed);
+    backwardDistances[i].store(inf, std::memory_order_relaxed);
+  }
+
+  // the endpoints are labeled before starting the searches in order
+  // to let each search discover a meeting at the other endpoint
+  forwardHeap.update(Label(source, Edge(), 0));
+  backwardHeap.update(Label(target, Edge(), 0));
+
+  forwardDistances[source.getIndex()].store(0);
+  backwardDistances[target.getIndex()].store(0);
+
+  Meeting meeting;
+
+  int forwardSettled = 0, forwardLabeled = 0;
+  int backwardSettled = 0, backwardLabeled = 0;
+
+  tbb::task_group group;
+
+  group.run([&]()
+            {
+              search<Direction::INCOMING,
+                     BackwardFilter,
+                     bounded>(costs,
+                              backwardFilter,
+                              boundValue,
+                              backwardHeap,
+                              backwardDistances,
+                              forwardDistances,
+                              meeting,
+                              backwardSettled,
+                              backwardLabeled);
+            });
+
+  search<Direction::OUTGOING,
+         ForwardFiler,
+         bounded>(costs,
+                  forwardFilter,
+                  boundValue,
+                  forwardHeap,
+                  forwardDistances,
+                  backwardDistances,
+                  meeting,
+                  forwardSettled,
+                  forwardLabeled);
+
+  group.wait();
+
+  const int settled = forwardSettled + backwardSettled;
+  const int labeled = forwardLabeled + backwardLabeled;
+
+  const num splitValue = meeting.splitValue.load();
+  const Vertex split = meeting.split;
+
+  if(splitValue == inf or (bounded and splitValue > boundValue))
+  {
+    return SearchResult::notFound(settled, labeled);
+  }
+
+  Path path;
+
+  Label current = forwardHeap.getLabel(split);
+
+  while(!(current.getVertex() == source))
+  {
+    Edge edge = current.getEdge();
+    assert(forwardFilter(edge));
+    path.prepend(edge);
+    current = forwardHeap.getLabel(edge.getSource());
+  }
+
+  current = backwardHeap.getLabel(split);
+
+  while(!(current.getVertex() == target))
+  {
+    Edge edge = current.getEdge();
+    assert(backwardFilter(edge));
+    path.append(edge);
+    current = backwardHeap.getLabel(edge.getTarget());
+  }
+
+  assert(path.connects(source, target));
+  assert(path.cost(costs) == splitValue);
+
+  return SearchResult(settled, labeled, true, path, splitValue);
+}
 
 /**
  * A class which finds a shortest path by performing a bidirectional
@@ -218,6 +519,9 @@ public:
     : BidirectionalRouter(graph)
   {}
 
+  using BidirectionalRouter::isConcurrent;
+  using BidirectionalRouter::setConcurrent;
+
   SearchResult shortestPath(Vertex source,
                             Vertex target,
                             const EdgeFunc<num>& costs) override
@@ -0,0 +1,196 @@
+#include "numa_topology.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include <dirent.h>
+#include <sched.h>
+
+namespace
+{
+  const std::string nodeDirectory = "/sys/devices/system/node";
+
+  std::vector<int> allowedCpus()
+  {
+    std::vector<int> cpus;
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+
+    if(sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+      for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      {
+        if(CPU_ISSET(cpu, &set))
+        {
+          cpus.push_back(cpu);
+        }
+      }
+    }
+
+    if(cpus.empty())
+    {
+      cpus.push_back(0);
+    }
+
+    return cpus;
+  }
+
+  std::map<int, std::vector<int>> readNodes()
+  {
+    std::map<int, std::vector<int>> nodes;
+
+    DIR* directory = opendir(nodeDirectory.c_str());
+
+    if(!directory)
+    {
+      return nodes;
+    }
+
+    while(dirent* entry = readdir(directory))
+    {
+      const std::string name = entry->d_name;
+
+      if(name.size() <= 4 or name.compare(0, 4, "node") or
+         name.find_first_not_of("0123456789", 4) != std::string::npos)
+      {
+        continue;
+      }
+
+      std::ifstream input(nodeDirectory + "/" + name + "/cpulist");
+      std::string list;
+
+      if(!std::getline(input, list))
+      {
+        continue;
+      }
+
+      try
+      {
+        nodes[std::stoi(name.substr(4))] = NumaTopology::parseCpuList(list);
+      }
+      catch(const std::invalid_argument&)
+      {
+        continue;
+      }
+    }
+
+    closedir(directory);
+
+    return nodes;
+  }
+}
+
+NumaTopology::NumaTopology(const std::vector<std::vector<int>>& nodes)
+  : nodes(nodes)
+{
+  if(nodes.empty())
+  {
+    throw std::invalid_argument("A topology requires at least one node");
+  }
+
+  for(const std::vector<int>& cpus : nodes)
+  {
+    if(cpus.empty())
+    {
+      throw std::invalid_argument("Each node requires at least one CPU");
+    }
+  }
+}
+
+NumaTopology NumaTopology::detect()
+{
+  const std::vector<int> allowed = allowedCpus();
+  std::vector<std::vector<int>> nodes;
+
+  for(const auto& node : readNodes())
+  {
+    std::vector<int> cpus;
+
+    std::set_intersection(node.second.begin(), node.second.end(),
+                          allowed.begin(), allowed.end(),
+                          std::back_inserter(cpus));
+
+    if(!cpus.empty())
+    {
+      nodes.push_back(cpus);
+    }
+  }
+
+  if(nodes.empty())
+  {
+    nodes.push_back(allowed);
+  }
+
+  return NumaTopology(nodes);
+}
+
+std::vector<int> NumaTopology::parseCpuList(const std::string& list)
+{
+  std::vector<int> cpus;
+  std::istringstream input(list);
+  std::string range;
+
+  while(std::getline(input, range, ','))
+  {
+    range.erase(std::remove_if(range.begin(), range.end(), ::isspace),
+                range.end());
+
+    if(range.empty())
+    {
+      continue;
+    }
+
+    const size_t separator = range.find('-');
+
+    try
+    {
+      const int first = std::stoi(range.substr(0, separator));
+      const int last = (separator == std::string::npos) ?
+        first :
+        std::stoi(range.substr(separator + 1));
+
+      if(first < 0 or last < first)
+      {
+        throw std::invalid_argument(range);
+      }
+
+      for(int cpu = first; cpu <= last; ++cpu)
+      {
+        cpus.push_back(cpu);
+      }
+    }
+    catch(const std::logic_error&)
+    {
+      throw std::invalid_argument("Invalid CPU list: " + list);
+    }
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+  return cpus;
+}
+
+bool NumaTopology::pin(idx node) const
+{
+  cpu_set_t set;
+
+  CPU_ZERO(&set);
+
+  for(int cpu : getCpus(node))
+  {
+    if(cpu < CPU_SETSIZE)
+    {
+      CPU_SET(cpu, &set);
+    }
+  }
+
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
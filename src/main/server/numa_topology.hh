@@ -0,0 +1,64 @@
+#ifndef NUMA_TOPOLOGY_HH
+#define NUMA_TOPOLOGY_HH
+
+#include <string>
+#include <vector>
+
+#include "util.hh"
+
+/**
+ * The NUMA nodes of the machine together with the CPUs
+ * of each node which the process may run on.
+ **/
+class NumaTopology
+{
+private:
+  std::vector<std::vector<int>> nodes;
+
+public:
+  /**
+   * Constructs a NumaTopology consisting of the given
+   * (non-empty) lists of CPUs.
+   *
+   * @throws std::invalid_argument if there are no nodes or
+   *         some node does not contain any CPU
+   **/
+  explicit NumaTopology(const std::vector<std::vector<int>>& nodes);
+
+  /**
+   * Detects the nodes via /sys/devices/system/node. Nodes
+   * without any CPU the process may run on are omitted. If no
+   * nodes can be detected, a single node containing all
+   * permitted CPUs is returned.
+   **/
+  static NumaTopology detect();
+
+  /**
+   * Parses a list of CPUs given in the format of the
+   * kernel, such as "0-3,8,10-11".
+   *
+   * @throws std::invalid_argument if the list is malformed
+   **/
+  static std::vector<int> parseCpuList(const std::string& list);
+
+  idx size() const
+  {
+    return nodes.size();
+  }
+
+  const std::vector<int>& getCpus(idx node) const
+  {
+    return nodes[node];
+  }
+
+  /**
+   * Restricts the calling thread to the CPUs of the given node.
+   * Memory which is subsequently touched first by the thread
+   * is thereby allocated on the node.
+   *
+   * @returns whether the affinity of the thread could be set
+   **/
+  bool pin(idx node) const;
+};
+
+#endif /* NUMA_TOPOLOGY_HH */
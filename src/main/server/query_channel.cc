@@ -0,0 +1,196 @@
+#include "query_channel.hh"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <unistd.h>
+
+bool QueryChannel::readValues(uint32_t* values, idx count, bool allowEnd)
+{
+  char* data = reinterpret_cast<char*>(values);
+  const size_t size = count * sizeof(uint32_t);
+  size_t position = 0;
+
+  while(position < size)
+  {
+    const ssize_t result = read(input, data + position, size - position);
+
+    if(result < 0)
+    {
+      if(errno == EINTR)
+      {
+        continue;
+      }
+
+      throw std::runtime_error(std::string("Failed to read from channel: ")
+                               + std::strerror(errno));
+    }
+
+    if(result == 0)
+    {
+      if(allowEnd and position == 0)
+      {
+        return false;
+      }
+
+      throw std::runtime_error("Channel closed within a frame");
+    }
+
+    position += result;
+  }
+
+  return true;
+}
+
+uint32_t QueryChannel::readValue()
+{
+  uint32_t value;
+  readValues(&value, 1, false);
+  return value;
+}
+
+void QueryChannel::flush()
+{
+  const char* data = reinterpret_cast<const char*>(buffer.data());
+  const size_t size = buffer.size() * sizeof(uint32_t);
+  size_t position = 0;
+
+  while(position < size)
+  {
+    const ssize_t result = write(output, data + position, size - position);
+
+    if(result < 0)
+    {
+      if(errno == EINTR)
+      {
+        continue;
+      }
+
+      buffer.clear();
+
+      throw std::runtime_error(std::string("Failed to write to channel: ")
+                               + std::strerror(errno));
+    }
+
+    position += result;
+  }
+
+  buffer.clear();
+}
+
+void QueryChannel::writeHeader(idx numVertices)
+{
+  writeValue(magic);
+  writeValue(version);
+  writeValue(numVertices);
+
+  flush();
+}
+
+idx QueryChannel::readHeader()
+{
+  uint32_t header[3];
+
+  if(!readValues(header, 3, true))
+  {
+    throw std::runtime_error("Channel closed before the header");
+  }
+
+  if(header[0] != magic or header[1] != version)
+  {
+    throw std::runtime_error("Invalid query server header");
+  }
+
+  return header[2];
+}
+
+bool QueryChannel::readQueries(std::vector<Query>& queries)
+{
+  uint32_t size;
+
+  if(!readValues(&size, 1, true))
+  {
+    return false;
+  }
+
+  if(size > maxBatchSize)
+  {
+    throw std::runtime_error("Request exceeds the maximum batch size");
+  }
+
+  std::vector<uint32_t> values(2 * size);
+
+  readValues(values.data(), values.size(), false);
+
+  queries.clear();
+  queries.reserve(size);
+
+  for(idx i = 0; i < size; ++i)
+  {
+    queries.push_back(Query(values[2*i], values[2*i + 1]));
+  }
+
+  return true;
+}
+
+void QueryChannel::writeQueries(const std::vector<Query>& queries)
+{
+  writeValue(queries.size());
+
+  for(const Query& query : queries)
+  {
+    writeValue(query.source);
+    writeValue(query.target);
+  }
+
+  flush();
+}
+
+bool QueryChannel::readAnswers(std::vector<QueryAnswer>& answers)
+{
+  uint32_t size;
+
+  if(!readValues(&size, 1, true))
+  {
+    return false;
+  }
+
+  if(size > maxBatchSize)
+  {
+    throw std::runtime_error("Response exceeds the maximum batch size");
+  }
+
+  answers.clear();
+  answers.resize(size);
+
+  for(QueryAnswer& answer : answers)
+  {
+    answer.cost = (num) readValue();
+    answer.found = (answer.cost != inf);
+
+    answer.vertices.resize(readValue());
+
+    readValues(answer.vertices.data(), answer.vertices.size(), false);
+  }
+
+  return true;
+}
+
+void QueryChannel::writeAnswers(const std::vector<QueryAnswer>& answers)
+{
+  writeValue(answers.size());
+
+  for(const QueryAnswer& answer : answers)
+  {
+    writeValue(answer.found ? answer.cost : inf);
+    writeValue(answer.vertices.size());
+
+    for(idx vertex : answer.vertices)
+    {
+      writeValue(vertex);
+    }
+  }
+
+  flush();
+}
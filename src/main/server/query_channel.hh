@@ -0,0 +1,125 @@
+#ifndef QUERY_CHANNEL_HH
+#define QUERY_CHANNEL_HH
+
+#include <cstdint>
+#include <vector>
+
+#include "util.hh"
+
+/**
+ * A robust query from a source to a target, given by
+ * the indices of the Vertex%s.
+ **/
+class Query
+{
+public:
+  Query(idx source, idx target)
+    : source(source),
+      target(target)
+  {}
+
+  Query()
+    : source(0),
+      target(0)
+  {}
+
+  idx source, target;
+};
+
+/**
+ * The answer to a Query. If a Path was found, it contains
+ * the robust cost of the Path and the indices of the
+ * Vertex%s along the Path, starting with the source.
+ **/
+class QueryAnswer
+{
+public:
+  QueryAnswer()
+    : found(false),
+      cost(inf)
+  {}
+
+  bool found;
+  num cost;
+  std::vector<idx> vertices;
+};
+
+/**
+ * A channel transferring batches of Query%s and QueryAnswer%s
+ * between a QueryServer and its clients via a pair of file
+ * descriptors, e.g., a connected Unix domain socket or
+ * stdin / stdout. All values are written as 32 bit integers
+ * in host byte order, since both ends live on the same machine:
+ *
+ * - the server header: the magic number, the protocol version
+ *   and the number of vertices of the served Graph
+ * - a request: the number of Query%s followed by the source
+ *   and target index of each Query
+ * - a response: the number of QueryAnswer%s, followed by
+ *   the robust cost (inf if no Path was found), the number
+ *   of Vertex%s and the Vertex indices of each QueryAnswer
+ *
+ * Malformed frames and I/O errors raise a std::runtime_error.
+ **/
+class QueryChannel
+{
+private:
+  int input, output;
+  std::vector<uint32_t> buffer;
+
+  bool readValues(uint32_t* values, idx count, bool allowEnd);
+  uint32_t readValue();
+
+  void writeValue(uint32_t value)
+  {
+    buffer.push_back(value);
+  }
+
+  void flush();
+
+public:
+  static const uint32_t magic = 0x52425153;
+  static const uint32_t version = 1;
+
+  /**
+   * The maximum number of Query%s in a single request.
+   **/
+  static const uint32_t maxBatchSize = 1 << 20;
+
+  QueryChannel(int input, int output)
+    : input(input),
+      output(output)
+  {}
+
+  explicit QueryChannel(int socket)
+    : QueryChannel(socket, socket)
+  {}
+
+  /**
+   * Writes the server header.
+   **/
+  void writeHeader(idx numVertices);
+
+  /**
+   * Reads the server header and returns the number of vertices.
+   **/
+  idx readHeader();
+
+  /**
+   * Reads a request. Returns false if the channel was closed
+   * before the start of the request.
+   **/
+  bool readQueries(std::vector<Query>& queries);
+
+  void writeQueries(const std::vector<Query>& queries);
+
+  /**
+   * Reads a response. Returns false if the channel was closed
+   * before the start of the response.
+   **/
+  bool readAnswers(std::vector<QueryAnswer>& answers);
+
+  void writeAnswers(const std::vector<QueryAnswer>& answers);
+};
+
+#endif /* QUERY_CHANNEL_HH */
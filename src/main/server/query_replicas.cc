@@ -0,0 +1,109 @@
+#include "query_replicas.hh"
+
+#include <exception>
+#include <thread>
+
+#include "log.hh"
+
+QueryReplica::QueryReplica(const QueryData& original)
+  : graph(original.graph),
+    costs(graph, original.costs),
+    deviations(graph, original.deviations),
+    costValues(costs),
+    deviationValues(deviations),
+    data(graph, costValues, deviationValues, original.deviationSize)
+{
+  if(original.hierarchy)
+  {
+    hierarchy.reset(new ContractionHierarchy(*original.hierarchy));
+  }
+
+  if(original.robustHierarchy)
+  {
+    robustHierarchy.reset(new RobustContractionHierarchy(*original.robustHierarchy));
+  }
+
+  if(original.incomingFlags)
+  {
+    incomingFlags.reset(new ArcFlags(graph, *original.incomingFlags));
+  }
+
+  if(original.outgoingFlags)
+  {
+    outgoingFlags.reset(new ArcFlags(graph, *original.outgoingFlags));
+  }
+
+  data.hierarchy = hierarchy.get();
+  data.robustHierarchy = robustHierarchy.get();
+
+  data.flagPartition = original.flagPartition;
+  data.incomingFlags = incomingFlags.get();
+  data.outgoingFlags = outgoingFlags.get();
+
+  data.valuePartition = original.valuePartition;
+  data.requiredValues = original.requiredValues;
+}
+
+ReplicatedQueryData::ReplicatedQueryData(const QueryData& original,
+                                         const NumaTopology& topology)
+  : original(original)
+{
+  if(topology.size() == 1)
+  {
+    return;
+  }
+
+  replicas.resize(topology.size());
+
+  std::vector<std::exception_ptr> errors(topology.size());
+  std::vector<std::thread> threads;
+
+  for(idx node = 0; node < topology.size(); ++node)
+  {
+    threads.push_back(std::thread([&, node]()
+      {
+        try
+        {
+          if(!topology.pin(node))
+          {
+            Log(warning) << "Could not pin replication thread to node " << node;
+          }
+
+          replicas[node].reset(new QueryReplica(original));
+        }
+        catch(...)
+        {
+          errors[node] = std::current_exception();
+        }
+      }));
+  }
+
+  for(std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  for(const std::exception_ptr& error : errors)
+  {
+    if(error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+
+  Log(info) << "Replicated the query data on " << topology.size() << " nodes";
+}
+
+std::vector<RobustRouterFactory> createRouterFactories(const std::string& name,
+                                                       bool searching,
+                                                       const ReplicatedQueryData& data)
+{
+  std::vector<RobustRouterFactory> factories;
+
+  for(idx node = 0; node < data.size(); ++node)
+  {
+    factories.push_back(createRouterFactory(name, searching, data.get(node)));
+  }
+
+  return factories;
+}
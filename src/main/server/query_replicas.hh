@@ -0,0 +1,84 @@
+#ifndef QUERY_REPLICAS_HH
+#define QUERY_REPLICAS_HH
+
+#include <memory>
+#include <vector>
+
+#include "numa_topology.hh"
+#include "query_routers.hh"
+
+/**
+ * A copy of the per-vertex and per-edge data of some QueryData:
+ * the Graph, its costs and deviations, the (robust) contraction
+ * hierarchies and the ArcFlags. The Partition%s and the required
+ * values are only accessed once per query and remain shared with
+ * the original QueryData.
+ **/
+class QueryReplica
+{
+private:
+  Graph graph;
+  EdgeMap<num> costs, deviations;
+  EdgeValueMap<num> costValues, deviationValues;
+
+  std::unique_ptr<ContractionHierarchy> hierarchy;
+  std::unique_ptr<RobustContractionHierarchy> robustHierarchy;
+  std::unique_ptr<ArcFlags> incomingFlags, outgoingFlags;
+
+  QueryData data;
+
+public:
+  QueryReplica(const QueryData& original);
+
+  QueryReplica(const QueryReplica& other) = delete;
+  QueryReplica& operator=(const QueryReplica& other) = delete;
+
+  const QueryData& getData() const
+  {
+    return data;
+  }
+};
+
+/**
+ * QueryData replicated across the nodes of a NumaTopology. Each
+ * replica is built by a thread pinned to its node, placing the
+ * replica into the memory of the node on first touch. On a
+ * topology with a single node the original QueryData is used.
+ **/
+class ReplicatedQueryData
+{
+private:
+  const QueryData& original;
+  std::vector<std::unique_ptr<QueryReplica>> replicas;
+
+public:
+  ReplicatedQueryData(const QueryData& original,
+                      const NumaTopology& topology);
+
+  /**
+   * Returns the number of nodes.
+   **/
+  idx size() const
+  {
+    return replicas.empty() ? 1 : replicas.size();
+  }
+
+  /**
+   * Returns the QueryData local to the given node.
+   **/
+  const QueryData& get(idx node) const
+  {
+    return replicas.empty() ? original : replicas[node]->getData();
+  }
+};
+
+/**
+ * Returns one factory per node of the given ReplicatedQueryData,
+ * each creating routers on the data local to its node.
+ * @see createRouterFactory()
+ **/
+std::vector<RobustRouterFactory> createRouterFactories(const std::string& name,
+                                                       bool searching,
+                                                       const ReplicatedQueryData& data);
+
+#endif /* QUERY_REPLICAS_HH */
@@ -0,0 +1,234 @@
+#include "query_routers.hh"
+
+#include <functional>
+#include <stdexcept>
+
+#include "robust/searching_robust_router.hh"
+#include "robust/simple_robust_router.hh"
+
+#include "robust/theta/bounding_router.hh"
+#include "robust/theta/composed_theta_router.hh"
+#include "robust/theta/goal_directed_bounding_router.hh"
+#include "robust/theta/goal_directed_router.hh"
+#include "robust/theta/simple_theta_router.hh"
+
+#include "robust/values/robust_value_router.hh"
+
+namespace
+{
+  typedef std::function<std::shared_ptr<ThetaRouter>()> ThetaRouterFactory;
+
+  template <class Theta>
+  ThetaRouterFactory simpleFactory(const QueryData& data)
+  {
+    return [&data]() -> std::shared_ptr<ThetaRouter>
+      {
+        return std::make_shared<Theta>(data.graph,
+                                       data.costs,
+                                       data.deviations,
+                                       data.deviationSize);
+      };
+  }
+
+  template <class FilterPolicy, class PotentialPolicy, class PruningPolicy>
+  ThetaRouterFactory composedFactory(const QueryData& data,
+                                     std::function<FilterPolicy()> createFilter,
+                                     std::function<PotentialPolicy()> createPotential)
+  {
+    return [&data, createFilter, createPotential]() -> std::shared_ptr<ThetaRouter>
+      {
+        return std::make_shared<ComposedThetaRouter<FilterPolicy,
+                                                    PotentialPolicy,
+                                                    PruningPolicy>>(
+          data.graph,
+          data.costs,
+          data.deviations,
+          data.deviationSize,
+          createFilter(),
+          createPotential(),
+          PruningPolicy(data.graph));
+      };
+  }
+
+  /**
+   * The SearchingRobustRouter relies on exact theta-distances,
+   * which is why upper bound pruning is only used otherwise.
+   **/
+  template <class FilterPolicy, class PotentialPolicy>
+  ThetaRouterFactory composedFactory(const QueryData& data,
+                                     bool searching,
+                                     std::function<FilterPolicy()> createFilter,
+                                     std::function<PotentialPolicy()> createPotential)
+  {
+    if(searching)
+    {
+      return composedFactory<FilterPolicy,
+                             PotentialPolicy,
+                             NoPruning>(data, createFilter, createPotential);
+    }
+
+    return composedFactory<FilterPolicy,
+                           PotentialPolicy,
+                           UpperBoundPruning>(data, createFilter, createPotential);
+  }
+
+  void require(bool present, const std::string& name, const std::string& what)
+  {
+    if(!present)
+    {
+      throw std::invalid_argument("The router " + name + " requires " + what);
+    }
+  }
+
+  ThetaRouterFactory thetaFactory(const std::string& name,
+                                  bool searching,
+                                  const QueryData& data)
+  {
+    auto unfiltered = [&data]() -> UnfilteredEdges
+      {
+        return UnfilteredEdges(data.graph);
+      };
+
+    auto valueFlags = [&data]() -> ValueArcFlagEdgeFilter
+      {
+        return ValueArcFlagEdgeFilter(*data.flagPartition,
+                                      *data.incomingFlags,
+                                      *data.outgoingFlags);
+      };
+
+    auto noPotential = [&data]() -> NoPotential
+      {
+        return NoPotential(data.graph);
+      };
+
+    auto contractionPotential = [&data]() -> ContractionGoalPotential
+      {
+        return ContractionGoalPotential(data.graph, *data.hierarchy);
+      };
+
+    if(name == "simple")
+    {
+      return simpleFactory<SimpleThetaRouter>(data);
+    }
+    else if(name == "bounding")
+    {
+      if(searching)
+      {
+        throw std::invalid_argument("The router " + name + " cannot be used for searching");
+      }
+
+      return simpleFactory<BoundingRouter>(data);
+    }
+    else if(name == "goal-directed")
+    {
+      if(searching)
+      {
+        return simpleFactory<GoalDirectedRouter>(data);
+      }
+
+      return simpleFactory<GoalDirectedBoundingRouter>(data);
+    }
+    else if(name == "contraction")
+    {
+      require(data.hierarchy, name, "a contraction hierarchy");
+
+      return composedFactory<UnfilteredEdges,
+                             ContractionGoalPotential>(data,
+                                                       searching,
+                                                       unfiltered,
+                                                       contractionPotential);
+    }
+    else if(name == "robust-contraction")
+    {
+      require(data.robustHierarchy, name, "a robust contraction hierarchy");
+
+      return [&data]() -> std::shared_ptr<ThetaRouter>
+        {
+          return std::make_shared<RobustContractionHierarchy::Router>(*data.robustHierarchy);
+        };
+    }
+    else if(name == "arcflags" or name == "arcflags-contraction")
+    {
+      require(data.incomingFlags and data.outgoingFlags, name, "arc flags");
+      require(data.requiredValues, name, "the required values of the arc flags");
+
+      if(name == "arcflags")
+      {
+        return composedFactory<ValueArcFlagEdgeFilter,
+                               NoPotential>(data,
+                                            searching,
+                                            valueFlags,
+                                            noPotential);
+      }
+
+      require(data.hierarchy, name, "a contraction hierarchy");
+
+      return composedFactory<ValueArcFlagEdgeFilter,
+                             ContractionGoalPotential>(data,
+                                                       searching,
+                                                       valueFlags,
+                                                       contractionPotential);
+    }
+
+    throw std::invalid_argument("Unknown router: " + name);
+  }
+}
+
+std::vector<std::string> queryRouterNames()
+{
+  return {"simple",
+          "bounding",
+          "goal-directed",
+          "contraction",
+          "robust-contraction",
+          "arcflags",
+          "arcflags-contraction"};
+}
+
+RobustRouterFactory createRouterFactory(const std::string& name,
+                                        bool searching,
+                                        const QueryData& data)
+{
+  ThetaRouterFactory createThetaRouter = thetaFactory(name, searching, data);
+
+  return [&data, createThetaRouter, searching]() -> std::shared_ptr<RobustRouter>
+    {
+      std::shared_ptr<ThetaRouter> thetaRouter = createThetaRouter();
+      std::shared_ptr<RobustRouter> router;
+
+      if(searching)
+      {
+        router = std::make_shared<SearchingRobustRouter>(data.graph,
+                                                         data.costs,
+                                                         data.deviations,
+                                                         data.deviationSize,
+                                                         *thetaRouter,
+                                                         SearchingRobustRouter::BOUNDING);
+      }
+      else
+      {
+        router = std::make_shared<SimpleRobustRouter>(data.graph,
+                                                      data.costs,
+                                                      data.deviations,
+                                                      data.deviationSize,
+                                                      *thetaRouter);
+      }
+
+      std::shared_ptr<RobustRouter> outerRouter = router;
+
+      if(data.requiredValues)
+      {
+        outerRouter = std::make_shared<RobustValueRouter>(data.costs,
+                                                          data.deviations,
+                                                          data.deviationSize,
+                                                          *router,
+                                                          *data.valuePartition,
+                                                          *data.requiredValues);
+      }
+
+      // the returned pointer keeps all underlying routers alive
+      return std::shared_ptr<RobustRouter>(outerRouter.get(),
+                                           [thetaRouter, router, outerRouter](RobustRouter*)
+                                           {});
+    };
+}
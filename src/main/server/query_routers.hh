@@ -0,0 +1,92 @@
+#ifndef QUERY_ROUTERS_HH
+#define QUERY_ROUTERS_HH
+
+#include <string>
+#include <vector>
+
+#include "graph/graph.hh"
+#include "graph/edge_map.hh"
+
+#include "arcflags/arcflags.hh"
+#include "arcflags/partition.hh"
+#include "arcflags/region_pair_map.hh"
+
+#include "contraction/contraction_hierarchy.hh"
+
+#include "robust/contraction/robust_contraction_hierarchy.hh"
+#include "robust/robust_utils.hh"
+
+#include "query_server.hh"
+
+/**
+ * The data served by a QueryServer. Apart from the Graph
+ * and its costs, all preprocessed data is optional.
+ **/
+class QueryData
+{
+public:
+  QueryData(const Graph& graph,
+            const EdgeFunc<num>& costs,
+            const EdgeFunc<num>& deviations,
+            idx deviationSize)
+    : graph(graph),
+      costs(costs),
+      deviations(deviations),
+      deviationSize(deviationSize),
+      hierarchy(nullptr),
+      robustHierarchy(nullptr),
+      flagPartition(nullptr),
+      incomingFlags(nullptr),
+      outgoingFlags(nullptr),
+      valuePartition(nullptr),
+      requiredValues(nullptr)
+  {}
+
+  const Graph& graph;
+  const EdgeFunc<num>& costs;
+  const EdgeFunc<num>& deviations;
+  idx deviationSize;
+
+  const ContractionHierarchy* hierarchy;
+  const RobustContractionHierarchy* robustHierarchy;
+
+  /**
+   * ArcFlags computed by the ValueArcFlagPreprocessor
+   * for the required values.
+   **/
+  const Partition* flagPartition;
+  const ArcFlags* incomingFlags;
+  const ArcFlags* outgoingFlags;
+
+  /**
+   * The required values of all pairs of Region%s. If present,
+   * only the required values are evaluated.
+   **/
+  const Partition* valuePartition;
+  const RegionPairMap<ValueVector>* requiredValues;
+};
+
+/**
+ * Returns the names of the ThetaRouter%s which can be
+ * selected by createRouterFactory().
+ **/
+std::vector<std::string> queryRouterNames();
+
+/**
+ * Returns a factory of RobustRouter%s based on the ThetaRouter
+ * with the given name. The RobustRouter is a SearchingRobustRouter
+ * if requested and a SimpleRobustRouter otherwise. Since searching
+ * requires exact distances, the ThetaRouter%s do not prune by upper
+ * bounds in this case. The RobustRouter is restricted to the
+ * required values if the QueryData contains them. The QueryData
+ * must outlive the factory.
+ *
+ * @throws std::invalid_argument if the name is unknown or the
+ *         QueryData lacks the data required by the router or
+ *         the router cannot be used for searching
+ **/
+RobustRouterFactory createRouterFactory(const std::string& name,
+                                        bool searching,
+                                        const QueryData& data);
+
+#endif /* QUERY_ROUTERS_HH */
@@ -0,0 +1,372 @@
+#include "query_server.hh"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+
+#include "log.hh"
+
+#include "robust/robust_costs.hh"
+
+QueryServer::PinningObserver::PinningObserver(tbb::task_arena& arena,
+                                              const NumaTopology& topology,
+                                              idx node)
+  : tbb::task_scheduler_observer(arena),
+    topology(topology),
+    node(node)
+{
+  observe(true);
+}
+
+QueryServer::PinningObserver::~PinningObserver()
+{
+  observe(false);
+}
+
+void QueryServer::PinningObserver::on_scheduler_entry(bool worker)
+{
+  // threads calling into the server keep their affinity
+  if(worker)
+  {
+    topology.pin(node);
+  }
+}
+
+QueryServer::WorkerPool::WorkerPool(RobustRouterFactory factory,
+                                    int concurrency)
+  : factory(factory),
+    concurrency(concurrency),
+    arena(concurrency),
+    routers([this]() -> std::shared_ptr<RobustRouter>
+            {
+              return this->factory();
+            })
+{
+}
+
+QueryServer::QueryServer(const Graph& graph,
+                         const EdgeFunc<num>& costs,
+                         const EdgeFunc<num>& deviations,
+                         idx deviationSize,
+                         RobustRouterFactory factory,
+                         idx numThreads,
+                         idx grainSize)
+  : graph(graph),
+    costs(costs),
+    deviations(deviations),
+    deviationSize(deviationSize),
+    numVertices(graph.getVertices().size()),
+    grainSize(std::max(grainSize, (idx) 1)),
+    stopRequested(false),
+    listenSocket(-1)
+{
+  const int concurrency = (numThreads > 0) ?
+    (int) numThreads :
+    tbb::task_arena::automatic;
+
+  pools.push_back(std::unique_ptr<WorkerPool>(new WorkerPool(factory, concurrency)));
+}
+
+QueryServer::QueryServer(const Graph& graph,
+                         const EdgeFunc<num>& costs,
+                         const EdgeFunc<num>& deviations,
+                         idx deviationSize,
+                         const std::vector<RobustRouterFactory>& factories,
+                         const NumaTopology& topology,
+                         idx grainSize)
+  : graph(graph),
+    costs(costs),
+    deviations(deviations),
+    deviationSize(deviationSize),
+    numVertices(graph.getVertices().size()),
+    grainSize(std::max(grainSize, (idx) 1)),
+    topology(new NumaTopology(topology)),
+    stopRequested(false),
+    listenSocket(-1)
+{
+  if(factories.size() != topology.size())
+  {
+    throw std::invalid_argument("Expected one router factory per node");
+  }
+
+  for(idx node = 0; node < topology.size(); ++node)
+  {
+    const int concurrency = topology.getCpus(node).size();
+
+    pools.push_back(std::unique_ptr<WorkerPool>(new WorkerPool(factories[node],
+                                                               concurrency)));
+
+    if(topology.size() > 1)
+    {
+      WorkerPool& pool = *pools.back();
+
+      pool.observer.reset(new PinningObserver(pool.arena,
+                                              *this->topology,
+                                              node));
+    }
+  }
+
+  Log(info) << "Serving queries with " << pools.size() << " worker pools";
+}
+
+QueryAnswer QueryServer::answer(RobustRouter& router, const Query& query) const
+{
+  QueryAnswer answer;
+
+  if(query.source >= numVertices or query.target >= numVertices)
+  {
+    return answer;
+  }
+
+  const Vertex source(query.source), target(query.target);
+
+  RobustSearchResult result = router.shortestPath(source, target);
+
+  if(!result.found)
+  {
+    return answer;
+  }
+
+  answer.found = true;
+  answer.cost = RobustCosts(costs, deviations, deviationSize).get(result.path);
+
+  answer.vertices.reserve(result.path.getEdges().size() + 1);
+  answer.vertices.push_back(source.getIndex());
+
+  for(const Edge& edge : result.path.getEdges())
+  {
+    answer.vertices.push_back(edge.getTarget().getIndex());
+  }
+
+  return answer;
+}
+
+void QueryServer::answer(WorkerPool& pool,
+                         const std::vector<Query>& queries,
+                         std::vector<QueryAnswer>& answers,
+                         idx begin,
+                         idx end) const
+{
+  tbb::parallel_for(tbb::blocked_range<idx>(begin, end, grainSize),
+                    [&](const tbb::blocked_range<idx>& range)
+                    {
+                      RobustRouter& router = *(pool.routers.local());
+
+                      for(idx i = range.begin(); i != range.end(); ++i)
+                      {
+                        answers[i] = answer(router, queries[i]);
+                      }
+                    });
+}
+
+std::vector<QueryAnswer> QueryServer::answer(const std::vector<Query>& queries)
+{
+  std::vector<QueryAnswer> answers(queries.size());
+
+  if(pools.size() == 1)
+  {
+    WorkerPool& pool = *pools.front();
+
+    pool.arena.execute([&]()
+      {
+        answer(pool, queries, answers, 0, queries.size());
+      });
+
+    return answers;
+  }
+
+  idx totalConcurrency = 0;
+
+  for(const std::unique_ptr<WorkerPool>& pool : pools)
+  {
+    totalConcurrency += pool->concurrency;
+  }
+
+  // the nodes work on contiguous parts of the batch concurrently
+  std::vector<tbb::task_group> groups(pools.size());
+  idx begin = 0, concurrency = 0;
+
+  for(idx node = 0; node < pools.size(); ++node)
+  {
+    WorkerPool& pool = *pools[node];
+
+    concurrency += pool.concurrency;
+
+    const idx end = (idx) ((((std::size_t) queries.size()) * concurrency) / totalConcurrency);
+
+    pool.arena.execute([&, begin, end]()
+      {
+        groups[node].run([this, &pool, &queries, &answers, begin, end]()
+                         {
+                           answer(pool, queries, answers, begin, end);
+                         });
+      });
+
+    begin = end;
+  }
+
+  for(idx node = 0; node < pools.size(); ++node)
+  {
+    pools[node]->arena.execute([&]()
+      {
+        groups[node].wait();
+      });
+  }
+
+  return answers;
+}
+
+idx QueryServer::serve(QueryChannel& channel)
+{
+  std::vector<Query> queries;
+  idx numQueries = 0, numBatches = 0;
+
+  auto start = std::chrono::steady_clock::now();
+
+  channel.writeHeader(numVertices);
+
+  while(channel.readQueries(queries))
+  {
+    channel.writeAnswers(answer(queries));
+
+    numQueries += queries.size();
+    ++numBatches;
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  Log(info) << "Answered " << numQueries
+            << " queries in " << numBatches
+            << " batches within " << elapsed.count()
+            << " seconds";
+
+  return numQueries;
+}
+
+void QueryServer::serveConnection(int socket)
+{
+  try
+  {
+    QueryChannel channel(socket);
+    serve(channel);
+  }
+  catch(const std::exception& exception)
+  {
+    Log(warning) << "Closing connection: " << exception.what();
+  }
+
+  // the socket is untracked before closing it, since accept()
+  // may reuse its descriptor immediately afterwards
+  {
+    std::lock_guard<std::mutex> lock(connectionMutex);
+    connections.erase(socket);
+    connectionsClosed.notify_all();
+  }
+
+  close(socket);
+}
+
+void QueryServer::listen(const std::string& path)
+{
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+
+  if(path.size() >= sizeof(address.sun_path))
+  {
+    throw std::invalid_argument("Socket path is too long");
+  }
+
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+  const int currentSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+
+  if(currentSocket < 0)
+  {
+    throw std::runtime_error("Could not create socket");
+  }
+
+  unlink(path.c_str());
+
+  if(bind(currentSocket, (sockaddr*) &address, sizeof(address)) < 0 or
+     ::listen(currentSocket, SOMAXCONN) < 0)
+  {
+    close(currentSocket);
+    throw std::runtime_error(std::string("Could not listen on ") + path
+                             + ": " + std::strerror(errno));
+  }
+
+  // a concurrent stop() either observes the socket or is
+  // observed by the loop
+  listenSocket = currentSocket;
+
+  Log(info) << "Listening on " << path;
+
+  while(!stopRequested)
+  {
+    const int connection = accept(currentSocket, nullptr, nullptr);
+
+    if(connection < 0)
+    {
+      if(errno == EINTR or errno == ECONNABORTED)
+      {
+        continue;
+      }
+
+      if(!stopRequested)
+      {
+        Log(error) << "Failed to accept connection: " << std::strerror(errno);
+      }
+
+      break;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(connectionMutex);
+      connections.insert(connection);
+    }
+
+    std::thread(&QueryServer::serveConnection, this, connection).detach();
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(connectionMutex);
+
+    for(int connection : connections)
+    {
+      shutdown(connection, SHUT_RDWR);
+    }
+
+    connectionsClosed.wait(lock, [this]() -> bool
+                           {
+                             return connections.empty();
+                           });
+  }
+
+  listenSocket = -1;
+  close(currentSocket);
+  unlink(path.c_str());
+
+  stopRequested = false;
+}
+
+void QueryServer::stop()
+{
+  stopRequested = true;
+
+  const int currentSocket = listenSocket;
+
+  if(currentSocket >= 0)
+  {
+    shutdown(currentSocket, SHUT_RDWR);
+  }
+}
@@ -0,0 +1,168 @@
+#ifndef QUERY_SERVER_HH
+#define QUERY_SERVER_HH
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+
+#include "graph/graph.hh"
+#include "graph/edge_map.hh"
+
+#include "robust/robust_router.hh"
+
+#include "numa_topology.hh"
+#include "query_channel.hh"
+
+/**
+ * A factory creating independent RobustRouter%s. Since most
+ * routers are stateful, each worker uses a router of its own.
+ * The returned pointer owns all objects the router depends on.
+ **/
+typedef std::function<std::shared_ptr<RobustRouter>()> RobustRouterFactory;
+
+/**
+ * A long-running server answering batches of robust queries
+ * received via QueryChannel%s. The Query%s of each batch are
+ * distributed among a pool of workers (or among one pool per
+ * NUMA node). Connections on a Unix domain socket are served
+ * concurrently, sharing the same pools.
+ **/
+class QueryServer
+{
+private:
+  /**
+   * Pins the workers entering an arena to the CPUs of a node.
+   **/
+  class PinningObserver : public tbb::task_scheduler_observer
+  {
+  private:
+    const NumaTopology& topology;
+    const idx node;
+
+  public:
+    PinningObserver(tbb::task_arena& arena,
+                    const NumaTopology& topology,
+                    idx node);
+
+    ~PinningObserver();
+
+    void on_scheduler_entry(bool worker) override;
+  };
+
+  /**
+   * A pool of workers, each using a router of its own.
+   **/
+  class WorkerPool
+  {
+  public:
+    WorkerPool(RobustRouterFactory factory, int concurrency);
+
+    RobustRouterFactory factory;
+    const int concurrency;
+    tbb::task_arena arena;
+    tbb::enumerable_thread_specific<std::shared_ptr<RobustRouter>> routers;
+    std::unique_ptr<PinningObserver> observer;
+  };
+
+  const Graph& graph;
+  const EdgeFunc<num>& costs;
+  const EdgeFunc<num>& deviations;
+  const idx deviationSize;
+  const idx numVertices;
+  const idx grainSize;
+
+  std::unique_ptr<NumaTopology> topology;
+  std::vector<std::unique_ptr<WorkerPool>> pools;
+
+  std::atomic<bool> stopRequested;
+  std::atomic<int> listenSocket;
+
+  std::mutex connectionMutex;
+  std::condition_variable connectionsClosed;
+  std::unordered_set<int> connections;
+
+  QueryAnswer answer(RobustRouter& router, const Query& query) const;
+
+  void answer(WorkerPool& pool,
+              const std::vector<Query>& queries,
+              std::vector<QueryAnswer>& answers,
+              idx begin,
+              idx end) const;
+
+  void serveConnection(int socket);
+
+public:
+  /**
+   * Constructs a new QueryServer using the given number of
+   * workers (or all available cores if the number is zero).
+   **/
+  QueryServer(const Graph& graph,
+              const EdgeFunc<num>& costs,
+              const EdgeFunc<num>& deviations,
+              idx deviationSize,
+              RobustRouterFactory factory,
+              idx numThreads = 0,
+              idx grainSize = 1);
+
+  /**
+   * Constructs a new QueryServer with one pool of workers per
+   * node of the given NumaTopology. The workers of each pool are
+   * pinned to the CPUs of their node and use the routers created
+   * by the factory of the node, which should operate on data
+   * local to the node. The Query%s of each batch are divided
+   * among the nodes according to their number of CPUs.
+   *
+   * @throws std::invalid_argument if the number of factories
+   *         differs from the number of nodes
+   **/
+  QueryServer(const Graph& graph,
+              const EdgeFunc<num>& costs,
+              const EdgeFunc<num>& deviations,
+              idx deviationSize,
+              const std::vector<RobustRouterFactory>& factories,
+              const NumaTopology& topology,
+              idx grainSize = 1);
+
+  /**
+   * Answers the given Query%s using the workers. Queries
+   * with invalid Vertex indices are not found.
+   **/
+  std::vector<QueryAnswer> answer(const std::vector<Query>& queries);
+
+  /**
+   * Writes the header to the given QueryChannel and answers
+   * requests until the channel is closed.
+   *
+   * @returns the number of answered Query%s
+   **/
+  idx serve(QueryChannel& channel);
+
+  /**
+   * Listens on a Unix domain socket with the given path and serves
+   * each accepted connection in a thread of its own until stop()
+   * is called. An existing socket file is replaced. Returns
+   * after all connections have been closed, or immediately if
+   * stop() has been called before.
+   **/
+  void listen(const std::string& path);
+
+  /**
+   * Stops listening. The open connections are shut down
+   * and awaited by listen(). A call preceding listen() causes
+   * it to return immediately. This function is
+   * async-signal-safe.
+   **/
+  void stop();
+};
+
+#endif /* QUERY_SERVER_HH */
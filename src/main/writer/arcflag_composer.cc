@@ -1,8 +1,16 @@
 #include "arcflag_composer.hh"
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include "log.hh"
 
-const idx batchSize = 32;
+// the number of edges whose words are copied per task
+const idx grainSize = 1 << 12;
 
 void
 ArcFlagComposer::composeArcFlags(const ArcFlags& arcFlags,
@@ -12,36 +20,35 @@ ArcFlagComposer::composeArcFlags(const ArcFlags& arcFlags,
 
   const Partition& partition = arcFlags.getPartition();
   const Graph& graph = partition.getGraph();
+  const std::vector<Edge>& edges = graph.getEdges();
 
-  const idx numRegions = partition.getRegions().size();
+  const idx numWords = arcFlags.getNumWords();
+  const std::size_t size = ((std::size_t) edges.size()) * numWords;
 
-  if((numRegions % batchSize) != 0)
+  if(size > (std::size_t) std::numeric_limits<int>::max())
   {
-    throw std::runtime_error("Partition must contain of a multiple of 32 regions");
+    throw std::runtime_error("Too many arc flags to compose");
   }
 
-  const idx numBatches = numRegions / batchSize;
+  PBFArcFlags.clear_flags();
+  PBFArcFlags.set_num_regions(partition.getRegions().size());
 
-  for(const Edge& edge : graph.getEdges())
-  {
-    auto it = partition.getRegions().begin();
-
-    for(idx currentBatch = 0; currentBatch != numBatches; ++currentBatch)
-    {
-      google::protobuf::uint32 flags = 0;
-      for(idx batchIndex = 0; batchIndex != batchSize; ++batchIndex)
-      {
-        if(arcFlags.hasFlag(edge, *(it++)))
-        {
-          flags |= (1 << batchIndex);
-        }
-      }
-
-      PBFArcFlags.add_flags(flags);
-    }
-
-    assert(it == partition.getRegions().end());
-  }
+  auto& words = *(PBFArcFlags.mutable_words());
+
+  words.Resize(size, 0);
+
+  auto* data = words.mutable_data();
+
+  // the flags of consecutive edges are stored consecutively on both sides
+  tbb::parallel_for(tbb::blocked_range<idx>(0, edges.size(), grainSize),
+                    [&](const tbb::blocked_range<idx>& range)
+                    {
+                      const ArcFlags::Word* first = arcFlags.getWords(edges[range.begin()]);
+
+                      std::copy(first,
+                                first + ((std::size_t) range.size()) * numWords,
+                                data + ((std::size_t) range.begin()) * numWords);
+                    });
 
   Log(info) << "Composed arc flags";
 }
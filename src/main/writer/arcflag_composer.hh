@@ -5,6 +5,11 @@
 
 #include "arcflags/arcflags.hh"
 
+/**
+ * Composes ArcFlags by copying the Word%s of all Edge%s
+ * together with the number of Region%s, which determines
+ * the padding of the last Word of each Edge.
+ **/
 class ArcFlagComposer
 {
 public:
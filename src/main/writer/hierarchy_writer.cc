@@ -0,0 +1,94 @@
+#include "hierarchy_writer.hh"
+
+#include "graph.pb.h"
+
+namespace
+{
+  template <class Field, class T>
+  void composeValues(const std::vector<T>& values, Field& field)
+  {
+    field.Reserve(values.size());
+
+    for(const T& value : values)
+    {
+      field.Add(value);
+    }
+  }
+
+  void composeQueryGraph(const QueryGraph& queryGraph,
+                         Protobuf::QueryGraph& PBFQueryGraph)
+  {
+    composeValues(queryGraph.getOffsets(), *PBFQueryGraph.mutable_offsets());
+    composeValues(queryGraph.getHeads(), *PBFQueryGraph.mutable_heads());
+    composeValues(queryGraph.getWeights(), *PBFQueryGraph.mutable_weights());
+    composeValues(queryGraph.getShortcuts(), *PBFQueryGraph.mutable_shortcuts());
+  }
+
+  void composeRangeTable(const RangeTable& ranges,
+                         Protobuf::RangeTable& PBFRanges)
+  {
+    composeValues(ranges.getMinimums(), *PBFRanges.mutable_minimums());
+    composeValues(ranges.getMaximums(), *PBFRanges.mutable_maximums());
+    composeValues(ranges.getSlopes(), *PBFRanges.mutable_slopes());
+    composeValues(ranges.getOffsets(), *PBFRanges.mutable_offsets());
+    composeValues(ranges.getValues(), *PBFRanges.mutable_values());
+  }
+
+  void composeShortcutTable(const ShortcutTable& shortcuts,
+                            Protobuf::ShortcutTable& PBFShortcuts)
+  {
+    for(idx shortcut = 0; shortcut < shortcuts.size(); ++shortcut)
+    {
+      const Edge& edge = shortcuts.getEdge(shortcut);
+
+      assert(edge.getIndex() == shortcut);
+
+      PBFShortcuts.add_sources(edge.getSource().getIndex());
+      PBFShortcuts.add_targets(edge.getTarget().getIndex());
+      PBFShortcuts.add_first(shortcuts.getFirst(shortcut));
+      PBFShortcuts.add_second(shortcuts.getSecond(shortcut));
+    }
+  }
+
+  template <class Hierarchy>
+  void composeHierarchy(const Hierarchy& hierarchy,
+                        Protobuf::ContractionHierarchy& PBFHierarchy)
+  {
+    composeValues(hierarchy.getRanks(), *PBFHierarchy.mutable_ranks());
+
+    composeQueryGraph(hierarchy.getUpwardGraph(),
+                      *PBFHierarchy.mutable_upward_graph());
+
+    composeQueryGraph(hierarchy.getDownwardGraph(),
+                      *PBFHierarchy.mutable_downward_graph());
+
+    composeShortcutTable(hierarchy.getShortcuts(),
+                         *PBFHierarchy.mutable_shortcuts());
+  }
+}
+
+void HierarchyWriter::writeHierarchy(std::ostream& out,
+                                     const ContractionHierarchy& hierarchy)
+{
+  Protobuf::ContractionHierarchy PBFHierarchy;
+
+  composeHierarchy(hierarchy, PBFHierarchy);
+
+  PBFHierarchy.SerializeToOstream(&out);
+}
+
+void HierarchyWriter::writeHierarchy(std::ostream& out,
+                                     const RobustContractionHierarchy& hierarchy)
+{
+  Protobuf::ContractionHierarchy PBFHierarchy;
+
+  composeHierarchy(hierarchy, PBFHierarchy);
+
+  composeRangeTable(hierarchy.getUpwardRanges(),
+                    *PBFHierarchy.mutable_upward_ranges());
+
+  composeRangeTable(hierarchy.getDownwardRanges(),
+                    *PBFHierarchy.mutable_downward_ranges());
+
+  PBFHierarchy.SerializeToOstream(&out);
+}
@@ -0,0 +1,25 @@
+#ifndef HIERARCHY_WRITER_HH
+#define HIERARCHY_WRITER_HH
+
+#include <iostream>
+
+#include "contraction/contraction_hierarchy.hh"
+#include "robust/contraction/robust_contraction_hierarchy.hh"
+
+/**
+ * Writes (robust) contraction hierarchies. The serialized format
+ * mirrors the flat query layout of the hierarchies, such that
+ * reading a hierarchy only requires to copy its arrays.
+ **/
+class HierarchyWriter
+{
+public:
+  void writeHierarchy(std::ostream& out,
+                      const ContractionHierarchy& hierarchy);
+
+  void writeHierarchy(std::ostream& out,
+                      const RobustContractionHierarchy& hierarchy);
+};
+
+
+#endif /* HIERARCHY_WRITER_HH */
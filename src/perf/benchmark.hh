@@ -2,10 +2,16 @@
 #define TIMER_HH
 
 #include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <numeric>
 #include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
 
 #include "log.hh"
+#include "util.hh"
 
 class Timer
 {
@@ -24,10 +30,141 @@ public:
   }
 };
 
+/**
+ * A collection of individual latencies (in seconds), which
+ * can be queried for percentiles.
+ **/
+class LatencyHistogram
+{
+private:
+  mutable std::vector<double> samples;
+  mutable bool sorted = true;
+
+  void sort() const
+  {
+    if(!sorted)
+    {
+      std::sort(samples.begin(), samples.end());
+      sorted = true;
+    }
+  }
+
+public:
+  void add(double seconds)
+  {
+    samples.push_back(seconds);
+    sorted = false;
+  }
+
+  void add(const LatencyHistogram& other)
+  {
+    samples.insert(samples.end(),
+                   other.samples.begin(),
+                   other.samples.end());
+    sorted = false;
+  }
+
+  idx size() const
+  {
+    return samples.size();
+  }
+
+  bool isEmpty() const
+  {
+    return samples.empty();
+  }
+
+  double mean() const
+  {
+    assert(!isEmpty());
+
+    return std::accumulate(samples.begin(), samples.end(), 0.) / samples.size();
+  }
+
+  /**
+   * Returns the given percentile (given as a fraction
+   * between zero and one) using the nearest-rank method.
+   **/
+  double percentile(double fraction) const
+  {
+    assert(!isEmpty());
+    assert(fraction >= 0 and fraction <= 1);
+
+    sort();
+
+    idx rank = std::ceil(fraction * samples.size());
+
+    return samples[std::max(rank, (idx) 1) - 1];
+  }
+
+  double min() const
+  {
+    return percentile(0.);
+  }
+
+  double max() const
+  {
+    return percentile(1.);
+  }
+
+  /**
+   * Prints a JSON object containing a summary of the latencies.
+   **/
+  void printJSON(std::ostream& out) const
+  {
+    out << "{\"count\": " << size();
+
+    if(!isEmpty())
+    {
+      out << ", \"mean\": " << mean()
+          << ", \"min\": " << min()
+          << ", \"p50\": " << percentile(0.5)
+          << ", \"p90\": " << percentile(0.9)
+          << ", \"p99\": " << percentile(0.99)
+          << ", \"p999\": " << percentile(0.999)
+          << ", \"max\": " << max();
+    }
+
+    out << "}";
+  }
+};
+
+/**
+ * Evicts the contents of the processor caches by
+ * touching a buffer exceeding the size of the last level cache.
+ **/
+class CacheFlusher
+{
+private:
+  std::vector<char> buffer;
+  volatile char sink;
+
+public:
+  CacheFlusher(std::size_t size)
+    : buffer(size, 0),
+      sink(0)
+  {}
+
+  void flush()
+  {
+    const std::size_t lineSize = 64;
+    char value = sink;
+
+    for(std::size_t i = 0; i < buffer.size(); i += lineSize)
+    {
+      buffer[i] += 1;
+      value ^= buffer[i];
+    }
+
+    sink = value;
+  }
+};
+
 struct Result
 {
   double totalSeconds;
   int totalIterations;
+  LatencyHistogram latencies;
 
   double averageSeconds() const
   {
@@ -35,6 +172,12 @@ struct Result
   }
 };
 
+/**
+ * Executes a function repeatedly, recording the latency
+ * of each individual execution. An optional preparation
+ * function (such as a cache flush) is executed before each
+ * iteration without contributing to the measured time.
+ **/
 template<class Func>
 class FunctionTimer
 {
@@ -42,28 +185,40 @@ private:
   int minIterations;
   double minSeconds;
   Func func;
+  std::function<void()> prepare;
 
 public:
   FunctionTimer(int minIterations,
                 double minSeconds,
-                Func func)
+                Func func,
+                std::function<void()> prepare = std::function<void()>())
     : minIterations(minIterations),
       minSeconds(minSeconds),
-      func(func)
+      func(func),
+      prepare(prepare)
   {}
 
   Result execute()
   {
     int totalIterations = 0;
     double totalSeconds = 0.;
+    LatencyHistogram latencies;
 
     while(true)
     {
+      if(prepare)
+      {
+        prepare();
+      }
+
       Timer timer;
 
       func();
 
-      totalSeconds += timer.elapsed();
+      const double elapsed = timer.elapsed();
+
+      latencies.add(elapsed);
+      totalSeconds += elapsed;
       totalIterations++;
 
       if(minIterations != -1 && totalIterations >= minIterations)
@@ -80,7 +235,7 @@ public:
     Log(info) << "Executed " << totalIterations
               << " iterations in " << totalSeconds << " seconds";
 
-    return Result{totalSeconds, totalIterations};
+    return Result{totalSeconds, totalIterations, latencies};
   }
 };
 
@@ -129,6 +284,21 @@ struct RangedResult
 
     return maxSecs;
   }
+
+  /**
+   * Returns the latencies of all individual executions.
+   **/
+  LatencyHistogram latencies() const
+  {
+    LatencyHistogram histogram;
+
+    for(const auto & result : results)
+    {
+      histogram.add(result.latencies);
+    }
+
+    return histogram;
+  }
 };
 
 template<class It, class Func>
@@ -141,17 +311,21 @@ private:
   int minIterations;
   double minSeconds;
 
+  std::function<void()> prepare;
+
 public:
   RangedBenchmark(It begin,
                   It end,
                   int minIterations,
                   double minSeconds,
-                  Func func)
+                  Func func,
+                  std::function<void()> prepare = std::function<void()>())
     : begin(begin),
       end(end),
       minIterations(minIterations),
       minSeconds(minSeconds),
-      func(func)
+      func(func),
+      prepare(prepare)
   {}
 
   RangedResult execute()
@@ -170,7 +344,8 @@ public:
         minSeconds,
         [&]() {
           func(*it);
-        });
+        },
+        prepare);
 
       auto result = functionTimer.execute();
 
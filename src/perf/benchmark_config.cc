@@ -16,7 +16,13 @@ BenchmarkSettings readSettings(pt::ptree& tree)
       tree.get("minSeconds", 10.),
       tree.get("numBuckets", 10),
       tree.get("sampleSize", 10),
-      tree.get("deviationSize", 5)
+      tree.get("deviationSize", 5),
+      tree.get("seed", 42),
+      tree.get("sampleDirectory", std::string(".")),
+      tree.get("coldIterations", 1),
+      tree.get("cacheFlushSize", 64L * 1024L * 1024L),
+      tree.get("numThreads", 1),
+      tree.get("throughputSeconds", 10.)
   };
 }
 
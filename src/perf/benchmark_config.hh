@@ -12,6 +12,23 @@ struct BenchmarkSettings
   int sampleSize;
 
   int deviationSize;
+
+  // seed used to choose the sampled source vertices
+  int seed;
+  // directory containing the cached samples,
+  // samples are not cached if left empty
+  std::string sampleDirectory;
+
+  // number of cold-cache executions per sample,
+  // cold-cache runs are disabled if set to zero
+  int coldIterations;
+  // size of the buffer used to flush the caches (in bytes)
+  long cacheFlushSize;
+
+  // number of concurrent threads in throughput mode,
+  // throughput runs are disabled if set to zero
+  int numThreads;
+  double throughputSeconds;
 };
 
 class BenchmarkConfig
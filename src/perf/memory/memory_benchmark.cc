@@ -0,0 +1,90 @@
+#include "arcflags/arcflag_preprocessor.hh"
+#include "arcflags/metis_partition.hh"
+
+#include "contraction/contraction_hierarchy.hh"
+#include "contraction/parallel_contraction_preprocessor.hh"
+
+#include "robust/arcflags/extended_arcflags.hh"
+#include "robust/arcflags/fast_arcflag_preprocessor.hh"
+
+#include "robust/contraction/parallel_robust_contraction_preprocessor.hh"
+#include "robust/contraction/robust_contraction_hierarchy.hh"
+
+#include "robust/discard/discarding_preprocessor.hh"
+
+#include "benchmark_config.hh"
+#include "sample_benchmark.hh"
+
+/**
+ * Prints the memory used by the Graph of the configured instance
+ * and by the speed-up techniques built on top of it (the (robust)
+ * contraction hierarchies, the (robust) arc flags and the
+ * discarding preprocessor), both as an indented tree and as JSON.
+ **/
+int main(int argc, char** argv)
+{
+  logInit();
+
+  std::string configName = "benchmark.json";
+
+  if(argc > 1)
+  {
+    configName = argv[1];
+  }
+
+  BenchmarkConfig config = BenchmarkConfig::readConfig(configName);
+
+  GraphFixture fixture(config.getInstance());
+
+  ParallelContractionPreprocessor preprocessor(fixture.graph, fixture.costs);
+  ContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  ParallelRobustContractionPreprocessor robustPreprocessor(fixture.graph,
+                                                           fixture.costs,
+                                                           fixture.deviations);
+
+  RobustContractionHierarchy robustHierarchy(robustPreprocessor.computeHierarchy());
+
+  METISPartition partition(fixture.graph, 64);
+
+  ArcFlagPreprocessor arcFlagPreprocessor(fixture.graph,
+                                          fixture.costs,
+                                          partition,
+                                          true);
+
+  Bidirected<ExtendedArcFlags> extendedFlags(fixture.graph, partition);
+
+  FastArcFlagPreprocessor(fixture.graph,
+                          fixture.costs,
+                          fixture.deviations,
+                          partition).computeFlags(extendedFlags, 16, true);
+
+  DiscardingPreprocessor discardingPreprocessor(fixture.graph,
+                                                fixture.costs,
+                                                fixture.deviations,
+                                                partition);
+
+  MemoryUsage usage = MemoryUsage(config.getInstance())
+    .add(fixture.graph.memoryUsage())
+    .add(fixture.costMap.memoryUsage("costs"))
+    .add(fixture.deviationMap.memoryUsage("deviations"))
+    .add(hierarchy.memoryUsage())
+    .add(robustHierarchy.memoryUsage())
+    .add(partition.memoryUsage())
+    .add(MemoryUsage("ArcFlagPreprocessor")
+         .add(arcFlagPreprocessor.getOutgoingFlags().memoryUsage("outgoingFlags"))
+         .add(arcFlagPreprocessor.getIncomingFlags().memoryUsage("incomingFlags")))
+    .add(MemoryUsage("FastArcFlagPreprocessor")
+         .add(MemoryUsage("outgoingFlags")
+              .add(extendedFlags.get<Direction::OUTGOING>().memoryUsage()))
+         .add(MemoryUsage("incomingFlags")
+              .add(extendedFlags.get<Direction::INCOMING>().memoryUsage())))
+    .add(discardingPreprocessor.memoryUsage());
+
+  usage.print(std::cerr);
+
+  usage.printJSON(std::cout);
+  std::cout << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include "contraction/contraction_hierarchy.hh"
+#include "contraction/parallel_contraction_preprocessor.hh"
+
+#include "robust/simple_robust_router.hh"
+#include "robust/contraction/parallel_robust_contraction_preprocessor.hh"
+#include "robust/contraction/robust_contraction_hierarchy.hh"
+
+#include "benchmark_config.hh"
+#include "sample_benchmark.hh"
+#include "search_benchmark.hh"
+
+/**
+ * Compares the numbers of settled vertices and the latencies
+ * of the queries on a ContractionHierarchy and on a
+ * RobustContractionHierarchy with and without stall-on-demand.
+ **/
+int main(int argc, char** argv)
+{
+  logInit();
+
+  std::string configName = "benchmark.json";
+
+  if(argc > 1)
+  {
+    configName = argv[1];
+  }
+
+  BenchmarkConfig config = BenchmarkConfig::readConfig(configName);
+
+  const idx deviationSize = config.getSettings().deviationSize;
+
+  GraphFixture fixture(config.getInstance());
+
+  SampleCollector sampleCollector = collectSamples(config, fixture);
+
+  ParallelContractionPreprocessor preprocessor(fixture.graph, fixture.costs);
+  ContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  ParallelRobustContractionPreprocessor robustPreprocessor(fixture.graph,
+                                                           fixture.costs,
+                                                           fixture.deviations);
+
+  RobustContractionHierarchy robustHierarchy(robustPreprocessor.computeHierarchy());
+
+  for(bool stalling : {false, true})
+  {
+    const std::string suffix = stalling ? "Stalling" : "";
+
+    auto router = hierarchy.getRouter();
+    router.setStalling(stalling);
+
+    SearchBenchmark benchmark(sampleCollector,
+                              [&](const VertexPair& sample) -> idx
+                              {
+                                return router.shortestPath(sample.source,
+                                                           sample.target,
+                                                           fixture.costs).settled;
+                              });
+
+    benchmark.executeAll();
+    benchmark.print(std::cout, "ContractionHierarchy" + suffix);
+
+    auto thetaRouter = robustHierarchy.getRouter();
+    thetaRouter.setStalling(stalling);
+
+    SimpleRobustRouter robustRouter(fixture.graph,
+                                    fixture.costs,
+                                    fixture.deviations,
+                                    deviationSize,
+                                    thetaRouter);
+
+    SearchBenchmark robustBenchmark(sampleCollector,
+                                    [&](const VertexPair& sample) -> idx
+                                    {
+                                      return robustRouter.shortestPath(sample.source,
+                                                                       sample.target).settled;
+                                    });
+
+    robustBenchmark.executeAll();
+    robustBenchmark.print(std::cout, "RobustContractionHierarchy" + suffix);
+  }
+
+  return 0;
+}
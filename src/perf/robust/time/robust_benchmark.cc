@@ -1 +1,72 @@
 #include "robust_benchmark.hh"
+
+#include <fstream>
+
+#include "log.hh"
+
+void runRobustBenchmarks(const BenchmarkConfig& config,
+                         const SampleCollector& sampleCollector,
+                         RobustRouter& router,
+                         const SampleQueryFactory& factory,
+                         std::ostream& out,
+                         const std::string& name,
+                         const std::string& jsonName)
+{
+  const BenchmarkSettings& settings = config.getSettings();
+
+  RobustBenchmark benchmark(sampleCollector,
+                            router,
+                            settings.minIterations,
+                            settings.minSeconds);
+
+  benchmark.executeAll();
+
+  if(settings.coldIterations > 0)
+  {
+    CacheFlusher flusher(settings.cacheFlushSize);
+
+    benchmark.executeCold(settings.coldIterations, flusher);
+  }
+
+  benchmark.print(out, name);
+
+  std::ofstream json(jsonName);
+
+  json << "{\n\"name\": \"" << name << "\",\n"
+       << "\"instance\": \"" << config.getInstance() << "\",\n"
+       << "\"ranks\": [";
+
+  const uint numBuckets = sampleCollector.getNumBuckets();
+
+  for(uint bucket = 0; bucket < numBuckets; ++bucket)
+  {
+    json << round(100 * (bucket / ((double) numBuckets))) / 100.;
+
+    if(bucket < numBuckets - 1)
+    {
+      json << ", ";
+    }
+  }
+
+  json << "],\n";
+
+  benchmark.printJSON(json);
+
+  if(settings.numThreads > 0)
+  {
+    ThroughputBenchmark throughput(sampleCollector,
+                                   factory,
+                                   settings.numThreads,
+                                   settings.throughputSeconds);
+
+    throughput.executeAll();
+
+    json << ",\n";
+
+    throughput.printJSON(json);
+  }
+
+  json << "\n}\n";
+
+  Log(info) << "Wrote results to " << jsonName;
+}
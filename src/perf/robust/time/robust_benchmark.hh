@@ -1,11 +1,14 @@
 #ifndef ROBUST_BENCHMARK_HH
 #define ROBUST_BENCHMARK_HH
 
+#include <memory>
+
 #include "robust/robust_router.hh"
 #include "robust/simple_robust_router.hh"
 
 #include "sample_benchmark.hh"
 #include "benchmark_config.hh"
+#include "throughput_benchmark.hh"
 
 class RobustBenchmark : public SampleBenchmark
 {
@@ -26,6 +29,65 @@ public:
   }
 };
 
+/**
+ * Executes the warm-cache, cold-cache and throughput benchmarks
+ * as specified by the given config. The warm-cache results are
+ * printed as CSV to the given stream, all results are
+ * written as JSON into the file with the given name.
+ **/
+void runRobustBenchmarks(const BenchmarkConfig& config,
+                         const SampleCollector& sampleCollector,
+                         RobustRouter& router,
+                         const SampleQueryFactory& factory,
+                         std::ostream& out,
+                         const std::string& name,
+                         const std::string& jsonName);
+
+/**
+ * Returns a query which owns a newly created RobustRouter.
+ **/
+template <class Robust>
+SampleQuery robustQuery(const GraphFixture& fixture,
+                        idx deviationSize)
+{
+  std::shared_ptr<RobustRouter> router =
+    std::make_shared<Robust>(fixture.graph,
+                             fixture.costs,
+                             fixture.deviations,
+                             deviationSize);
+
+  return [router](const VertexPair& sample)
+    {
+      router->shortestPath(sample.source, sample.target);
+    };
+}
+
+/**
+ * Returns a query which owns a newly created RobustRouter
+ * together with its underlying ThetaRouter.
+ **/
+template <class Robust, class Theta>
+SampleQuery combinedQuery(const GraphFixture& fixture,
+                          idx deviationSize)
+{
+  auto thetaRouter = std::make_shared<Theta>(fixture.graph,
+                                             fixture.costs,
+                                             fixture.deviations,
+                                             deviationSize);
+
+  std::shared_ptr<RobustRouter> router =
+    std::make_shared<Robust>(fixture.graph,
+                             fixture.costs,
+                             fixture.deviations,
+                             deviationSize,
+                             *thetaRouter);
+
+  return [router, thetaRouter](const VertexPair& sample)
+    {
+      router->shortestPath(sample.source, sample.target);
+    };
+}
+
 #define ROBUST_BENCHMARK(ROUTER)                                        \
   int main(int argc, char** argv)                                       \
   {                                                                     \
@@ -38,29 +100,39 @@ public:
       configName = argv[1];                                             \
     }                                                                   \
                                                                         \
+    std::string jsonName = std::string(#ROUTER) + ".json";              \
+                                                                        \
+    if(argc > 2)                                                        \
+    {                                                                   \
+      jsonName = argv[2];                                               \
+    }                                                                   \
+                                                                        \
     BenchmarkConfig config =                                            \
       BenchmarkConfig::readConfig(configName);                          \
                                                                         \
+    const idx deviationSize = config.getSettings().deviationSize;       \
+                                                                        \
     GraphFixture fixture(config.getInstance());                         \
                                                                         \
     ROUTER router(fixture.graph,                                        \
                   fixture.costs,                                        \
                   fixture.deviations,                                   \
-                  config.getSettings().deviationSize);                  \
-                                                                        \
-    SampleCollector sampleCollector(fixture.graph,                      \
-                                    fixture.costs,                      \
-                                    config.getSettings().sampleSize,    \
-                                    config.getSettings().numBuckets);   \
-                                                                        \
-    RobustBenchmark benchmark(sampleCollector,                          \
-                              router,                                   \
-                              config.getSettings().minIterations,       \
-                              config.getSettings().minSeconds);         \
-                                                                        \
-    benchmark.executeAll();                                             \
-                                                                        \
-    benchmark.print(std::cout, #ROUTER);                                \
+                  deviationSize);                                       \
+                                                                        \
+    SampleQueryFactory factory = [&]() -> SampleQuery                   \
+      {                                                                 \
+        return robustQuery<ROUTER>(fixture, deviationSize);             \
+      };                                                                \
+                                                                        \
+    SampleCollector sampleCollector = collectSamples(config, fixture);  \
+                                                                        \
+    runRobustBenchmarks(config,                                         \
+                        sampleCollector,                                \
+                        router,                                         \
+                        factory,                                        \
+                        std::cout,                                      \
+                        #ROUTER,                                        \
+                        jsonName);                                      \
   }                                                                     \
 
 #define THETA_BENCHMARK(ROUTER)                                         \
@@ -75,35 +147,45 @@ public:
       configName = argv[1];                                             \
     }                                                                   \
                                                                         \
+    std::string jsonName = std::string(#ROUTER) + ".json";              \
+                                                                        \
+    if(argc > 2)                                                        \
+    {                                                                   \
+      jsonName = argv[2];                                               \
+    }                                                                   \
+                                                                        \
     BenchmarkConfig config =                                            \
       BenchmarkConfig::readConfig(configName);                          \
                                                                         \
+    const idx deviationSize = config.getSettings().deviationSize;       \
+                                                                        \
     GraphFixture fixture(config.getInstance());                         \
                                                                         \
     ROUTER thetaRouter(fixture.graph,                                   \
                        fixture.costs,                                   \
                        fixture.deviations,                              \
-                       config.getSettings().deviationSize);             \
+                       deviationSize);                                  \
                                                                         \
     SimpleRobustRouter router(fixture.graph,                            \
                               fixture.costs,                            \
                               fixture.deviations,                       \
-                              config.getSettings().deviationSize,       \
+                              deviationSize,                            \
                               thetaRouter);                             \
                                                                         \
-    SampleCollector sampleCollector(fixture.graph,                      \
-                                    fixture.costs,                      \
-                                    config.getSettings().sampleSize,    \
-                                    config.getSettings().numBuckets);   \
-                                                                        \
-    RobustBenchmark benchmark(sampleCollector,                          \
-                              router,                                   \
-                              config.getSettings().minIterations,       \
-                              config.getSettings().minSeconds);         \
+    SampleQueryFactory factory = [&]() -> SampleQuery                   \
+      {                                                                 \
+        return combinedQuery<SimpleRobustRouter, ROUTER>(fixture, deviationSize);\
+      };                                                                \
                                                                         \
-    benchmark.executeAll();                                             \
+    SampleCollector sampleCollector = collectSamples(config, fixture);  \
                                                                         \
-    benchmark.print(std::cout, #ROUTER);                                \
+    runRobustBenchmarks(config,                                         \
+                        sampleCollector,                                \
+                        router,                                         \
+                        factory,                                        \
+                        std::cout,                                      \
+                        #ROUTER,                                        \
+                        jsonName);                                      \
   }                                                                     \
 
 #define COMBINED_BENCHMARK(ROBUST, THETA, NAME)                         \
@@ -118,35 +200,45 @@ public:
       configName = argv[1];                                             \
     }                                                                   \
                                                                         \
+    std::string jsonName = std::string(NAME) + ".json";                 \
+                                                                        \
+    if(argc > 2)                                                        \
+    {                                                                   \
+      jsonName = argv[2];                                               \
+    }                                                                   \
+                                                                        \
     BenchmarkConfig config =                                            \
       BenchmarkConfig::readConfig(configName);                          \
                                                                         \
+    const idx deviationSize = config.getSettings().deviationSize;       \
+                                                                        \
     GraphFixture fixture(config.getInstance());                         \
                                                                         \
     THETA thetaRouter(fixture.graph,                                    \
-                       fixture.costs,                                   \
-                       fixture.deviations,                              \
-                       config.getSettings().deviationSize);             \
+                      fixture.costs,                                    \
+                      fixture.deviations,                               \
+                      deviationSize);                                   \
                                                                         \
     ROBUST router(fixture.graph,                                        \
                   fixture.costs,                                        \
                   fixture.deviations,                                   \
-                  config.getSettings().deviationSize,                   \
+                  deviationSize,                                        \
                   thetaRouter);                                         \
                                                                         \
-    SampleCollector sampleCollector(fixture.graph,                      \
-                                    fixture.costs,                      \
-                                    config.getSettings().sampleSize,    \
-                                    config.getSettings().numBuckets);   \
-                                                                        \
-    RobustBenchmark benchmark(sampleCollector,                          \
-                              router,                                   \
-                              config.getSettings().minIterations,       \
-                              config.getSettings().minSeconds);         \
+    SampleQueryFactory factory = [&]() -> SampleQuery                   \
+      {                                                                 \
+        return combinedQuery<ROBUST, THETA>(fixture, deviationSize);    \
+      };                                                                \
                                                                         \
-    benchmark.executeAll();                                             \
+    SampleCollector sampleCollector = collectSamples(config, fixture);  \
                                                                         \
-    benchmark.print(std::cout, NAME);                                   \
+    runRobustBenchmarks(config,                                         \
+                        sampleCollector,                                \
+                        router,                                         \
+                        factory,                                        \
+                        std::cout,                                      \
+                        NAME,                                           \
+                        jsonName);                                      \
   }                                                                     \
 
 #endif /* ROBUST_BENCHMARK_HH */
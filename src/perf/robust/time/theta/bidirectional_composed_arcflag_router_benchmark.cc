@@ -0,0 +1,6 @@
+#include "robust/time/theta/composed_benchmark.hh"
+
+typedef BidirectionalComposedThetaRouter<ArcFlagEdgeFilter<ExtendedArcFlags>,
+                                         UpperBoundPruning> BidirectionalComposedArcFlagRouter;
+
+COMPOSED_BENCHMARK(BidirectionalComposedArcFlagRouter)
@@ -0,0 +1,7 @@
+#include "robust/time/theta/composed_benchmark.hh"
+
+typedef ComposedThetaRouter<ArcFlagEdgeFilter<ExtendedArcFlags>,
+                            NoPotential,
+                            NoPruning> ComposedArcFlagRouter;
+
+COMPOSED_BENCHMARK(ComposedArcFlagRouter)
@@ -0,0 +1,236 @@
+#ifndef COMPOSED_BENCHMARK_HH
+#define COMPOSED_BENCHMARK_HH
+
+#include <memory>
+
+#include "arcflags/metis_partition.hh"
+
+#include "contraction/contraction_hierarchy.hh"
+#include "contraction/parallel_contraction_preprocessor.hh"
+
+#include "robust/arcflags/extended_arcflags.hh"
+#include "robust/arcflags/fast_arcflag_preprocessor.hh"
+
+#include "robust/theta/composed_theta_router.hh"
+
+#include "robust/time/robust_benchmark.hh"
+
+/**
+ * The data shared by the policies of all ComposedThetaRouter%s
+ * of a benchmark. The data is computed on first use, which
+ * happens while the router of the warm-cache benchmark is
+ * constructed, i.e., before any concurrent queries are created.
+ **/
+class ComposedBenchmarkData
+{
+private:
+  const GraphFixture& fixture;
+
+  std::unique_ptr<METISPartition> partition;
+  std::unique_ptr<Bidirected<ExtendedArcFlags>> flags;
+  std::unique_ptr<ContractionHierarchy> hierarchy;
+
+public:
+  ComposedBenchmarkData(const GraphFixture& fixture)
+    : fixture(fixture)
+  {}
+
+  const GraphFixture& getFixture() const
+  {
+    return fixture;
+  }
+
+  const Partition& getPartition()
+  {
+    if(!partition)
+    {
+      partition.reset(new METISPartition(fixture.graph, 64));
+    }
+
+    return *partition;
+  }
+
+  const Bidirected<ExtendedArcFlags>& getFlags()
+  {
+    if(!flags)
+    {
+      const Partition& currentPartition = getPartition();
+
+      flags.reset(new Bidirected<ExtendedArcFlags>(fixture.graph,
+                                                   currentPartition));
+
+      FastArcFlagPreprocessor(fixture.graph,
+                              fixture.costs,
+                              fixture.deviations,
+                              currentPartition).computeFlags(*flags, 16, true);
+    }
+
+    return *flags;
+  }
+
+  const ContractionHierarchy& getHierarchy()
+  {
+    if(!hierarchy)
+    {
+      ParallelContractionPreprocessor preprocessor(fixture.graph,
+                                                   fixture.costs);
+
+      hierarchy.reset(new ContractionHierarchy(preprocessor.computeHierarchy()));
+    }
+
+    return *hierarchy;
+  }
+};
+
+/**
+ * Creates policies which only depend on the Graph.
+ **/
+template <class Policy>
+struct ComposedPolicyFactory
+{
+  static Policy create(ComposedBenchmarkData& data)
+  {
+    return Policy(data.getFixture().graph);
+  }
+};
+
+template <>
+struct ComposedPolicyFactory<ArcFlagEdgeFilter<ExtendedArcFlags>>
+{
+  static ArcFlagEdgeFilter<ExtendedArcFlags> create(ComposedBenchmarkData& data)
+  {
+    return ArcFlagEdgeFilter<ExtendedArcFlags>(data.getPartition(),
+                                               data.getFlags());
+  }
+};
+
+template <>
+struct ComposedPolicyFactory<ContractionGoalPotential>
+{
+  static ContractionGoalPotential create(ComposedBenchmarkData& data)
+  {
+    return ContractionGoalPotential(data.getFixture().graph,
+                                    data.getHierarchy());
+  }
+};
+
+template <class Router>
+struct ComposedRouterFactory;
+
+template <class FilterPolicy, class PotentialPolicy, class PruningPolicy>
+struct ComposedRouterFactory<ComposedThetaRouter<FilterPolicy,
+                                                 PotentialPolicy,
+                                                 PruningPolicy>>
+{
+  static std::shared_ptr<ThetaRouter> create(ComposedBenchmarkData& data,
+                                             idx deviationSize)
+  {
+    const GraphFixture& fixture = data.getFixture();
+
+    return std::make_shared<ComposedThetaRouter<FilterPolicy,
+                                                PotentialPolicy,
+                                                PruningPolicy>>(
+      fixture.graph,
+      fixture.costs,
+      fixture.deviations,
+      deviationSize,
+      ComposedPolicyFactory<FilterPolicy>::create(data),
+      ComposedPolicyFactory<PotentialPolicy>::create(data),
+      ComposedPolicyFactory<PruningPolicy>::create(data));
+  }
+};
+
+template <class FilterPolicy, class PruningPolicy>
+struct ComposedRouterFactory<BidirectionalComposedThetaRouter<FilterPolicy,
+                                                              PruningPolicy>>
+{
+  static std::shared_ptr<ThetaRouter> create(ComposedBenchmarkData& data,
+                                             idx deviationSize)
+  {
+    const GraphFixture& fixture = data.getFixture();
+
+    return std::make_shared<BidirectionalComposedThetaRouter<FilterPolicy,
+                                                             PruningPolicy>>(
+      fixture.graph,
+      fixture.costs,
+      fixture.deviations,
+      deviationSize,
+      ComposedPolicyFactory<FilterPolicy>::create(data),
+      ComposedPolicyFactory<PruningPolicy>::create(data),
+      ComposedPolicyFactory<PruningPolicy>::create(data));
+  }
+};
+
+/**
+ * Benchmarks a SimpleRobustRouter based on the given instantiation
+ * of a ComposedThetaRouter or a BidirectionalComposedThetaRouter.
+ * Since the router type contains commas, it has to be passed
+ * as a typedef.
+ **/
+#define COMPOSED_BENCHMARK(ROUTER)                                      \
+  int main(int argc, char** argv)                                       \
+  {                                                                     \
+    logInit();                                                          \
+                                                                        \
+    std::string configName = "benchmark.json";                          \
+                                                                        \
+    if(argc > 1)                                                        \
+    {                                                                   \
+      configName = argv[1];                                             \
+    }                                                                   \
+                                                                        \
+    std::string jsonName = std::string(#ROUTER) + ".json";              \
+                                                                        \
+    if(argc > 2)                                                        \
+    {                                                                   \
+      jsonName = argv[2];                                               \
+    }                                                                   \
+                                                                        \
+    BenchmarkConfig config =                                            \
+      BenchmarkConfig::readConfig(configName);                          \
+                                                                        \
+    const idx deviationSize = config.getSettings().deviationSize;       \
+                                                                        \
+    GraphFixture fixture(config.getInstance());                         \
+                                                                        \
+    ComposedBenchmarkData data(fixture);                                \
+                                                                        \
+    std::shared_ptr<ThetaRouter> thetaRouter =                          \
+      ComposedRouterFactory<ROUTER>::create(data, deviationSize);       \
+                                                                        \
+    SimpleRobustRouter router(fixture.graph,                            \
+                              fixture.costs,                            \
+                              fixture.deviations,                       \
+                              deviationSize,                            \
+                              *thetaRouter);                            \
+                                                                        \
+    SampleQueryFactory factory = [&]() -> SampleQuery                   \
+      {                                                                 \
+        std::shared_ptr<ThetaRouter> queryThetaRouter =                 \
+          ComposedRouterFactory<ROUTER>::create(data, deviationSize);   \
+                                                                        \
+        auto queryRouter =                                              \
+          std::make_shared<SimpleRobustRouter>(fixture.graph,           \
+                                               fixture.costs,           \
+                                               fixture.deviations,      \
+                                               deviationSize,           \
+                                               *queryThetaRouter);      \
+                                                                        \
+        return [queryRouter, queryThetaRouter](const VertexPair& sample) \
+          {                                                             \
+            queryRouter->shortestPath(sample.source, sample.target);    \
+          };                                                            \
+      };                                                                \
+                                                                        \
+    SampleCollector sampleCollector = collectSamples(config, fixture);  \
+                                                                        \
+    runRobustBenchmarks(config,                                         \
+                        sampleCollector,                                \
+                        router,                                         \
+                        factory,                                        \
+                        std::cout,                                      \
+                        #ROUTER,                                        \
+                        jsonName);                                      \
+  }                                                                     \
+
+#endif /* COMPOSED_BENCHMARK_HH */
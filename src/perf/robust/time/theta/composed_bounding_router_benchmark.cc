@@ -0,0 +1,7 @@
+#include "robust/time/theta/composed_benchmark.hh"
+
+typedef ComposedThetaRouter<UnfilteredEdges,
+                            NoPotential,
+                            UpperBoundPruning> ComposedBoundingRouter;
+
+COMPOSED_BENCHMARK(ComposedBoundingRouter)
@@ -0,0 +1,7 @@
+#include "robust/time/theta/composed_benchmark.hh"
+
+typedef ComposedThetaRouter<ArcFlagEdgeFilter<ExtendedArcFlags>,
+                            ContractionGoalPotential,
+                            UpperBoundPruning> ComposedGoalDirectedArcFlagRouter;
+
+COMPOSED_BENCHMARK(ComposedGoalDirectedArcFlagRouter)
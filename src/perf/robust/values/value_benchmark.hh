@@ -65,10 +65,7 @@ public:
                   fixture.deviations,                                   \
                   config.getSettings().deviationSize);                  \
                                                                         \
-    SampleCollector sampleCollector(fixture.graph,                      \
-                                    fixture.costs,                      \
-                                    config.getSettings().sampleSize,    \
-                                    config.getSettings().numBuckets);   \
+    SampleCollector sampleCollector = collectSamples(config, fixture);  \
                                                                         \
     ValueBenchmark benchmark(sampleCollector,                           \
                              router);                                   \
@@ -107,10 +104,7 @@ public:
                         config.getSettings().deviationSize,             \
                         thetaRouter);                                   \
                                                                         \
-    SampleCollector sampleCollector(fixture.graph,                      \
-                                    fixture.costs,                      \
-                                    config.getSettings().sampleSize,    \
-                                    config.getSettings().numBuckets);   \
+    SampleCollector sampleCollector = collectSamples(config, fixture);  \
                                                                         \
     ValueBenchmark benchmark(sampleCollector,                           \
                              robustRouter);                             \
@@ -33,6 +33,37 @@ GraphFixture::GraphFixture(const std::string& instance)
 
 }
 
+SampleCollector collectSamples(const BenchmarkConfig& config,
+                               const GraphFixture& fixture)
+{
+  const BenchmarkSettings& settings = config.getSettings();
+
+  if(settings.sampleDirectory.empty())
+  {
+    return SampleCollector(fixture.graph,
+                           fixture.costs,
+                           settings.sampleSize,
+                           settings.numBuckets,
+                           settings.seed);
+  }
+
+  std::stringstream filename;
+
+  filename << settings.sampleDirectory << "/"
+           << "samples_" << config.getInstance()
+           << "_" << settings.seed
+           << "_" << settings.sampleSize
+           << "_" << settings.numBuckets
+           << ".pbf";
+
+  return SampleCollector::cached(filename.str(),
+                                 fixture.graph,
+                                 fixture.costs,
+                                 settings.sampleSize,
+                                 settings.numBuckets,
+                                 settings.seed);
+}
+
 SampleBenchmark::SampleBenchmark(const SampleCollector& sampleCollector,
                                  int minIterations,
                                  double minSeconds)
@@ -43,10 +74,23 @@ SampleBenchmark::SampleBenchmark(const SampleCollector& sampleCollector,
 
 
 void SampleBenchmark::executeAll()
+{
+  results = execute(minIterations, minSeconds, std::function<void()>());
+}
+
+void SampleBenchmark::executeCold(int iterations, CacheFlusher& flusher)
+{
+  coldResults = execute(iterations, -1, [&]() { flusher.flush(); });
+}
+
+std::vector<RangedResult> SampleBenchmark::execute(int iterations,
+                                                   double seconds,
+                                                   std::function<void()> prepare)
 {
   const uint numBuckets = sampleCollector.getNumBuckets();
 
-  results.reserve(numBuckets);
+  std::vector<RangedResult> bucketResults;
+  bucketResults.reserve(numBuckets);
 
   for(uint bucket = 0; bucket < numBuckets; ++bucket)
   {
@@ -61,12 +105,15 @@ void SampleBenchmark::executeAll()
 
     RangedBenchmark<decltype(begin), decltype(func)> benchmark(begin,
                                                                end,
-                                                               minIterations,
-                                                               minSeconds,
-                                                               func);
+                                                               iterations,
+                                                               seconds,
+                                                               func,
+                                                               prepare);
 
-    results.push_back(benchmark.execute());
+    bucketResults.push_back(benchmark.execute());
   }
+
+  return bucketResults;
 }
 
 void SampleBenchmark::print(std::ostream& out,
@@ -107,3 +154,30 @@ void SampleBenchmark::print(std::ostream& out,
 
   out << stream.str();
 }
+
+static void printLatencies(std::ostream& out,
+                           const std::vector<RangedResult>& results)
+{
+  out << "[";
+
+  for(idx i = 0; i < results.size(); ++i)
+  {
+    results[i].latencies().printJSON(out);
+
+    if(i < results.size() - 1)
+    {
+      out << ", ";
+    }
+  }
+
+  out << "]";
+}
+
+void SampleBenchmark::printJSON(std::ostream& out) const
+{
+  out << "\"warm\": ";
+  printLatencies(out, results);
+
+  out << ",\n\"cold\": ";
+  printLatencies(out, coldResults);
+}
@@ -10,6 +10,7 @@
 
 #include "sample_collector.hh"
 #include "benchmark.hh"
+#include "benchmark_config.hh"
 
 class SimpleGraphFixture
 {
@@ -30,16 +31,35 @@ public:
   EdgeValueMap<num> deviations;
 };
 
+/**
+ * Returns the samples specified by the given config. The samples
+ * are cached in the sample directory of the config, keyed
+ * by the instance, the seed, and the sample settings.
+ **/
+SampleCollector collectSamples(const BenchmarkConfig& config,
+                               const GraphFixture& fixture);
+
+/**
+ * A benchmark measuring the latencies of queries given by
+ * the samples of a SampleCollector. Warm-cache runs
+ * repeat each query back-to-back, whereas cold-cache runs
+ * flush the caches before each individual query.
+ **/
 class SampleBenchmark
 {
 protected:
   const SampleCollector& sampleCollector;
 
   std::vector<RangedResult> results;
+  std::vector<RangedResult> coldResults;
 
   int minIterations;
   double minSeconds;
 
+  std::vector<RangedResult> execute(int iterations,
+                                    double seconds,
+                                    std::function<void()> prepare);
+
 public:
   SampleBenchmark(const SampleCollector& sampleCollector,
                   int minIterations,
@@ -49,9 +69,21 @@ public:
 
   void executeAll();
 
+  /**
+   * Executes each sample the given number of times, flushing
+   * the caches before each execution.
+   **/
+  void executeCold(int iterations, CacheFlusher& flusher);
+
   void print(std::ostream& out,
              const std::string& name);
 
+  /**
+   * Prints the per-bucket latency distributions of the warm
+   * and cold runs as the members of a JSON object.
+   **/
+  void printJSON(std::ostream& out) const;
+
 };
 
 
@@ -1,24 +1,44 @@
 #include "sample_collector.hh"
 
+#include <cmath>
+#include <fstream>
+
+#include <tbb/tbb.h>
+
 #include "log.hh"
 
+#include "graph.pb.h"
+
 #include "router/dijkstra_rank.hh"
 
-SampleCollector::SampleCollector(const Graph& graph,
-                                 const EdgeFunc<num>& costs,
-                                 uint sampleSize,
-                                 uint numBuckets)
+SampleCollector::SampleCollector(uint sampleSize,
+                                 uint numBuckets,
+                                 int seed)
   : sampleSize(sampleSize),
-    numBuckets(numBuckets)
+    numBuckets(numBuckets),
+    seed(seed)
 {
   samples.resize(numBuckets);
 
   for(uint i = 0; i < numBuckets; ++i)
   {
-    samples[i] = std::vector<VertexPair>();
-    samples[i].reserve(sampleSize);
+    samples[i] = std::vector<VertexPair>(sampleSize);
   }
+}
+
+SampleCollector::SampleCollector(const Graph& graph,
+                                 const EdgeFunc<num>& costs,
+                                 uint sampleSize,
+                                 uint numBuckets,
+                                 int seed)
+  : SampleCollector(sampleSize, numBuckets, seed)
+{
+  collect(graph, costs);
+}
 
+void SampleCollector::collect(const Graph& graph,
+                              const EdgeFunc<num>& costs)
+{
   std::vector<Vertex> vertices = graph.getVertices().collect();
   const uint n = vertices.size();
 
@@ -26,28 +46,149 @@ SampleCollector::SampleCollector(const Graph& graph,
             << " into " << numBuckets
             << " individual buckets";
 
-  shuffle(vertices.begin(), vertices.end());
+  shuffle(vertices.begin(), vertices.end(), seed);
 
   assert(sampleSize <= n);
   assert(numBuckets <= n);
 
-  auto it = vertices.begin();
+  std::vector<idx> ranks;
+
+  for(uint j = 0; j < numBuckets; ++j)
+  {
+    ranks.push_back(std::ceil(j * n / ((float)numBuckets)));
+  }
+
+  // No vertices beyond the largest rank are required
+  const int size = ranks.back() + 1;
+
+  tbb::parallel_for((uint) 0, sampleSize,
+                    [&](uint i)
+                    {
+                      const Vertex& source = vertices[i];
+
+                      std::vector<Vertex> nearest = nearestVertices(graph,
+                                                                    source,
+                                                                    costs,
+                                                                    size);
+
+                      assert(nearest.size() == (size_t) size);
+
+                      for(uint j = 0; j < numBuckets; ++j)
+                      {
+                        const Vertex& target = nearest.at(ranks[j]);
+                        samples[j][i] = VertexPair(source, target);
+                      }
+                    });
+}
+
+SampleCollector SampleCollector::cached(const std::string& filename,
+                                        const Graph& graph,
+                                        const EdgeFunc<num>& costs,
+                                        uint sampleSize,
+                                        uint numBuckets,
+                                        int seed)
+{
+  SampleCollector sampleCollector(sampleSize, numBuckets, seed);
+
+  {
+    std::ifstream input(filename, std::ios::binary);
+
+    if(input and sampleCollector.read(graph, input))
+    {
+      Log(info) << "Read samples from " << filename;
+
+      return sampleCollector;
+    }
+  }
+
+  sampleCollector.collect(graph, costs);
+
+  std::ofstream output(filename, std::ios::binary);
+
+  if(output)
+  {
+    sampleCollector.write(graph, output);
+
+    Log(info) << "Wrote samples to " << filename;
+  }
+  else
+  {
+    Log(warning) << "Could not write samples to " << filename;
+  }
+
+  return sampleCollector;
+}
+
+bool SampleCollector::read(const Graph& graph,
+                           std::istream& in)
+{
+  Protobuf::Samples PBFSamples;
+
+  if(!PBFSamples.ParseFromIstream(&in))
+  {
+    return false;
+  }
+
+  const idx numVertices = graph.getVertices().size();
 
-  for(uint i = 0; i < sampleSize; ++i)
+  if(PBFSamples.num_vertices() != (int) numVertices or
+     PBFSamples.num_edges() != (int) graph.getEdges().size() or
+     PBFSamples.seed() != seed or
+     PBFSamples.sample_size() != (int) sampleSize or
+     PBFSamples.num_buckets() != (int) numBuckets or
+     PBFSamples.buckets_size() != (int) numBuckets)
   {
-    const Vertex& source = *it;
+    return false;
+  }
 
-    std::vector<Vertex> nearest = nearestVertices(graph, source, costs);
+  for(uint j = 0; j < numBuckets; ++j)
+  {
+    const Protobuf::SampleBucket& PBFBucket = PBFSamples.buckets(j);
 
-    assert(nearest.size() == n);
+    if(PBFBucket.sources_size() != (int) sampleSize or
+       PBFBucket.targets_size() != (int) sampleSize)
+    {
+      return false;
+    }
 
-    for(uint j = 0; j < numBuckets; ++j)
+    for(uint i = 0; i < sampleSize; ++i)
     {
-      const Vertex& target = nearest.at(std::ceil(j * n / ((float)numBuckets)));
-      samples[j].push_back(VertexPair(source, target));
+      const idx source = PBFBucket.sources(i);
+      const idx target = PBFBucket.targets(i);
+
+      if(source >= numVertices or target >= numVertices)
+      {
+        return false;
+      }
+
+      samples[j][i] = VertexPair(Vertex(source), Vertex(target));
     }
+  }
+
+  return true;
+}
+
+void SampleCollector::write(const Graph& graph,
+                            std::ostream& out) const
+{
+  Protobuf::Samples PBFSamples;
+
+  PBFSamples.set_num_vertices(graph.getVertices().size());
+  PBFSamples.set_num_edges(graph.getEdges().size());
+  PBFSamples.set_seed(seed);
+  PBFSamples.set_sample_size(sampleSize);
+  PBFSamples.set_num_buckets(numBuckets);
 
-    ++it;
+  for(const std::vector<VertexPair>& bucket : samples)
+  {
+    Protobuf::SampleBucket& PBFBucket = *(PBFSamples.add_buckets());
+
+    for(const VertexPair& sample : bucket)
+    {
+      PBFBucket.add_sources(sample.source.getIndex());
+      PBFBucket.add_targets(sample.target.getIndex());
+    }
   }
 
+  PBFSamples.SerializeToOstream(&out);
 }
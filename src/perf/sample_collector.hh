@@ -1,6 +1,9 @@
 #ifndef SAMPLE_COLLECTOR_HH
 #define SAMPLE_COLLECTOR_HH
 
+#include <iostream>
+#include <string>
+
 #include "util.hh"
 
 #include "graph/graph.hh"
@@ -18,17 +21,52 @@ public:
   Vertex source, target;
 };
 
+/**
+ * Collects samples of vertex pairs bucketed by their Dijkstra rank.
+ * The sources are chosen randomly based on a seed, the targets
+ * of the buckets are spread evenly across the vertices
+ * ordered by their distance from the source.
+ **/
 class SampleCollector
 {
 private:
   std::vector<std::vector<VertexPair>> samples;
   const uint sampleSize;
   const uint numBuckets;
+  const int seed;
+
+  SampleCollector(uint sampleSize,
+                  uint numBuckets,
+                  int seed);
+
+  void collect(const Graph& graph,
+               const EdgeFunc<num>& costs);
+
+  bool read(const Graph& graph,
+            std::istream& in);
+
 public:
   SampleCollector(const Graph& graph,
                   const EdgeFunc<num>& costs,
                   uint sampleSize,
-                  uint numBuckets);
+                  uint numBuckets,
+                  int seed = 42);
+
+  /**
+   * Reads the samples from the file with the given name if it
+   * contains samples for the given Graph and parameters.
+   * Otherwise, the samples are collected and
+   * written into the file.
+   **/
+  static SampleCollector cached(const std::string& filename,
+                                const Graph& graph,
+                                const EdgeFunc<num>& costs,
+                                uint sampleSize,
+                                uint numBuckets,
+                                int seed = 42);
+
+  void write(const Graph& graph,
+             std::ostream& out) const;
 
   uint getNumBuckets() const
   {
@@ -40,6 +78,11 @@ public:
     return sampleSize;
   }
 
+  int getSeed() const
+  {
+    return seed;
+  }
+
   const std::vector<std::vector<VertexPair>>& getSamples() const
   {
     return samples;
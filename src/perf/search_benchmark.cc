@@ -0,0 +1,75 @@
+#include "search_benchmark.hh"
+
+#include <sstream>
+
+#include "benchmark.hh"
+
+void SearchBenchmark::executeAll()
+{
+  const uint numBuckets = sampleCollector.getNumBuckets();
+
+  results.clear();
+  results.reserve(numBuckets);
+
+  for(uint bucket = 0; bucket < numBuckets; ++bucket)
+  {
+    results.push_back(execute(sampleCollector.getSamples(bucket)));
+  }
+}
+
+SearchResultStats SearchBenchmark::execute(const std::vector<VertexPair>& samples)
+{
+  double averageSettled = 0;
+  double averageSeconds = 0;
+
+  for(const VertexPair& sample : samples)
+  {
+    Timer timer;
+
+    averageSettled += query(sample);
+    averageSeconds += timer.elapsed();
+  }
+
+  averageSettled /= (double (samples.size()));
+  averageSeconds /= (double (samples.size()));
+
+  return SearchResultStats{averageSettled, averageSeconds};
+}
+
+void SearchBenchmark::print(std::ostream& out, const std::string& name)
+{
+  std::stringstream stream;
+  stream << "Name";
+
+  for(uint bucket = 0; bucket < sampleCollector.getNumBuckets(); ++bucket)
+  {
+    stream << ", ";
+    stream << bucket;
+  }
+
+  out << stream.str() << "\n";
+
+  stream.str("");
+
+  stream << name << "Settled";
+
+  for(uint bucket = 0; bucket < sampleCollector.getNumBuckets(); ++bucket)
+  {
+    stream << ", ";
+    stream << results.at(bucket).averageSettled;
+  }
+
+  out << stream.str() << "\n";
+
+  stream.str("");
+
+  stream << name << "Time";
+
+  for(uint bucket = 0; bucket < sampleCollector.getNumBuckets(); ++bucket)
+  {
+    stream << ", ";
+    stream << results.at(bucket).averageSeconds;
+  }
+
+  out << stream.str() << "\n";
+}
@@ -0,0 +1,48 @@
+#ifndef SEARCH_BENCHMARK_HH
+#define SEARCH_BENCHMARK_HH
+
+#include <functional>
+#include <iostream>
+
+#include "util.hh"
+
+#include "sample_collector.hh"
+
+struct SearchResultStats
+{
+  double averageSettled;
+  double averageSeconds;
+};
+
+/**
+ * A benchmark measuring the average number of settled vertices
+ * and the average latency of queries given by the samples of
+ * a SampleCollector. The query returns the number of vertices
+ * it has settled.
+ **/
+class SearchBenchmark
+{
+public:
+  typedef std::function<idx(const VertexPair&)> Query;
+
+private:
+  const SampleCollector& sampleCollector;
+  Query query;
+
+  std::vector<SearchResultStats> results;
+
+  SearchResultStats execute(const std::vector<VertexPair>& samples);
+
+public:
+  SearchBenchmark(const SampleCollector& sampleCollector,
+                  Query query)
+    : sampleCollector(sampleCollector),
+      query(query)
+  {}
+
+  void executeAll();
+
+  void print(std::ostream& out, const std::string& name);
+};
+
+#endif /* SEARCH_BENCHMARK_HH */
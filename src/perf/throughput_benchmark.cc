@@ -0,0 +1,128 @@
+#include "throughput_benchmark.hh"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "log.hh"
+
+ThroughputBenchmark::ThroughputBenchmark(const SampleCollector& sampleCollector,
+                                         const SampleQueryFactory& factory,
+                                         int numThreads,
+                                         double minSeconds)
+  : sampleCollector(sampleCollector),
+    minSeconds(minSeconds)
+{
+  assert(numThreads > 0);
+
+  for(int i = 0; i < numThreads; ++i)
+  {
+    queries.push_back(factory());
+  }
+}
+
+void ThroughputBenchmark::executeAll()
+{
+  const uint numBuckets = sampleCollector.getNumBuckets();
+
+  results.clear();
+  results.reserve(numBuckets);
+
+  for(uint bucket = 0; bucket < numBuckets; ++bucket)
+  {
+    results.push_back(execute(sampleCollector.getSamples(bucket)));
+  }
+}
+
+ThroughputResult ThroughputBenchmark::execute(const std::vector<VertexPair>& samples)
+{
+  const int numThreads = queries.size();
+  const idx numSamples = samples.size();
+
+  if(numSamples == 0)
+  {
+    throw std::invalid_argument("Cannot measure the throughput of an empty sample set");
+  }
+
+  std::atomic<idx> next(0);
+  std::vector<LatencyHistogram> latencies(numThreads);
+  std::vector<std::thread> threads;
+
+  Timer totalTimer;
+
+  for(int i = 0; i < numThreads; ++i)
+  {
+    threads.push_back(std::thread([&, i]() {
+          Timer threadTimer;
+
+          while(true)
+          {
+            const idx current = next++;
+
+            // Execute each sample at least once, then
+            // continue until the time limit has been reached
+            if(current >= numSamples and threadTimer.elapsed() >= minSeconds)
+            {
+              break;
+            }
+
+            Timer timer;
+
+            queries[i](samples[current % numSamples]);
+
+            latencies[i].add(timer.elapsed());
+          }
+        }));
+  }
+
+  for(std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  const double totalSeconds = totalTimer.elapsed();
+
+  ThroughputResult result{numThreads, 0, totalSeconds, LatencyHistogram()};
+
+  for(const LatencyHistogram& histogram : latencies)
+  {
+    result.latencies.add(histogram);
+  }
+
+  result.totalQueries = result.latencies.size();
+
+  Log(info) << "Executed " << result.totalQueries
+            << " queries on " << numThreads
+            << " threads in " << totalSeconds
+            << " seconds, " << result.queriesPerSecond()
+            << " queries per second";
+
+  return result;
+}
+
+void ThroughputBenchmark::printJSON(std::ostream& out) const
+{
+  out << "\"throughput\": [";
+
+  for(idx i = 0; i < results.size(); ++i)
+  {
+    const ThroughputResult& result = results[i];
+
+    out << "{\"threads\": " << result.numThreads
+        << ", \"queries\": " << result.totalQueries
+        << ", \"seconds\": " << result.totalSeconds
+        << ", \"queriesPerSecond\": " << result.queriesPerSecond()
+        << ", \"latencies\": ";
+
+    result.latencies.printJSON(out);
+
+    out << "}";
+
+    if(i < results.size() - 1)
+    {
+      out << ", ";
+    }
+  }
+
+  out << "]";
+}
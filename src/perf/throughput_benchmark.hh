@@ -0,0 +1,65 @@
+#ifndef THROUGHPUT_BENCHMARK_HH
+#define THROUGHPUT_BENCHMARK_HH
+
+#include <functional>
+#include <iostream>
+
+#include "benchmark.hh"
+#include "sample_collector.hh"
+
+typedef std::function<void(const VertexPair&)> SampleQuery;
+
+/**
+ * A factory creating independent queries. Since most routers
+ * are stateful, each thread requires a query of its own.
+ **/
+typedef std::function<SampleQuery()> SampleQueryFactory;
+
+struct ThroughputResult
+{
+  int numThreads;
+  int totalQueries;
+  double totalSeconds;
+  LatencyHistogram latencies;
+
+  double queriesPerSecond() const
+  {
+    return totalQueries / totalSeconds;
+  }
+};
+
+/**
+ * A benchmark measuring the sustained throughput of
+ * a number of threads concurrently executing the
+ * queries of the individual buckets of a SampleCollector.
+ **/
+class ThroughputBenchmark
+{
+private:
+  const SampleCollector& sampleCollector;
+  std::vector<SampleQuery> queries;
+  double minSeconds;
+
+  std::vector<ThroughputResult> results;
+
+  /**
+   * @throws std::invalid_argument if there are no samples
+   **/
+  ThroughputResult execute(const std::vector<VertexPair>& samples);
+
+public:
+  ThroughputBenchmark(const SampleCollector& sampleCollector,
+                      const SampleQueryFactory& factory,
+                      int numThreads,
+                      double minSeconds);
+
+  void executeAll();
+
+  /**
+   * Prints the per-bucket results as the member
+   * of a JSON object.
+   **/
+  void printJSON(std::ostream& out) const;
+};
+
+#endif /* THROUGHPUT_BENCHMARK_HH */
@@ -0,0 +1,141 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "allocation.hh"
+
+#include "graph/graph.hh"
+#include "graph/edge_map.hh"
+
+class AllocationTest : public testing::Test
+{
+protected:
+  HugePages hugePages;
+
+public:
+  AllocationTest()
+    : hugePages(getHugePages())
+  {}
+
+  ~AllocationTest()
+  {
+    setHugePages(hugePages);
+  }
+};
+
+TEST_F(AllocationTest, testLargeAllocator)
+{
+  const idx size = largeAllocationSize / sizeof(idx) + 1;
+
+  for(HugePages value : {HugePages::NONE,
+                         HugePages::TRANSPARENT,
+                         HugePages::EXPLICIT})
+  {
+    setHugePages(value);
+
+    // the explicit policy falls back to regular pages if
+    // no huge pages are reserved
+    std::vector<idx, LargeAllocator<idx>> small(16, 1), large(size, 1);
+
+    large.back() = 2;
+
+    ASSERT_EQ(16, small.size());
+    ASSERT_EQ(size, large.size());
+    ASSERT_EQ(1, large.front());
+    ASSERT_EQ(2, large.back());
+  }
+}
+
+TEST_F(AllocationTest, testArena)
+{
+  Arena arena(1024);
+
+  char* first = static_cast<char*>(arena.allocate(3, 1));
+  char* second = static_cast<char*>(arena.allocate(8, 8));
+
+  ASSERT_EQ(first + 8, second);
+  ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(second) % 8);
+  ASSERT_EQ(11, arena.getUsed());
+  ASSERT_EQ(1024, arena.getReserved());
+
+  // exceeds the block size and gets a block of its own
+  arena.allocate(512, 8);
+
+  ASSERT_EQ(1024 + 512, arena.getReserved());
+
+  arena.allocate(1000, 8);
+
+  ASSERT_EQ(1024 + 512 + 1000, arena.getReserved());
+}
+
+TEST_F(AllocationTest, testArenaAllocator)
+{
+  std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+
+  const ArenaAllocator<int> allocator(arena);
+
+  std::vector<int, ArenaAllocator<int>> values(allocator);
+
+  values.reserve(4);
+  values.push_back(1);
+
+  ASSERT_EQ(4 * sizeof(int), arena->getUsed());
+
+  std::vector<int, ArenaAllocator<int>> copy(values);
+
+  ASSERT_EQ(arena, copy.get_allocator().getArena());
+  ASSERT_EQ(values, copy);
+
+  std::vector<int, ArenaAllocator<int>> heapValues(4, 1);
+
+  ASSERT_EQ(nullptr, heapValues.get_allocator().getArena());
+}
+
+TEST_F(AllocationTest, testGraph)
+{
+  Graph graph(3, {});
+
+  std::vector<Vertex> vertices = graph.getVertices().collect();
+
+  graph.addEdge(vertices[0], vertices[1]);
+  graph.addEdge(vertices[1], vertices[2]);
+  graph.addEdge(vertices[0], vertices[2]);
+
+  Graph copy(graph);
+
+  graph.addEdge(vertices[2], vertices[0]);
+
+  ASSERT_EQ(3, copy.getEdges().size());
+  ASSERT_EQ(2, copy.getOutgoing(vertices[0]).size());
+  ASSERT_EQ(0, copy.getOutgoing(vertices[2]).size());
+  ASSERT_EQ(1, graph.getOutgoing(vertices[2]).size());
+
+  copy = graph;
+
+  ASSERT_EQ(graph.getIncoming(vertices[0]), copy.getIncoming(vertices[0]));
+
+  EdgeMap<num> costs(copy, 1);
+
+  ASSERT_EQ(1, costs(copy.getEdges().back()));
+}
+
+TEST_F(AllocationTest, testAdjacentEdges)
+{
+  Graph graph(1, {});
+
+  const Vertex vertex = graph.getVertices().collect().front();
+
+  // the adjacency lists of the loop are allocated back to back
+  graph.addEdge(vertex, vertex);
+
+  idx numEdges = 0;
+
+  for(const Edge& edge : graph.getAdjacentEdges(vertex))
+  {
+    ASSERT_EQ(vertex, edge.getSource());
+    ++numEdges;
+  }
+
+  ASSERT_EQ(2, numEdges);
+}
@@ -1,5 +1,7 @@
 #include "arcflag_test.hh"
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include "log.hh"
@@ -8,7 +10,9 @@
 #include "router/router.hh"
 
 #include "arcflags/centralized_preprocessor.hh"
+#include "arcflags/inertial_flow_partition.hh"
 #include "arcflags/metis_partition.hh"
+#include "arcflags/multilevel_arcflag_preprocessor.hh"
 
 /*
 TEST_F(ArcFlagTest, testPartition)
@@ -51,6 +55,54 @@ public:
   }
 };
 
+TEST_F(ArcFlagTest, testBoundaryIndex)
+{
+  idx numInternal = 0;
+
+  for(const Region& region : partition.getRegions())
+  {
+    std::vector<Vertex> expected;
+
+    for(const Vertex& vertex : region.getVertices())
+    {
+      for(const Edge& edge : graph.getOutgoing(vertex))
+      {
+        if(partition.getRegion(edge.getTarget()) != region)
+        {
+          expected.push_back(vertex);
+          break;
+        }
+      }
+    }
+
+    std::sort(expected.begin(), expected.end());
+
+    const ArrayRange<Vertex> vertices =
+      partition.boundaryVertices<Direction::OUTGOING>(region);
+
+    ASSERT_EQ(std::vector<Vertex>(vertices.begin(), vertices.end()), expected);
+
+    for(const Edge& edge : partition.boundaryEdges<Direction::INCOMING>(region))
+    {
+      ASSERT_EQ(partition.getRegion(edge.getTarget()), region);
+      ASSERT_NE(partition.getRegion(edge.getSource()), region);
+    }
+
+    for(const Edge& edge : partition.internalEdges(region))
+    {
+      ASSERT_EQ(partition.getRegion(edge.getSource()), region);
+      ASSERT_EQ(partition.getRegion(edge.getTarget()), region);
+    }
+
+    numInternal += partition.internalEdges(region).size();
+  }
+
+  const idx numBoundary = partition.boundaryEdges<Direction::OUTGOING>().size();
+
+  ASSERT_EQ(numBoundary, partition.boundaryEdges<Direction::INCOMING>().size());
+  ASSERT_EQ(numInternal + numBoundary, graph.getEdges().size());
+}
+
 TEST_F(ArcFlagTest, testCentralized)
 {
   CentralizedPreprocessor centralizedPreprocessor(graph,
@@ -130,6 +182,76 @@ TEST_F(ArcFlagTest, testCentralized)
   testRouter(arcFlagRouter);
 }
 
+TEST_F(ArcFlagTest, testCopy)
+{
+  CentralizedPreprocessor preprocessor(graph,
+                                       costs,
+                                       partition);
+
+  const ArcFlags& flags = preprocessor.getIncomingFlags();
+
+  const Graph copiedGraph(graph);
+  const ArcFlags copiedFlags(copiedGraph, flags);
+
+  for(const Edge& edge : graph.getEdges())
+  {
+    for(const Region& region : partition.getRegions())
+    {
+      ASSERT_EQ(flags.hasFlag(edge, region),
+                copiedFlags.hasFlag(edge, region));
+    }
+  }
+
+  TestRouter router(copiedGraph, copiedFlags);
+
+  testRouter(router);
+}
+
+TEST_F(ArcFlagTest, testInertialFlow)
+{
+  InertialFlowPartition inertialPartition(graph, points, 5);
+
+  ASSERT_TRUE(inertialPartition.isValid());
+  ASSERT_EQ(inertialPartition.getRegions().size(), 32);
+
+  for(const Region& region : inertialPartition.getRegions())
+  {
+    ASSERT_FALSE(region.getVertices().empty());
+  }
+
+  ASSERT_LT(inertialPartition.boundaryVertices<Direction::OUTGOING>().size(),
+            partition.boundaryVertices<Direction::OUTGOING>().size());
+
+  ArcFlagPreprocessor inertialPreprocessor(graph, costs, inertialPartition);
+
+  auto router = inertialPreprocessor.getRouter();
+
+  testRouter(router);
+}
+
+TEST_F(ArcFlagTest, testMultiLevel)
+{
+  PartitionHierarchy hierarchy(graph);
+
+  hierarchy.addLevel(GeometricPartion(graph, points, 2));
+  hierarchy.addLevel(GeometricPartion(graph, points, 5));
+
+  ASSERT_EQ(hierarchy.getNumLevels(), 2);
+  ASSERT_EQ(hierarchy.getWidth(0), 4);
+  ASSERT_EQ(hierarchy.getWidth(1), 8);
+
+  ASSERT_THROW(hierarchy.addLevel(GeometricPartion(graph, points, 1)),
+               std::invalid_argument);
+
+  MultiLevelArcFlagPreprocessor preprocessor(graph, costs, hierarchy);
+
+  ASSERT_EQ(preprocessor.getIncomingFlags().getBitsPerEdge(), 12);
+
+  auto router = preprocessor.getRouter();
+
+  testRouter(router);
+}
+
 /*
 TEST_F(ArcFlagTest, testRouter)
 {
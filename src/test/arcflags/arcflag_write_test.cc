@@ -2,7 +2,9 @@
 
 #include <sstream>
 
+#include "reader/arcflag_parser.hh"
 #include "reader/bidirected_arcflag_reader.hh"
+#include "writer/arcflag_composer.hh"
 #include "writer/bidirected_arcflag_writer.hh"
 
 void testArcFlagEquality(const ArcFlags& first, const ArcFlags& second)
@@ -42,3 +44,73 @@ TEST_F(ArcFlagTest, testWriteFlags)
   testArcFlagEquality(preprocessor.getIncomingFlags(), *result.incomingFlags);
   testArcFlagEquality(preprocessor.getOutgoingFlags(), *result.outgoingFlags);
 }
+
+TEST_F(ArcFlagTest, testWriteUnalignedFlags)
+{
+  // a number of regions which is not a multiple of the word size
+  const idx numRegions = 70;
+  const std::vector<Vertex> vertices = graph.getVertices().collect();
+
+  Partition unalignedPartition(graph);
+
+  for(idx i = 0; i < numRegions; ++i)
+  {
+    unalignedPartition.addRegion(std::vector<Vertex>(vertices.begin() + (i * vertices.size()) / numRegions,
+                                                     vertices.begin() + ((i + 1) * vertices.size()) / numRegions));
+  }
+
+  ASSERT_TRUE(unalignedPartition.isValid());
+
+  ArcFlagPreprocessor unalignedPreprocessor(graph, costs, unalignedPartition);
+
+  const ArcFlags& flags = unalignedPreprocessor.getIncomingFlags();
+
+  ASSERT_EQ(2, flags.getNumWords());
+
+  std::stringstream buf;
+
+  BidirectedArcFlagWriter().writeBidirectedArcFlags(buf,
+                                                    flags,
+                                                    unalignedPreprocessor.getOutgoingFlags());
+
+  auto result = BidirectedArcFlagReader().readBidirectedArcFlags(graph, buf);
+
+  testArcFlagEquality(flags, *result.incomingFlags);
+  testArcFlagEquality(unalignedPreprocessor.getOutgoingFlags(), *result.outgoingFlags);
+
+  Protobuf::ArcFlags PBFArcFlags;
+  ArcFlagComposer().composeArcFlags(flags, PBFArcFlags);
+
+  ASSERT_THROW(ArcFlagParser().parseArcFlags(graph, partition, PBFArcFlags),
+               std::runtime_error);
+}
+
+TEST_F(ArcFlagTest, testReadLegacyFlags)
+{
+  const ArcFlags& flags = preprocessor.getIncomingFlags();
+  const idx numBatches = partition.getRegions().size() / 32;
+
+  Protobuf::ArcFlags PBFArcFlags;
+
+  for(const Edge& edge : graph.getEdges())
+  {
+    for(idx batch = 0; batch < numBatches; ++batch)
+    {
+      google::protobuf::uint32 batchFlags = 0;
+
+      for(idx i = 0; i < 32; ++i)
+      {
+        if(flags.hasFlag(edge, partition.getRegions()[batch * 32 + i]))
+        {
+          batchFlags |= (1u << i);
+        }
+      }
+
+      PBFArcFlags.add_flags(batchFlags);
+    }
+  }
+
+  auto result = ArcFlagParser().parseArcFlags(graph, partition, PBFArcFlags);
+
+  testArcFlagEquality(flags, *result);
+}
@@ -1,12 +1,20 @@
 #include <gtest/gtest.h>
 
+#include <sstream>
+
 #include "graph/graph.hh"
+#include "graph/edge_map.hh"
 #include "router/router.hh"
 
+#include "contraction/contraction_graph.hh"
 #include "contraction/contraction_hierarchy.hh"
 #include "contraction/contraction_preprocessor.hh"
 #include "contraction/parallel_contraction_preprocessor.hh"
 #include "contraction/nested_dissection_order.hh"
+#include "contraction/witness_search.hh"
+
+#include "reader/hierarchy_reader.hh"
+#include "writer/hierarchy_writer.hh"
 
 #include "basic_test.hh"
 
@@ -24,6 +32,17 @@ TEST_F(ContractionTest, testContraction)
   testRouter(router);
 }
 
+TEST_F(ContractionTest, testContractionWithoutStalling)
+{
+  ContractionPreprocessor preprocessor(graph, costs);
+  ContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  auto router = hierarchy.getRouter();
+  router.setStalling(false);
+
+  testRouter(router);
+}
+
 TEST_F(ContractionTest, testParallelContraction)
 {
   ParallelContractionPreprocessor preprocessor(graph, costs);
@@ -33,3 +52,239 @@ TEST_F(ContractionTest, testParallelContraction)
 
   testRouter(router);
 }
+
+TEST_F(ContractionTest, testMemoryUsage)
+{
+  ParallelContractionPreprocessor preprocessor(graph, costs);
+  ContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  const MemoryUsage usage = hierarchy.memoryUsage();
+
+  const QueryGraph& upwardGraph = hierarchy.getUpwardGraph();
+
+  // the graph, the ranks, both query graphs and the shortcuts
+  ASSERT_EQ(5, usage.getComponents().size());
+  ASSERT_EQ(heapUsage(hierarchy.getRanks()), usage.getComponents()[1].getTotal());
+  ASSERT_EQ(heapUsage(upwardGraph.getOffsets()) +
+            heapUsage(upwardGraph.getHeads()) +
+            heapUsage(upwardGraph.getWeights()) +
+            heapUsage(upwardGraph.getShortcuts()),
+            usage.getComponents()[2].getTotal());
+
+  std::stringstream buf;
+  usage.printJSON(buf);
+
+  ASSERT_EQ(buf.str().front(), '{');
+}
+
+TEST_F(ContractionTest, testWriteHierarchy)
+{
+  ParallelContractionPreprocessor preprocessor(graph, costs);
+  ContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  std::stringstream buf;
+
+  HierarchyWriter().writeHierarchy(buf, hierarchy);
+
+  auto result = HierarchyReader().readHierarchy(buf);
+
+  ASSERT_EQ(hierarchy.getRanks(), result->getRanks());
+  ASSERT_EQ(hierarchy.getUpwardGraph().getHeads(),
+            result->getUpwardGraph().getHeads());
+  ASSERT_EQ(hierarchy.getDownwardGraph().getWeights(),
+            result->getDownwardGraph().getWeights());
+
+  auto router = result->getRouter();
+
+  testRouter(router);
+}
+
+TEST_F(ContractionTest, testReadCorruptHierarchy)
+{
+  ParallelContractionPreprocessor preprocessor(graph, costs);
+  ContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  std::stringstream buf;
+
+  HierarchyWriter().writeHierarchy(buf, hierarchy);
+
+  const std::string content = buf.str();
+
+  std::stringstream truncated(content.substr(0, content.size() / 2));
+
+  ASSERT_THROW(HierarchyReader().readHierarchy(truncated), std::runtime_error);
+
+  typedef std::vector<idx> Indices;
+  typedef std::vector<num> Weights;
+
+  // offsets must be non-decreasing, heads must be vertices
+  ASSERT_THROW(QueryGraph(Indices{0, 2, 1}, Indices{0}, Weights{1}, Indices{0}),
+               std::runtime_error);
+
+  ASSERT_THROW(QueryGraph(Indices{0, 1, 1}, Indices{2}, Weights{1}, Indices{0}),
+               std::runtime_error);
+
+  const QueryGraph queryGraph(Indices{0, 1, 1}, Indices{1}, Weights{1}, Indices{1});
+
+  const std::vector<Edge> edges{Edge(Vertex(0), Vertex(1), 0),
+                                Edge(Vertex(0), Vertex(1), 1)};
+
+  const idx original = ShortcutTable::ORIGINAL;
+
+  // shortcuts must consist of smaller shortcuts
+  ASSERT_THROW(ShortcutTable(edges, Indices{original, 1}, Indices{original, 0}),
+               std::runtime_error);
+
+  // shortcut ids must refer to the shortcut table
+  ASSERT_THROW(ContractionHierarchy(Indices{0, 1},
+                                    queryGraph,
+                                    QueryGraph(Indices{0, 0, 0}, {}, {}, {}),
+                                    ShortcutTable(std::vector<Edge>{edges.front()},
+                                                  Indices{original},
+                                                  Indices{original})),
+               std::runtime_error);
+
+  ASSERT_THROW(ContractionHierarchy(Indices{0, 2},
+                                    QueryGraph(Indices{0, 0, 0}, {}, {}, {}),
+                                    QueryGraph(Indices{0, 0, 0}, {}, {}, {}),
+                                    ShortcutTable()),
+               std::runtime_error);
+}
+
+TEST_F(ContractionTest, testWitnessSearch)
+{
+  WitnessSearch search(graph);
+  Dijkstra router(graph);
+
+  for(Vertex source : sources)
+  {
+    search.start(source);
+
+    for(Vertex target : targets)
+    {
+      if(source == target)
+      {
+        continue;
+      }
+
+      SearchResult result = router.shortestPath(source, target, costs);
+
+      ASSERT_TRUE(result.found);
+
+      ASSERT_TRUE(search.search<Direction::OUTGOING>(target,
+                                                     result.cost,
+                                                     AllEdgeFilter(),
+                                                     costs));
+
+      ASSERT_EQ(result.cost, search.getCost(target));
+
+      Path path = search.getPath<Direction::OUTGOING>(target);
+
+      ASSERT_TRUE(path.connects(source, target));
+      ASSERT_EQ(result.cost, path.cost(costs));
+
+      if(result.cost > 0)
+      {
+        WitnessSearch restricted(graph);
+        restricted.start(source);
+
+        ASSERT_FALSE(restricted.search<Direction::OUTGOING>(target,
+                                                            result.cost - 1,
+                                                            AllEdgeFilter(),
+                                                            costs));
+      }
+    }
+  }
+}
+
+TEST_F(ContractionTest, testLimitedWitnessSearch)
+{
+  WitnessSearch search(graph, 10, 2);
+
+  for(Vertex source : sources)
+  {
+    search.start(source);
+
+    for(Vertex target : targets)
+    {
+      if(source == target)
+      {
+        continue;
+      }
+
+      if(search.search<Direction::OUTGOING>(target,
+                                            inf,
+                                            AllEdgeFilter(),
+                                            costs))
+      {
+        Path path = search.getPath<Direction::OUTGOING>(target);
+
+        ASSERT_TRUE(path.connects(source, target));
+        ASSERT_LE(path.getEdges().size(), 2u);
+      }
+
+      ASSERT_LE(search.getSettled(), 10u);
+    }
+  }
+}
+
+TEST_F(ContractionTest, testContractionGraph)
+{
+  Graph overlayGraph(graph);
+  ContractionGraph core(overlayGraph, 0.f);
+
+  ASSERT_EQ(core.getNumEdges(), overlayGraph.getEdges().size());
+
+  for(const Vertex& vertex : overlayGraph.getVertices())
+  {
+    ASSERT_EQ(core.getOutgoing(vertex).size(),
+              overlayGraph.getOutgoing(vertex).size());
+    ASSERT_EQ(core.getIncoming(vertex).size(),
+              overlayGraph.getIncoming(vertex).size());
+  }
+
+  const std::vector<Vertex> vertices = overlayGraph.getVertices().collect();
+  const Vertex removed = vertices[0];
+  const Vertex other = vertices[1];
+
+  core.removeVertex(removed);
+
+  ASSERT_FALSE(core.contains(removed));
+
+  for(const Vertex& vertex : overlayGraph.getVertices())
+  {
+    if(!core.contains(vertex))
+    {
+      continue;
+    }
+
+    for(const Edge& edge : core.getOutgoing(vertex))
+    {
+      ASSERT_EQ(edge.getSource(), vertex);
+      ASSERT_NE(edge.getTarget(), removed);
+    }
+
+    for(const Edge& edge : core.getIncoming(vertex))
+    {
+      ASSERT_EQ(edge.getTarget(), vertex);
+      ASSERT_NE(edge.getSource(), removed);
+    }
+  }
+
+  // exceed the (zero) slack of the adjacency lists
+  const idx numEdges = core.getNumEdges();
+  const idx degree = core.getOutgoing(other).size();
+
+  for(idx i = 0; i < 10; ++i)
+  {
+    core.addEdge(overlayGraph.addEdge(other, vertices[2 + i]));
+  }
+
+  ASSERT_EQ(core.getNumEdges(), numEdges + 10);
+  ASSERT_EQ(core.getOutgoing(other).size(), degree + 10);
+
+  for(const Edge& edge : core.getOutgoing(other))
+  {
+    ASSERT_EQ(edge.getSource(), other);
+  }
+}
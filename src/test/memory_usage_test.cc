@@ -0,0 +1,43 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "allocation.hh"
+#include "memory_usage.hh"
+
+#include "graph/graph.hh"
+#include "graph/edge_map.hh"
+
+TEST(MemoryUsageTest, testVectors)
+{
+  std::vector<num> values;
+  values.reserve(10);
+
+  ASSERT_EQ(10 * sizeof(num), heapUsage(values));
+
+  std::vector<std::vector<idx>> nested(2);
+  nested.front().reserve(3);
+
+  ASSERT_EQ(2 * sizeof(std::vector<idx>) + 3 * sizeof(idx), heapUsage(nested));
+}
+
+TEST(MemoryUsageTest, testGraph)
+{
+  const Graph graph(3, {Edge(Vertex(0), Vertex(1), 0),
+                        Edge(Vertex(1), Vertex(2), 1)});
+
+  // two edges in the edge list, the outgoing and incoming lists
+  // of the three vertices share a single block of the arena
+  const MemoryUsage usage = graph.memoryUsage();
+
+  ASSERT_EQ(4, usage.getComponents().size());
+  ASSERT_EQ(2 * sizeof(Edge), usage.getComponents()[0].getTotal());
+  ASSERT_EQ(3 * sizeof(EdgeList), usage.getComponents()[1].getTotal());
+  ASSERT_EQ(largeAllocationSize, usage.getComponents()[3].getTotal());
+  ASSERT_EQ(2 * sizeof(Edge) + 6 * sizeof(EdgeList) + largeAllocationSize,
+            usage.getTotal());
+
+  EdgeMap<num> costs(graph, 1);
+
+  ASSERT_EQ(2 * sizeof(num), costs.memoryUsage().getTotal());
+}
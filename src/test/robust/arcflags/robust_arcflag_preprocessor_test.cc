@@ -76,6 +76,33 @@ TEST_F(RobustArcFlagPreprocessorTest, testAllValues)
   testRouter(arcFlagRouter, values);
 }
 
+TEST_F(RobustArcFlagPreprocessorTest, testIncrementalValues)
+{
+  ValueVector values = thetaValues(graph, deviations);
+
+  RobustArcFlagPreprocessor preprocessor(graph,
+                                         costs,
+                                         deviations,
+                                         partition);
+
+  preprocessor.setIncremental(true);
+
+  for(bool parallel : {false, true})
+  {
+    Bidirected<SimpleArcFlags> flags(graph, partition);
+
+    preprocessor.computeFlags(flags, parallel);
+
+    ArcFlagThetaRouter<SimpleArcFlags> arcFlagRouter(graph,
+                                                     costs,
+                                                     deviations,
+                                                     partition,
+                                                     flags);
+
+    testRouter(arcFlagRouter, values);
+  }
+}
+
 TEST_F(RobustArcFlagPreprocessorTest, testSelectedValues)
 {
   ValueVector values = {25, 15};
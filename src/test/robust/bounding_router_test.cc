@@ -11,3 +11,21 @@ ADD_ROBUST_ROUTER_TEST(bounding_router_test,
                                           thetaRouter,
                                           true))
 
+TEST_F(RobustRouterTest, testApproximateBoundingRouter)
+{
+  SimpleThetaRouter thetaRouter(graph,
+                                costs,
+                                deviations,
+                                deviationSize);
+
+  SimpleRobustRouter router(graph,
+                            costs,
+                            deviations,
+                            deviationSize,
+                            thetaRouter,
+                            true);
+
+  router.setEpsilon(0.1f);
+
+  testApproximateRouter(router, 0.1f);
+}
@@ -0,0 +1,93 @@
+#include "robust_router_test.hh"
+
+#include "graph/edge_map.hh"
+
+#include "robust/simple_robust_router.hh"
+#include "robust/theta_sweep_router.hh"
+
+#include "robust/contraction/robust_contraction_matrix_router.hh"
+#include "robust/contraction/robust_contraction_preprocessor.hh"
+
+#include "robust/theta/simple_theta_router.hh"
+
+TEST_F(RobustRouterTest, testSimpleCostMatrix)
+{
+  SimpleThetaRouter thetaRouter(graph,
+                                costs,
+                                deviations,
+                                deviationSize);
+
+  SimpleRobustRouter router(graph,
+                            costs,
+                            deviations,
+                            deviationSize,
+                            thetaRouter);
+
+  testCostMatrix(router);
+}
+
+TEST_F(RobustRouterTest, testThetaSweepCostMatrix)
+{
+  ThetaSweepRouter router(graph, costs, deviations, deviationSize);
+
+  testCostMatrix(router);
+}
+
+TEST_F(RobustRouterTest, testContractionCostMatrix)
+{
+  RobustContractionPreprocessor preprocessor(graph,
+                                             costs,
+                                             deviations);
+
+  RobustContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  RobustContractionMatrixRouter router(graph,
+                                       costs,
+                                       deviations,
+                                       deviationSize,
+                                       hierarchy);
+
+  testCostMatrix(router);
+}
+
+TEST_F(RobustRouterTest, testContractionCostMatrixUnreachable)
+{
+  Graph smallGraph(4, {});
+
+  std::vector<Vertex> vertices = smallGraph.getVertices().collect();
+
+  smallGraph.addEdge(vertices[0], vertices[1]);
+  smallGraph.addEdge(vertices[1], vertices[2]);
+
+  EdgeMap<num> smallCosts(smallGraph, 1);
+  EdgeMap<num> smallDeviations(smallGraph, 0);
+
+  smallDeviations(smallGraph.getEdges()[0]) = 5;
+  smallDeviations(smallGraph.getEdges()[1]) = 3;
+
+  const EdgeValueMap<num> costValues(smallCosts), deviationValues(smallDeviations);
+
+  RobustContractionPreprocessor preprocessor(smallGraph,
+                                             costValues,
+                                             deviationValues);
+
+  RobustContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  RobustContractionMatrixRouter router(smallGraph,
+                                       costValues,
+                                       deviationValues,
+                                       1,
+                                       hierarchy);
+
+  RobustCostMatrix matrix = router.shortestPaths({vertices[0]},
+                                                 {vertices[2], vertices[3]});
+
+  ASSERT_TRUE(matrix.get(0, 0).found);
+  ASSERT_FALSE(matrix.get(0, 1).found);
+
+  // the search ends as soon as the only target turns out to be unreachable
+  matrix = router.shortestPaths({vertices[0]}, {vertices[3]});
+
+  ASSERT_FALSE(matrix.get(0, 0).found);
+  ASSERT_EQ(1, router.getSearches());
+}
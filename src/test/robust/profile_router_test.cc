@@ -0,0 +1,76 @@
+#include "robust_router_test.hh"
+
+#include "robust/reduced_costs.hh"
+
+#include "robust/contraction/robust_contraction_preprocessor.hh"
+#include "robust/contraction/robust_profile_router.hh"
+
+#include "router/bidirectional_router.hh"
+
+class ProfileRouterTest : public RobustRouterTest
+{
+protected:
+  RobustContractionPreprocessor preprocessor;
+  RobustContractionHierarchy hierarchy;
+
+public:
+  ProfileRouterTest()
+    : preprocessor(graph, costs, deviations),
+      hierarchy(preprocessor.computeHierarchy())
+  {}
+};
+
+TEST_F(ProfileRouterTest, testProfileRouter)
+{
+  RobustProfileRouter router(graph,
+                             costs,
+                             deviations,
+                             deviationSize,
+                             hierarchy);
+
+  testRobustRouter(router);
+}
+
+TEST_F(ProfileRouterTest, testProfile)
+{
+  RobustProfileRouter router(graph,
+                             costs,
+                             deviations,
+                             deviationSize,
+                             hierarchy);
+
+  BidirectionalDijkstra dijkstra(graph);
+  const ValueVector possibleValues = thetaValues(graph, deviations);
+
+  for(idx i = 0; i < 5; ++i)
+  {
+    const Vertex source = sources[i];
+    const Vertex target = targets[i];
+
+    RobustProfile profile = router.profile(source, target, possibleValues);
+
+    ASSERT_EQ(profile.distances.size(), possibleValues.size());
+
+    for(idx j = 0; j < possibleValues.size(); ++j)
+    {
+      ReducedCosts reducedCosts(costs, deviations, possibleValues[j]);
+
+      SearchResult result = dijkstra.shortestPath(source,
+                                                  target,
+                                                  reducedCosts);
+
+      ASSERT_EQ(result.found ? result.cost : inf, profile.distances[j]);
+    }
+
+    const idx index = profile.optimalIndex(deviationSize);
+
+    if(index == possibleValues.size())
+    {
+      ASSERT_EQ(values(source)(target), inf);
+      continue;
+    }
+
+    ASSERT_EQ(values(source)(target),
+              deviationSize * possibleValues[index] + profile.distances[index]);
+  }
+}
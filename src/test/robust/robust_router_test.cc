@@ -4,6 +4,7 @@
 
 #include "log.hh"
 
+#include "robust/reduced_costs.hh"
 #include "robust/robust_costs.hh"
 #include "robust/simple_robust_router.hh"
 #include "robust/searching_robust_router.hh"
@@ -80,3 +81,61 @@ void RobustRouterTest::testRobustRouter(RobustRouter& router) const
             << queries << " queries: "
             << calls;
 }
+
+void RobustRouterTest::testApproximateRouter(RobustRouter& router,
+                                             float epsilon) const
+{
+  RobustCosts robustCosts(costs, deviations, deviationSize);
+
+  for(Vertex source : sources)
+  {
+    for(Vertex target : targets)
+    {
+      RobustSearchResult result = router.shortestPath(source, target);
+      const num optimalCost = values(source)(target);
+
+      if(!result.found)
+      {
+        ASSERT_EQ(optimalCost, inf);
+        continue;
+      }
+
+      ASSERT_TRUE(result.path.connects(source, target));
+
+      const num cost = robustCosts.get(result.path);
+
+      ASSERT_GE(cost, optimalCost);
+      ASSERT_LE(cost - result.gap, optimalCost);
+      ASSERT_LE(cost, (1 + epsilon) * optimalCost);
+    }
+  }
+}
+
+void RobustRouterTest::testCostMatrix(RobustRouter& router) const
+{
+  RobustCostMatrix matrix = router.shortestPaths(sources, targets);
+  RobustCosts robustCosts(costs, deviations, deviationSize);
+
+  for(idx i = 0; i < sources.size(); ++i)
+  {
+    for(idx j = 0; j < targets.size(); ++j)
+    {
+      const Vertex source = sources[i];
+      const Vertex target = targets[j];
+      const RobustTargetResult& result = matrix.get(i, j);
+
+      if(!result.found)
+      {
+        ASSERT_EQ(values(source)(target), inf);
+        continue;
+      }
+
+      ASSERT_EQ(values(source)(target), result.cost);
+      ASSERT_TRUE(result.path.connects(source, target));
+      ASSERT_EQ(result.cost, robustCosts.get(result.path));
+      ASSERT_EQ(result.cost,
+                deviationSize * result.value +
+                result.path.cost(ReducedCosts(costs, deviations, result.value)));
+    }
+  }
+}
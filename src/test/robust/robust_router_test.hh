@@ -11,6 +11,10 @@ class RobustRouterTest : public BasicTest
 protected:
   void testRobustRouter(RobustRouter& router) const;
 
+  void testCostMatrix(RobustRouter& router) const;
+
+  void testApproximateRouter(RobustRouter& router, float epsilon) const;
+
   VertexMap<VertexMap<num>> values;
 
 public:
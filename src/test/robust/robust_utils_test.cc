@@ -49,3 +49,18 @@ TEST(RobustUtilsTest, IterationTest) {
     ASSERT_EQ(forward, backward);
   }
 }
+
+TEST(RobustUtilsTest, ApproximationTest) {
+  ValueVector values{100, 95, 91, 80, 50, 49, 10, 0};
+
+  ASSERT_EQ(values, approximateValues(values, 0));
+
+  ValueVector expected{100, 91, 80, 50, 49, 10, 0};
+
+  ASSERT_EQ(expected, approximateValues(values, 0.1f));
+
+  ValueVector approximated = approximateValues(values, 10);
+
+  ASSERT_EQ(values.front(), approximated.front());
+  ASSERT_EQ(values.back(), approximated.back());
+}
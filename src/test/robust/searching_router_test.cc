@@ -10,3 +10,22 @@ ADD_ROBUST_ROUTER_TEST(searching_router_test,
                                              deviationSize,
                                              thetaRouter,
                                              SearchingRobustRouter::BOUNDING))
+
+TEST_F(RobustRouterTest, testApproximateSearchingRouter)
+{
+  SimpleThetaRouter thetaRouter(graph,
+                                costs,
+                                deviations,
+                                deviationSize);
+
+  SearchingRobustRouter router(graph,
+                               costs,
+                               deviations,
+                               deviationSize,
+                               thetaRouter,
+                               SearchingRobustRouter::BOUNDING);
+
+  router.setEpsilon(0.1f);
+
+  testApproximateRouter(router, 0.1f);
+}
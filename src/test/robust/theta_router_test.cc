@@ -2,9 +2,11 @@
 
 #include <vector>
 #include <random>
+#include <sstream>
 
 #include "graph/graph.hh"
 #include "graph/edge_map.hh"
+#include "graph/sparse_vertex_map.hh"
 #include "graph/vertex_map.hh"
 
 #include "arcflags/metis_partition.hh"
@@ -18,10 +20,16 @@
 #include "robust/arcflags/robust_arcflag_preprocessor.hh"
 #include "robust/arcflags/arcflag_theta_router.hh"
 
+#include "contraction/contraction_preprocessor.hh"
+
 #include "robust/contraction/parallel_robust_contraction_preprocessor.hh"
 #include "robust/contraction/robust_contraction_hierarchy.hh"
 #include "robust/contraction/robust_contraction_preprocessor.hh"
 
+#include "reader/hierarchy_reader.hh"
+#include "writer/hierarchy_writer.hh"
+
+#include "robust/reduced_costs.hh"
 #include "robust/robust_costs.hh"
 #include "robust/robust_utils.hh"
 #include "robust/simple_robust_router.hh"
@@ -29,6 +37,7 @@
 #include "robust/theta/bidirectional_bounding_router.hh"
 #include "robust/theta/bidirectional_goal_directed_router.hh"
 #include "robust/theta/bounding_router.hh"
+#include "robust/theta/composed_theta_router.hh"
 #include "robust/theta/goal_directed_router.hh"
 #include "robust/theta/goal_directed_bounding_router.hh"
 #include "robust/theta/simple_theta_router.hh"
@@ -113,6 +122,33 @@ void ThetaRouterTest::testThetaRouter(ThetaRouter& thetaRouter) const
   }
 }
 
+TEST_F(ThetaRouterTest, testSparseVertexMap)
+{
+  SparseVertexMap<num> map(graph, inf);
+
+  for(Vertex source : sources)
+  {
+    map.setValue(source, 1);
+    map.setValue(source, 0);
+  }
+
+  ASSERT_EQ(map.numTouched(), sources.size());
+
+  for(Vertex source : sources)
+  {
+    ASSERT_EQ(map(source), 0);
+  }
+
+  map.reset();
+
+  ASSERT_EQ(map.numTouched(), 0);
+
+  for(const Vertex& vertex : graph.getVertices())
+  {
+    ASSERT_EQ(map(vertex), inf);
+  }
+}
+
 TEST_F(ThetaRouterTest, testGoalDirectedRouter)
 {
   GoalDirectedRouter router(graph,
@@ -123,6 +159,20 @@ TEST_F(ThetaRouterTest, testGoalDirectedRouter)
   testThetaRouter(router);
 }
 
+TEST_F(ThetaRouterTest, testContractionGoalDirectedRouter)
+{
+  ContractionPreprocessor preprocessor(graph, costs);
+  ContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  GoalDirectedRouter router(graph,
+                            costs,
+                            deviations,
+                            deviationSize,
+                            hierarchy);
+
+  testThetaRouter(router);
+}
+
 TEST_F(ThetaRouterTest, testGoalDirectedBoundingRouter)
 {
   GoalDirectedBoundingRouter router(graph,
@@ -198,6 +248,66 @@ TEST_F(ThetaRouterTest, testBidirectionalBoundingRouter)
   testThetaRouter(router);
 }
 
+TEST_F(ThetaRouterTest, testConcurrentSimpleRouter)
+{
+  SimpleThetaRouter router(graph,
+                           costs,
+                           deviations,
+                           deviationSize);
+
+  router.setConcurrent(true);
+
+  testThetaRouter(router);
+}
+
+TEST_F(ThetaRouterTest, testConcurrentResults)
+{
+  SimpleThetaRouter router(graph,
+                           costs,
+                           deviations,
+                           deviationSize);
+
+  router.setConcurrent(true);
+
+  BidirectionalDijkstra simpleRouter(graph);
+
+  const ValueVector values = thetaValues(graph, deviations);
+
+  for(idx i = 0; i < values.size(); i += values.size() / numValues + 1)
+  {
+    const num value = values[i];
+    ReducedCosts reducedCosts(costs, deviations, value);
+
+    for(Vertex source : sources)
+    {
+      for(Vertex target : targets)
+      {
+        SearchResult expected = simpleRouter.shortestPath(source,
+                                                          target,
+                                                          reducedCosts);
+
+        SearchResult result = router.shortestPath(source, target, value);
+
+        ASSERT_EQ(expected.found, result.found);
+        ASSERT_EQ(expected.cost, result.cost);
+        ASSERT_TRUE(result.path.connects(source, target));
+        ASSERT_EQ(result.cost, result.path.cost(reducedCosts));
+
+        result = router.shortestPath(source, target, value, expected.cost);
+
+        ASSERT_TRUE(result.found);
+        ASSERT_EQ(expected.cost, result.cost);
+
+        if(source != target)
+        {
+          result = router.shortestPath(source, target, value, expected.cost - 1);
+
+          ASSERT_FALSE(result.found);
+        }
+      }
+    }
+  }
+}
 
 TEST_F(ThetaRouterTest, testSimpleArcFlagRouter)
 {
@@ -259,6 +369,28 @@ TEST_F(ThetaRouterTest, testExtendedArcFlagRouter)
   testThetaRouter(router);
 }
 
+TEST_F(ThetaRouterTest, testConcurrentExtendedArcFlagRouter)
+{
+  RobustArcFlagPreprocessor preprocessor(graph,
+                                         costs,
+                                         deviations,
+                                         partition);
+
+  Bidirected<ExtendedArcFlags> flags(graph, partition);
+
+  preprocessor.computeFlags(flags, false);
+
+  ArcFlagThetaRouter<ExtendedArcFlags> router(graph,
+                                              costs,
+                                              deviations,
+                                              partition,
+                                              flags);
+
+  router.setConcurrent(true);
+
+  testThetaRouter(router);
+}
+
 TEST_F(ThetaRouterTest, testFastArcFlagRouter)
 {
   FastArcFlagPreprocessor preprocessor(graph,
@@ -299,6 +431,92 @@ TEST_F(ThetaRouterTest, testParallelFastArcFlagRouter)
   testThetaRouter(router);
 }
 
+TEST_F(ThetaRouterTest, testComposedArcFlagRouter)
+{
+  RobustArcFlagPreprocessor preprocessor(graph,
+                                         costs,
+                                         deviations,
+                                         partition);
+
+  Bidirected<SimpleArcFlags> flags(graph, partition);
+
+  preprocessor.computeFlags(flags, false);
+
+  ComposedThetaRouter<ArcFlagEdgeFilter<SimpleArcFlags>,
+                      NoPotential,
+                      NoPruning> router(graph,
+                                        costs,
+                                        deviations,
+                                        deviationSize,
+                                        ArcFlagEdgeFilter<SimpleArcFlags>(partition, flags),
+                                        NoPotential(graph),
+                                        NoPruning(graph));
+
+  testThetaRouter(router);
+}
+
+TEST_F(ThetaRouterTest, testComposedGoalDirectedArcFlagRouter)
+{
+  RobustArcFlagPreprocessor arcFlagPreprocessor(graph,
+                                                costs,
+                                                deviations,
+                                                partition);
+
+  Bidirected<ExtendedArcFlags> flags(graph, partition);
+
+  arcFlagPreprocessor.computeFlags(flags, false);
+
+  ContractionPreprocessor contractionPreprocessor(graph, costs);
+  ContractionHierarchy hierarchy(contractionPreprocessor.computeHierarchy());
+
+  ComposedThetaRouter<ArcFlagEdgeFilter<ExtendedArcFlags>,
+                      ContractionGoalPotential,
+                      UpperBoundPruning> router(graph,
+                                                costs,
+                                                deviations,
+                                                deviationSize,
+                                                ArcFlagEdgeFilter<ExtendedArcFlags>(partition, flags),
+                                                ContractionGoalPotential(graph, hierarchy),
+                                                UpperBoundPruning(graph));
+
+  testThetaRouter(router);
+}
+
+TEST_F(ThetaRouterTest, testComposedBoundingRouter)
+{
+  ComposedThetaRouter<UnfilteredEdges,
+                      NoPotential,
+                      UpperBoundPruning> router(graph,
+                                                costs,
+                                                deviations,
+                                                deviationSize);
+
+  testThetaRouter(router);
+}
+
+TEST_F(ThetaRouterTest, testBidirectionalComposedArcFlagRouter)
+{
+  RobustArcFlagPreprocessor preprocessor(graph,
+                                         costs,
+                                         deviations,
+                                         partition);
+
+  Bidirected<BoundedArcFlags> flags(graph, partition);
+
+  preprocessor.computeFlags(flags, false);
+
+  BidirectionalComposedThetaRouter<ArcFlagEdgeFilter<BoundedArcFlags>,
+                                   UpperBoundPruning> router(graph,
+                                                             costs,
+                                                             deviations,
+                                                             deviationSize,
+                                                             ArcFlagEdgeFilter<BoundedArcFlags>(partition, flags),
+                                                             UpperBoundPruning(graph),
+                                                             UpperBoundPruning(graph));
+
+  testThetaRouter(router);
+}
+
 TEST_F(ThetaRouterTest, testContractionHierarchy)
 {
   RobustContractionPreprocessor preprocessor(graph,
@@ -312,6 +530,20 @@ TEST_F(ThetaRouterTest, testContractionHierarchy)
   testThetaRouter(contractionRouter);
 }
 
+TEST_F(ThetaRouterTest, testContractionHierarchyWithoutStalling)
+{
+  RobustContractionPreprocessor preprocessor(graph,
+                                             costs,
+                                             deviations);
+
+  RobustContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  auto contractionRouter = hierarchy.getRouter();
+  contractionRouter.setStalling(false);
+
+  testThetaRouter(contractionRouter);
+}
+
 TEST_F(ThetaRouterTest, testParallelContractionHierarchy)
 {
   ParallelRobustContractionPreprocessor preprocessor(graph,
@@ -324,3 +556,26 @@ TEST_F(ThetaRouterTest, testParallelContractionHierarchy)
 
   testThetaRouter(contractionRouter);
 }
+
+TEST_F(ThetaRouterTest, testWriteContractionHierarchy)
+{
+  ParallelRobustContractionPreprocessor preprocessor(graph,
+                                                     costs,
+                                                     deviations);
+
+  RobustContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  std::stringstream buf;
+
+  HierarchyWriter().writeHierarchy(buf, hierarchy);
+
+  auto result = HierarchyReader().readRobustHierarchy(buf);
+
+  ASSERT_EQ(hierarchy.getRanks(), result->getRanks());
+  ASSERT_EQ(hierarchy.getUpwardRanges().getValues(),
+            result->getUpwardRanges().getValues());
+
+  auto contractionRouter = result->getRouter();
+
+  testThetaRouter(contractionRouter);
+}
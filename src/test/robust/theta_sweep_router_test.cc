@@ -0,0 +1,70 @@
+#include "robust_router_test.hh"
+
+#include "graph/edge_map.hh"
+
+#include "robust/robust_costs.hh"
+#include "robust/theta_sweep_router.hh"
+#include "robust/theta/simple_theta_router.hh"
+
+ADD_ROBUST_ROUTER_TEST(theta_sweep_router_test,
+                       ThetaSweepRouter(graph,
+                                        costs,
+                                        deviations,
+                                        deviationSize))
+
+TEST_F(RobustRouterTest, testThetaSweepOneToMany)
+{
+  ThetaSweepRouter router(graph, costs, deviations, deviationSize);
+  RobustCosts robustCosts(costs, deviations, deviationSize);
+
+  for(Vertex source : sources)
+  {
+    std::vector<RobustTargetResult> results = router.shortestPaths(source, targets);
+
+    ASSERT_EQ(results.size(), targets.size());
+
+    for(idx i = 0; i < targets.size(); ++i)
+    {
+      const Vertex target = targets[i];
+      const RobustTargetResult& result = results[i];
+
+      if(!result.found)
+      {
+        ASSERT_EQ(values(source)(target), inf);
+        continue;
+      }
+
+      ASSERT_EQ(values(source)(target), result.cost);
+      ASSERT_TRUE(result.path.connects(source, target));
+      ASSERT_EQ(result.cost, robustCosts.get(result.path));
+    }
+  }
+}
+
+TEST_F(RobustRouterTest, testThetaSweepUnreachableTarget)
+{
+  Graph smallGraph(4, {});
+
+  std::vector<Vertex> vertices = smallGraph.getVertices().collect();
+
+  smallGraph.addEdge(vertices[0], vertices[1]);
+  smallGraph.addEdge(vertices[1], vertices[2]);
+
+  EdgeMap<num> smallCosts(smallGraph, 1);
+  EdgeMap<num> smallDeviations(smallGraph, 0);
+
+  smallDeviations(smallGraph.getEdges()[0]) = 5;
+  smallDeviations(smallGraph.getEdges()[1]) = 3;
+
+  const EdgeValueMap<num> costValues(smallCosts), deviationValues(smallDeviations);
+
+  ThetaSweepRouter router(smallGraph, costValues, deviationValues, 1);
+
+  ASSERT_TRUE(router.shortestPath(vertices[0], vertices[2]).found);
+
+  // the sweep ends as soon as the target turns out to be unreachable
+  RobustSearchResult result = router.shortestPath(vertices[0], vertices[3]);
+
+  ASSERT_FALSE(result.found);
+  ASSERT_EQ(1, result.calls);
+}
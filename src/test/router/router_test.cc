@@ -169,3 +169,28 @@ TEST_F(RouterTest, testPredicateBound)
 
   ASSERT_EQ(9, result.path.cost(costs->getValues()));
 }
+
+TEST_F(RouterTest, testConcurrentBidirectional)
+{
+  BidirectionalRouter router(*graph);
+  router.setConcurrent(true);
+
+  SearchResult result = router.shortestPath(source,
+                                            target,
+                                            costs->getValues());
+
+  ASSERT_TRUE(result.found);
+
+  ASSERT_EQ(9, result.path.cost(costs->getValues()));
+
+  result = router.shortestPath<AllEdgeFilter,
+                               AllEdgeFilter,
+                               true>(source,
+                                     target,
+                                     costs->getValues(),
+                                     AllEdgeFilter(),
+                                     AllEdgeFilter(),
+                                     8);
+
+  ASSERT_FALSE(result.found);
+}
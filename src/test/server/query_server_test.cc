@@ -0,0 +1,415 @@
+#include "basic_test.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "arcflags/metis_partition.hh"
+
+#include "contraction/contraction_preprocessor.hh"
+
+#include "robust/arcflags/simple_arcflags.hh"
+#include "robust/arcflags/value_arcflag_preprocessor.hh"
+#include "robust/contraction/robust_contraction_preprocessor.hh"
+
+#include "robust/robust_costs.hh"
+#include "robust/simple_robust_router.hh"
+#include "robust/theta/simple_theta_router.hh"
+#include "robust/values/outer_value_preprocessor.hh"
+
+#include "server/numa_topology.hh"
+#include "server/query_channel.hh"
+#include "server/query_replicas.hh"
+#include "server/query_routers.hh"
+#include "server/query_server.hh"
+
+class QueryServerTest : public BasicTest
+{
+protected:
+  std::vector<Query> queries;
+  std::vector<num> expectedCosts;
+
+  void testAnswers(const std::vector<QueryAnswer>& answers) const;
+
+public:
+  QueryServerTest();
+};
+
+QueryServerTest::QueryServerTest()
+{
+  SimpleThetaRouter thetaRouter(graph,
+                                costs,
+                                deviations,
+                                deviationSize);
+
+  SimpleRobustRouter router(graph,
+                            costs,
+                            deviations,
+                            deviationSize,
+                            thetaRouter);
+
+  RobustCosts robustCosts(costs, deviations, deviationSize);
+
+  for(const Vertex& source : sources)
+  {
+    for(const Vertex& target : targets)
+    {
+      queries.push_back(Query(source.getIndex(), target.getIndex()));
+
+      RobustSearchResult result = router.shortestPath(source, target);
+
+      expectedCosts.push_back(result.found ? robustCosts.get(result.path) : inf);
+    }
+  }
+}
+
+void QueryServerTest::testAnswers(const std::vector<QueryAnswer>& answers) const
+{
+  ASSERT_EQ(queries.size(), answers.size());
+
+  for(idx i = 0; i < queries.size(); ++i)
+  {
+    const QueryAnswer& answer = answers[i];
+
+    ASSERT_EQ(expectedCosts[i] != inf, answer.found);
+
+    if(!answer.found)
+    {
+      continue;
+    }
+
+    ASSERT_EQ(expectedCosts[i], answer.cost);
+    ASSERT_FALSE(answer.vertices.empty());
+    ASSERT_EQ(queries[i].source, answer.vertices.front());
+    ASSERT_EQ(queries[i].target, answer.vertices.back());
+  }
+}
+
+TEST_F(QueryServerTest, testChannel)
+{
+  int pipes[2];
+
+  ASSERT_EQ(0, pipe(pipes));
+
+  QueryChannel writer(-1, pipes[1]);
+  QueryChannel reader(pipes[0], -1);
+
+  QueryAnswer answer;
+  answer.found = true;
+  answer.cost = 17;
+  answer.vertices = {3, 1, 4};
+
+  writer.writeHeader(graph.getVertices().size());
+  writer.writeQueries(std::vector<Query>{Query(1, 2), Query(3, 4)});
+  writer.writeAnswers(std::vector<QueryAnswer>{answer, QueryAnswer()});
+
+  close(pipes[1]);
+
+  ASSERT_EQ(graph.getVertices().size(), reader.readHeader());
+
+  std::vector<Query> readQueries;
+  ASSERT_TRUE(reader.readQueries(readQueries));
+  ASSERT_EQ(2, readQueries.size());
+  ASSERT_EQ(3, readQueries[1].source);
+  ASSERT_EQ(4, readQueries[1].target);
+
+  std::vector<QueryAnswer> readAnswers;
+  ASSERT_TRUE(reader.readAnswers(readAnswers));
+  ASSERT_EQ(2, readAnswers.size());
+  ASSERT_TRUE(readAnswers[0].found);
+  ASSERT_EQ(17, readAnswers[0].cost);
+  ASSERT_EQ(answer.vertices, readAnswers[0].vertices);
+  ASSERT_FALSE(readAnswers[1].found);
+
+  ASSERT_FALSE(reader.readQueries(readQueries));
+
+  close(pipes[0]);
+}
+
+TEST_F(QueryServerTest, testRouters)
+{
+  ContractionPreprocessor preprocessor(graph, costs);
+  ContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  RobustContractionPreprocessor robustPreprocessor(graph, costs, deviations);
+  RobustContractionHierarchy robustHierarchy(robustPreprocessor.computeHierarchy());
+
+  QueryData data(graph, costs, deviations, deviationSize);
+  data.hierarchy = &hierarchy;
+  data.robustHierarchy = &robustHierarchy;
+
+  METISPartition partition(graph, 4);
+  OuterValuePreprocessor valuePreprocessor(graph,
+                                           costs,
+                                           deviations,
+                                           deviationSize,
+                                           partition);
+
+  RegionPairMap<ValueVector> requiredValues;
+
+  for(const Region& sourceRegion : partition.getRegions())
+  {
+    for(const Region& targetRegion : partition.getRegions())
+    {
+      if(sourceRegion == targetRegion)
+      {
+        continue;
+      }
+
+      const ValueSet valueSet = valuePreprocessor.requiredValues(sourceRegion,
+                                                                 targetRegion);
+
+      ValueVector values(valueSet.begin(), valueSet.end());
+
+      std::sort(values.begin(), values.end(), std::greater<num>());
+
+      requiredValues.put(sourceRegion, targetRegion, values);
+    }
+  }
+
+  Bidirected<SimpleArcFlags> flags(graph, partition);
+
+  ValueArcFlagPreprocessor(graph,
+                           costs,
+                           deviations,
+                           partition).computeFlags(flags, requiredValues, false);
+
+  QueryData valueData = data;
+  valueData.flagPartition = &partition;
+  valueData.incomingFlags = &flags.get<Direction::INCOMING>();
+  valueData.outgoingFlags = &flags.get<Direction::OUTGOING>();
+  valueData.valuePartition = &partition;
+  valueData.requiredValues = &requiredValues;
+
+  for(const std::string& name : queryRouterNames())
+  {
+    for(bool searching : {false, true})
+    {
+      if(name == "bounding" and searching)
+      {
+        ASSERT_THROW(createRouterFactory(name, searching, valueData),
+                     std::invalid_argument);
+        continue;
+      }
+
+      for(const QueryData* currentData : {&data, &valueData})
+      {
+        if(!currentData->incomingFlags and name.find("arcflags") == 0)
+        {
+          ASSERT_THROW(createRouterFactory(name, searching, *currentData),
+                       std::invalid_argument);
+          continue;
+        }
+
+        QueryServer server(graph,
+                           costs,
+                           deviations,
+                           deviationSize,
+                           createRouterFactory(name, searching, *currentData),
+                           4);
+
+        testAnswers(server.answer(queries));
+      }
+    }
+  }
+
+  ASSERT_THROW(createRouterFactory("unknown", false, data),
+               std::invalid_argument);
+
+  QueryServer server(graph,
+                     costs,
+                     deviations,
+                     deviationSize,
+                     createRouterFactory("simple", false, data));
+
+  const idx numVertices = graph.getVertices().size();
+
+  std::vector<QueryAnswer> answers = server.answer({Query(0, numVertices)});
+
+  ASSERT_EQ(1, answers.size());
+  ASSERT_FALSE(answers.front().found);
+}
+
+TEST_F(QueryServerTest, testNumaTopology)
+{
+  ASSERT_EQ(std::vector<int>({0, 1, 2, 5, 7, 8}),
+            NumaTopology::parseCpuList("0-2,5, 7-8\n"));
+
+  ASSERT_THROW(NumaTopology::parseCpuList("3-1"), std::invalid_argument);
+  ASSERT_THROW(NumaTopology::parseCpuList("a"), std::invalid_argument);
+
+  typedef std::vector<std::vector<int>> Nodes;
+
+  ASSERT_THROW(NumaTopology{Nodes()}, std::invalid_argument);
+  ASSERT_THROW(NumaTopology(Nodes{{0}, {}}), std::invalid_argument);
+
+  const NumaTopology topology = NumaTopology::detect();
+
+  ASSERT_GE(topology.size(), 1);
+
+  for(idx node = 0; node < topology.size(); ++node)
+  {
+    ASSERT_FALSE(topology.getCpus(node).empty());
+
+    // pin a thread of its own to keep the affinity of the test
+    bool pinned = false;
+
+    std::thread([&]()
+                {
+                  pinned = topology.pin(node);
+                }).join();
+
+    ASSERT_TRUE(pinned);
+  }
+}
+
+TEST_F(QueryServerTest, testReplicatedServer)
+{
+  ContractionPreprocessor preprocessor(graph, costs);
+  ContractionHierarchy hierarchy(preprocessor.computeHierarchy());
+
+  QueryData data(graph, costs, deviations, deviationSize);
+  data.hierarchy = &hierarchy;
+
+  const int cpu = NumaTopology::detect().getCpus(0).front();
+
+  typedef std::vector<std::vector<int>> Nodes;
+
+  ReplicatedQueryData singleData(data, NumaTopology(Nodes{{cpu}}));
+
+  ASSERT_EQ(1, singleData.size());
+  ASSERT_EQ(&data, &singleData.get(0));
+
+  // two nodes sharing a CPU exercise the replication on any machine
+  const NumaTopology topology(Nodes{{cpu}, {cpu}});
+
+  ReplicatedQueryData replicatedData(data, topology);
+
+  ASSERT_EQ(2, replicatedData.size());
+
+  for(idx node = 0; node < replicatedData.size(); ++node)
+  {
+    const QueryData& replica = replicatedData.get(node);
+
+    ASSERT_NE(&graph, &replica.graph);
+    ASSERT_NE(&hierarchy, replica.hierarchy);
+    ASSERT_EQ(graph.getEdges().size(), replica.graph.getEdges().size());
+  }
+
+  for(const char* name : {"goal-directed", "contraction"})
+  {
+    QueryServer server(graph,
+                       costs,
+                       deviations,
+                       deviationSize,
+                       createRouterFactories(name, false, replicatedData),
+                       topology);
+
+    testAnswers(server.answer(queries));
+  }
+
+  ASSERT_THROW(QueryServer(graph,
+                           costs,
+                           deviations,
+                           deviationSize,
+                           createRouterFactories("simple", false, singleData),
+                           topology),
+               std::invalid_argument);
+}
+
+TEST_F(QueryServerTest, testSocket)
+{
+  QueryData data(graph, costs, deviations, deviationSize);
+
+  QueryServer server(graph,
+                     costs,
+                     deviations,
+                     deviationSize,
+                     createRouterFactory("goal-directed", false, data));
+
+  char directory[] = "/tmp/query_server_testXXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(directory));
+
+  const std::string path = std::string(directory) + "/socket";
+
+  std::thread serverThread([&]()
+                           {
+                             server.listen(path);
+                           });
+
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+  const int clientSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+
+  ASSERT_GE(clientSocket, 0);
+
+  bool connected = false;
+
+  for(int attempt = 0; attempt < 100 and !connected; ++attempt)
+  {
+    connected = (connect(clientSocket, (sockaddr*) &address, sizeof(address)) == 0);
+
+    if(!connected)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  ASSERT_TRUE(connected);
+
+  QueryChannel channel(clientSocket);
+
+  ASSERT_EQ(graph.getVertices().size(), channel.readHeader());
+
+  std::vector<QueryAnswer> answers;
+
+  for(int batch = 0; batch < 2; ++batch)
+  {
+    channel.writeQueries(queries);
+
+    ASSERT_TRUE(channel.readAnswers(answers));
+
+    testAnswers(answers);
+  }
+
+  // the open connection is shut down by the server
+  server.stop();
+  serverThread.join();
+
+  ASSERT_FALSE(channel.readAnswers(answers));
+
+  close(clientSocket);
+  rmdir(directory);
+}
+
+TEST_F(QueryServerTest, testStopBeforeListen)
+{
+  QueryData data(graph, costs, deviations, deviationSize);
+
+  QueryServer server(graph,
+                     costs,
+                     deviations,
+                     deviationSize,
+                     createRouterFactory("simple", false, data));
+
+  char directory[] = "/tmp/query_server_testXXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(directory));
+
+  const std::string path = std::string(directory) + "/socket";
+
+  // returns immediately instead of waiting for another stop()
+  server.stop();
+  server.listen(path);
+
+  rmdir(directory);
+}